@@ -0,0 +1,340 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EbsdTextParser.h"
+
+#include <float.h>
+#include <string.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+
+namespace
+{
+// Powers of ten that are exactly representable as a double
+const double k_ExactPowersOfTen[] = {1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,  1.0e10, 1.0e11,
+                                     1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+const int k_MaxExactPowerOfTen = 22;
+// Any integer with this many significant digits is exactly representable as a double
+const int k_MaxExactDigits = 15;
+// Number of lines handed to a single task
+const size_t k_LinesPerChunk = 16384;
+
+/**
+ * @brief The ParseChunkTask class parses one chunk of lines on the thread pool
+ */
+class ParseChunkTask : public QRunnable
+{
+public:
+  ParseChunkTask(EbsdTextParser::LineChunkParser* parser, const char* begin, const char* end, size_t firstLine, size_t numLines, int* err, size_t* errorLine)
+  : m_Parser(parser)
+  , m_Begin(begin)
+  , m_End(end)
+  , m_FirstLine(firstLine)
+  , m_NumLines(numLines)
+  , m_Err(err)
+  , m_ErrorLine(errorLine)
+  {
+  }
+  virtual ~ParseChunkTask()
+  {
+  }
+
+  void run()
+  {
+    *m_Err = m_Parser->parseLines(m_Begin, m_End, m_FirstLine, m_NumLines, *m_ErrorLine);
+  }
+
+private:
+  EbsdTextParser::LineChunkParser* m_Parser;
+  const char* m_Begin;
+  const char* m_End;
+  size_t m_FirstLine;
+  size_t m_NumLines;
+  int* m_Err;
+  size_t* m_ErrorLine;
+};
+
+typedef struct
+{
+  const char* begin;
+  const char* end;
+  size_t firstLine;
+  size_t numLines;
+  int err;
+  size_t errorLine;
+} LineChunk_t;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::EbsdTextParser()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::~EbsdTextParser()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::ParseFloat(const char* begin, const char* end, bool decimalComma, float& value)
+{
+  const char* pos = begin;
+  bool negative = false;
+  if(pos < end && (*pos == '-' || *pos == '+'))
+  {
+    negative = (*pos == '-');
+    ++pos;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool sawDigit = false;
+  bool exact = true;
+  for(; pos < end && *pos >= '0' && *pos <= '9'; ++pos)
+  {
+    sawDigit = true;
+    if(mantissa == 0 && *pos == '0')
+    {
+      continue;
+    }
+    if(digits < k_MaxExactDigits)
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+      ++digits;
+    }
+    else
+    {
+      exact = false;
+      break;
+    }
+  }
+  if(exact && pos < end && (*pos == '.' || (decimalComma && *pos == ',')))
+  {
+    for(++pos; pos < end && *pos >= '0' && *pos <= '9'; ++pos)
+    {
+      sawDigit = true;
+      if(mantissa == 0 && *pos == '0')
+      {
+        --exponent;
+        continue;
+      }
+      if(digits < k_MaxExactDigits)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+        ++digits;
+        --exponent;
+      }
+      else
+      {
+        exact = false;
+        break;
+      }
+    }
+  }
+  if(exact && sawDigit && pos < end && (*pos == 'e' || *pos == 'E'))
+  {
+    ++pos;
+    bool negativeExponent = false;
+    if(pos < end && (*pos == '-' || *pos == '+'))
+    {
+      negativeExponent = (*pos == '-');
+      ++pos;
+    }
+    int e = 0;
+    bool sawExponentDigit = false;
+    for(; pos < end && *pos >= '0' && *pos <= '9' && e < 1000; ++pos)
+    {
+      e = e * 10 + (*pos - '0');
+      sawExponentDigit = true;
+    }
+    exact = sawExponentDigit;
+    exponent += negativeExponent ? -e : e;
+  }
+
+  if(exact && sawDigit && pos == end && exponent >= -k_MaxExactPowerOfTen && exponent <= k_MaxExactPowerOfTen)
+  {
+    // Both operands are exact so the result is the correctly rounded double
+    double d = static_cast<double>(mantissa);
+    d = (exponent < 0) ? d / k_ExactPowersOfTen[-exponent] : d * k_ExactPowersOfTen[exponent];
+    if(d <= FLT_MAX && (d == 0.0 || d >= FLT_MIN))
+    {
+      value = static_cast<float>(negative ? -d : d);
+      return true;
+    }
+  }
+
+  // Hand anything unusual to Qt so the results match the QByteArray based parsers
+  QByteArray token(begin, static_cast<int>(end - begin));
+  if(decimalComma)
+  {
+    token.replace(',', '.');
+  }
+  bool ok = false;
+  value = token.toFloat(&ok);
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::ParseInt(const char* begin, const char* end, int32_t& value)
+{
+  const char* pos = begin;
+  bool negative = false;
+  if(pos < end && (*pos == '-' || *pos == '+'))
+  {
+    negative = (*pos == '-');
+    ++pos;
+  }
+  // Nine digits always fit into an int32_t
+  if(pos < end && end - pos <= 9)
+  {
+    int32_t v = 0;
+    for(; pos < end && *pos >= '0' && *pos <= '9'; ++pos)
+    {
+      v = v * 10 + (*pos - '0');
+    }
+    if(pos == end)
+    {
+      value = negative ? -v : v;
+      return true;
+    }
+  }
+
+  QByteArray token(begin, static_cast<int>(end - begin));
+  bool ok = false;
+  value = token.toInt(&ok, 10);
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* EbsdTextParser::LineEnd(const char* pos, const char* end)
+{
+  const char* eol = static_cast<const char*>(::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+  return (nullptr == eol) ? end : eol;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* EbsdTextParser::SkipLines(const char* pos, const char* end, size_t numLines)
+{
+  for(size_t i = 0; i < numLines && pos < end; i++)
+  {
+    pos = LineEnd(pos, end);
+    if(pos < end)
+    {
+      ++pos;
+    }
+  }
+  return pos;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int EbsdTextParser::ParseLinesInParallel(const char* begin, const char* end, size_t maxLines, LineChunkParser* parser, size_t& numLines, size_t& errorLine)
+{
+  while(end > begin && IsSpace(end[-1]))
+  {
+    --end;
+  }
+
+  // Find the chunk boundaries in one pass over the data. Only one entry per chunk is
+  // stored so the memory overhead does not grow with the number of lines.
+  QVector<LineChunk_t> chunks;
+  const char* pos = begin;
+  numLines = 0;
+  while(pos < end && numLines < maxLines)
+  {
+    LineChunk_t chunk;
+    chunk.begin = pos;
+    chunk.firstLine = numLines;
+    chunk.numLines = 0;
+    chunk.err = 0;
+    chunk.errorLine = 0;
+    while(pos < end && chunk.numLines < k_LinesPerChunk && numLines < maxLines)
+    {
+      pos = LineEnd(pos, end);
+      if(pos < end)
+      {
+        ++pos;
+      }
+      ++chunk.numLines;
+      ++numLines;
+    }
+    chunk.end = pos;
+    chunks.push_back(chunk);
+  }
+
+  if(chunks.size() == 1)
+  {
+    chunks[0].err = parser->parseLines(chunks[0].begin, chunks[0].end, chunks[0].firstLine, chunks[0].numLines, chunks[0].errorLine);
+  }
+  else if(chunks.size() > 1)
+  {
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    for(int i = 0; i < chunks.size(); i++)
+    {
+      LineChunk_t& chunk = chunks[i];
+      pool.start(new ParseChunkTask(parser, chunk.begin, chunk.end, chunk.firstLine, chunk.numLines, &(chunk.err), &(chunk.errorLine)));
+    }
+    pool.waitForDone();
+  }
+
+  for(int i = 0; i < chunks.size(); i++)
+  {
+    if(chunks[i].err < 0)
+    {
+      errorLine = chunks[i].errorLine;
+      return chunks[i].err;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,146 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _ebsdtextparser_h_
+#define _ebsdtextparser_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdLib.h"
+
+
+/**
+ * @class EbsdTextParser EbsdTextParser.h EbsdLib/EbsdTextParser.h
+ * @brief This class holds the helpers used to parse the data section of the ASCII
+ * based EBSD files (.ang, .ctf) straight out of a memory mapped file. The numeric
+ * parsers work on [begin, end) character ranges and never allocate memory for the
+ * common number formats. The results are identical to QByteArray::toFloat() and
+ * QByteArray::toInt() because any token that the fast path can not convert exactly
+ * is handed to those methods.
+ *
+ * @date Oct 18, 2016
+ * @version 1.0
+ */
+class EbsdLib_EXPORT EbsdTextParser
+{
+  public:
+    EBSD_TYPE_MACRO(EbsdTextParser)
+
+    virtual ~EbsdTextParser();
+
+    /**
+     * @brief The LineChunkParser class is implemented by the readers to parse a range of whole
+     * lines. Different chunks are parsed concurrently so implementations must only write
+     * to the elements that belong to the lines they are given.
+     */
+    class EbsdLib_EXPORT LineChunkParser
+    {
+      public:
+        virtual ~LineChunkParser() {}
+
+        /**
+         * @brief parseLines Parses the lines in the range [begin, end)
+         * @param begin The first character of the first line
+         * @param end One past the last character of the last line
+         * @param firstLine The index of the first line relative to the first line of the data
+         * @param numLines The number of lines in the range
+         * @param errorLine Set to the index of the line that caused an error
+         * @return Zero on success or a negative error code
+         */
+        virtual int parseLines(const char* begin, const char* end, size_t firstLine, size_t numLines, size_t& errorLine) = 0;
+    };
+
+    /**
+     * @brief ParseFloat Converts the characters in [begin, end) to a float.
+     * @param begin The first character of the token
+     * @param end One past the last character of the token
+     * @param decimalComma Also accept a ',' as the decimal separator
+     * @param value The converted value or 0.0 if the conversion failed
+     * @return true if the conversion succeeded
+     */
+    static bool ParseFloat(const char* begin, const char* end, bool decimalComma, float& value);
+
+    /**
+     * @brief ParseInt Converts the characters in [begin, end) to a base 10 integer.
+     * @param begin The first character of the token
+     * @param end One past the last character of the token
+     * @param value The converted value or 0 if the conversion failed
+     * @return true if the conversion succeeded
+     */
+    static bool ParseInt(const char* begin, const char* end, int32_t& value);
+
+    /**
+     * @brief IsSpace Returns true for the same ASCII white space characters that QByteArray::simplified() removes
+     */
+    static inline bool IsSpace(char c)
+    {
+      return (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r');
+    }
+
+    /**
+     * @brief LineEnd Returns a pointer to the '\n' that ends the line starting at pos or end if there is none
+     */
+    static const char* LineEnd(const char* pos, const char* end);
+
+    /**
+     * @brief SkipLines Returns a pointer to the first character after numLines lines starting at pos
+     */
+    static const char* SkipLines(const char* pos, const char* end, size_t numLines);
+
+    /**
+     * @brief ParseLinesInParallel Walks the lines in [begin, end) once, splitting them into chunks of whole
+     * lines, and hands the chunks to the parser on a pool of threads. Trailing white space at the end of
+     * the range is ignored.
+     * @param begin The first character of the first line
+     * @param end One past the last character of the data
+     * @param maxLines The maximum number of lines to parse
+     * @param parser The parser for the chunks
+     * @param numLines Set to the number of lines that were found
+     * @param errorLine Set to the index of the first line that caused an error
+     * @return Zero on success or the error code of the first line that failed
+     */
+    static int ParseLinesInParallel(const char* begin, const char* end, size_t maxLines, LineChunkParser* parser, size_t& numLines, size_t& errorLine);
+
+  protected:
+    EbsdTextParser();
+
+  private:
+    EbsdTextParser(const EbsdTextParser&); // Copy Constructor Not Implemented
+    void operator=(const EbsdTextParser&); // Operator '=' Not Implemented
+};
+
+#endif /* _ebsdtextparser_h_ */
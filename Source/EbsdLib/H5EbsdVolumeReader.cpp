@@ -103,6 +103,29 @@ int H5EbsdVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoin
   return -1;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdReader::Pointer H5EbsdVolumeReader::readSlice(int slice)
+{
+  // This class should be subclassed and this method implemented.
+  return EbsdReader::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5EbsdVolumeReader::getSliceOffset(int slice, int64_t sliceXPoints, int64_t sliceYPoints,
+                                          int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
+{
+  int64_t xstartspot = (xpoints - sliceXPoints) / 2;
+  int64_t ystartspot = (ypoints - sliceYPoints) / 2;
+  int64_t zval = 0;
+  if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
+  if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = (zpoints - 1) - slice; }
+  return static_cast<size_t>((zval * xpoints * ypoints) + (ystartspot * xpoints) + xstartspot);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -44,6 +44,7 @@
 #include "EbsdLib/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/EbsdReader.h"
 #include "EbsdLib/H5EbsdVolumeInfo.h"
 
 
@@ -99,6 +100,33 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
     virtual int loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints,
                          uint32_t ZDir);
 
+    /**
+     * @brief Reads a single slice from the HDF5 file into a new reader object. Only the
+     * arrays selected with setArraysToRead()/readAllArrays() are read. This is the only
+     * part of loading the volume that calls into the HDF5 library so callers that overlap
+     * the loading of several slices must only call this from one thread at a time.
+     * Subclasses need to implement this. The default implementation returns a nullptr.
+     * @param slice The index of the slice relative to the SliceStart value
+     * @return The reader holding the slice data or a nullptr if the slice could not be read.
+     */
+    virtual EbsdReader::Pointer readSlice(int slice);
+
+    /**
+     * @brief Computes the index of the first voxel of a slice inside the volume. Slices
+     * that are smaller than the volume are centered in the X and Y directions.
+     * @param slice The index of the slice relative to the SliceStart value
+     * @param sliceXPoints The number of x voxels in the slice
+     * @param sliceYPoints The number of y voxels in the slice
+     * @param xpoints The number of x voxels in the volume
+     * @param ypoints The number of y voxels in the volume
+     * @param zpoints The number of z voxels in the volume
+     * @param ZDir The stacking order of the slices
+     * @return The volume index of the first voxel of the slice. Consecutive rows of the slice
+     * are xpoints apart.
+     */
+    static size_t getSliceOffset(int slice, int64_t sliceXPoints, int64_t sliceYPoints,
+                                 int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir);
+
 
     /** @brief Will this class be responsible for deallocating the memory for the data arrays */
     EBSD_INSTANCE_PROPERTY(bool, ManageMemory)
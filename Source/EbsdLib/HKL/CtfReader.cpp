@@ -47,6 +47,75 @@
 #include "CtfPhase.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
+
+namespace
+{
+/**
+ * @brief The CtfChunkParser class parses chunks of tab delimited data lines from a memory
+ * mapped .ctf file straight into the arrays of the DataParsers.
+ */
+class CtfChunkParser : public EbsdTextParser::LineChunkParser
+{
+public:
+  CtfChunkParser(const QVector<DataParser*>& columns)
+  : m_Columns(columns)
+  {
+  }
+  virtual ~CtfChunkParser()
+  {
+  }
+
+  int parseLines(const char* begin, const char* end, size_t firstLine, size_t numLines, size_t& errorLine)
+  {
+    const char* pos = begin;
+    for(size_t i = firstLine; i < firstLine + numLines; i++)
+    {
+      const char* lineEnd = EbsdTextParser::LineEnd(pos, end);
+      const char* next = (lineEnd < end) ? lineEnd + 1 : end;
+      // Remove leading and trailing whitespace
+      while(pos < lineEnd && EbsdTextParser::IsSpace(*pos))
+      {
+        ++pos;
+      }
+      while(lineEnd > pos && EbsdTextParser::IsSpace(lineEnd[-1]))
+      {
+        --lineEnd;
+      }
+
+      int numTokens = 1;
+      for(const char* c = pos; c < lineEnd; ++c)
+      {
+        if(*c == '\t')
+        {
+          ++numTokens;
+        }
+      }
+      if(numTokens != m_Columns.size())
+      {
+        errorLine = i;
+        return -106;
+      }
+
+      for(int c = 0; c < numTokens; c++)
+      {
+        const char* tokenEnd = pos;
+        while(tokenEnd < lineEnd && *tokenEnd != '\t')
+        {
+          ++tokenEnd;
+        }
+        m_Columns[c]->parse(pos, tokenEnd, i);
+        pos = (tokenEnd < lineEnd) ? tokenEnd + 1 : lineEnd;
+      }
+      pos = next;
+    }
+    return 0;
+  }
+
+private:
+  QVector<DataParser*> m_Columns;
+};
+}
 
 
 
@@ -302,7 +371,7 @@ int CtfReader::readFile()
     return -103;
   }
 
-  err = readData(in);
+  err = readData(in, headerLines.size());
 
   return err;
 }
@@ -318,7 +387,7 @@ void CtfReader::readOnlySliceIndex(int slice)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int CtfReader::readData(QFile& in)
+int CtfReader::readData(QFile& in, size_t headerLineCount)
 {
   // Delete any currently existing pointers
   deletePointers();
@@ -404,46 +473,70 @@ int CtfReader::readData(QFile& in)
 
   }
 
-  // Now start reading the data line by line
   int err = 0;
   size_t counter = 0;
-  for (int slice = zStart; slice < zEnd; ++slice)
+  bool reachedEnd = false;
+
+  // Memory map the file and parse the data section in parallel chunks. If the file can not be
+  // mapped fall back to reading the data one line at a time.
+  uchar* mappedFile = in.map(0, in.size());
+  if(nullptr != mappedFile)
+  {
+    const char* fileBegin = reinterpret_cast<const char*>(mappedFile);
+    const char* fileEnd = fileBegin + in.size();
+    // Skip the header and the column header line
+    const char* data = EbsdTextParser::SkipLines(fileBegin, fileEnd, headerLineCount + 1);
+    if(m_SingleSliceRead >= 0)
+    {
+      data = EbsdTextParser::SkipLines(data, fileEnd, static_cast<size_t>(m_SingleSliceRead) * xCells * yCells);
+    }
+    err = parseMappedData(data, fileEnd, counter);
+    in.unmap(mappedFile);
+    if (err < 0) { return err; }
+    reachedEnd = (counter < totalScanPoints);
+  }
+  else
   {
-    for (size_t row = 0; row < yCells; ++row)
+    // Now start reading the data line by line
+    for (int slice = zStart; slice < zEnd; ++slice)
     {
-      for (size_t col = 0; col < xCells; ++col)
+      for (size_t row = 0; row < yCells; ++row)
       {
-        buf = in.readLine(); // Read the line into a QByteArray including the newline
-        buf = buf.trimmed(); // Remove leading and trailing whitespace
-
-        if ( (m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead) )
+        for (size_t col = 0; col < xCells; ++col)
         {
+          buf = in.readLine(); // Read the line into a QByteArray including the newline
+          buf = buf.trimmed(); // Remove leading and trailing whitespace
 
-          if(in.atEnd() == true && buf.isEmpty() == true) // We have to have read to the end of the file AND the buffer is empty
-            // otherwise we read EXACTLY the last line and we still need to parse the line.
+          if ( (m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead) )
           {
-            //  ++counter; // We need to make sure this gets incremented before leaving
-            break;
+
+            if(in.atEnd() == true && buf.isEmpty() == true) // We have to have read to the end of the file AND the buffer is empty
+              // otherwise we read EXACTLY the last line and we still need to parse the line.
+            {
+              //  ++counter; // We need to make sure this gets incremented before leaving
+              break;
+            }
+            err = parseDataLine(buf, row, col, counter, xCells, yCells);
+            if (err < 0) { return err; }
+            ++counter;
           }
-          err = parseDataLine(buf, row, col, counter, xCells, yCells);
-          if (err < 0) { return err; }
-          ++counter;
-        }
 
+        }
+        if(in.atEnd() == true)
+        {
+          reachedEnd = true;
+          break;
+        }
       }
-      if(in.atEnd() == true)
+      //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
+      if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
       {
         break;
       }
     }
-    //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
-    if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
-    {
-      break;
-    }
   }
 
-  if(counter != getNumberOfElements() && in.atEnd() == true)
+  if(counter != getNumberOfElements() && reachedEnd == true)
   {
     ss.string()->clear();
     ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter
@@ -455,6 +548,47 @@ int CtfReader::readData(QFile& in)
   return 0;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::parseMappedData(const char* data, const char* end, size_t& numLines)
+{
+  // Order the parsers by the column they read
+  QVector<DataParser*> columns(m_NamePointerMap.size(), nullptr);
+  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
+  while (iter.hasNext())
+  {
+    iter.next();
+    DataParser::Pointer dparser = iter.value();
+    if(dparser->getColumnIndex() >= columns.size())
+    {
+      setErrorCode(-107);
+      setErrorMessage("The CTF file contains duplicate column headers. Please check the CTF file for mistakes.");
+      return -107;
+    }
+    columns[dparser->getColumnIndex()] = dparser.get();
+  }
+
+  size_t xCells = getXCells();
+  size_t errorLine = 0;
+  CtfChunkParser parser(columns);
+  int err = EbsdTextParser::ParseLinesInParallel(data, end, getNumberOfElements(), &parser, numLines, errorLine);
+  if(err < 0)
+  {
+    size_t row = errorLine / xCells;
+    setErrorCode(-107);
+    QString msg;
+    QTextStream ss(&msg);
+    ss << "The number of tab delimited data columns does not match the number of tab delimited header columns (";
+    ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes.";
+    ss << "The error occurred at data row " << row << " which is " << row << " past ";
+    ss << "the column header row.";
+    ss << "\nThe CTF Reader will now abort reading any further in the file.";
+    setErrorMessage(msg);
+  }
+  return err;
+}
+
 #if 0
 #define PRINT_HTML_TABLE_ROW(p)\
   std::cout << "<tr>\n    <td>" << p->getKey() << "</td>\n    <td>" << p->getHDFType() << "</td>\n";\
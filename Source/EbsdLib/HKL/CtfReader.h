@@ -198,10 +198,21 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
     int parseHeaderLines(QList<QByteArray>& headerLines);
 
     /**
-       * @brief
+       * @brief Reads the data section of the file. The file is memory mapped and parsed in parallel
+       * chunks when possible, otherwise it is read line by line.
        * @param in The input file stream to read from
+       * @param headerLineCount The number of header lines before the column header line
        */
-    int readData(QFile& in);
+    int readData(QFile& in, size_t headerLineCount);
+
+    /**
+     * @brief Parses the data section of a memory mapped file straight into the DataParser arrays
+     * @param data The first character of the first line to parse
+     * @param end One past the last character of the file
+     * @param numLines Set to the number of data lines that were found
+     * @return Zero on success or a negative error code
+     */
+    int parseMappedData(const char* data, const char* end, size_t& numLines);
 
     /**
     * @brief Reads a line of Data from the ASCII based file
@@ -39,6 +39,7 @@
 #include <QtCore/QString>
 
 #include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 class DataParser
 {
@@ -59,6 +60,12 @@ class DataParser
 
 
     virtual void parse(const QByteArray& token, size_t index) {}
+
+    /**
+     * @brief Parses the token in [begin, end) without creating any intermediate objects. A ','
+     * is accepted as the decimal separator for floating point values.
+     */
+    virtual void parse(const char* begin, const char* end, size_t index) {}
   protected:
     DataParser() {}
 
@@ -118,6 +125,11 @@ class Int32Parser : public DataParser
       m_Ptr[index] = token.toInt(&ok, 10);
     }
 
+    virtual void parse(const char* begin, const char* end, size_t index)
+    {
+      EbsdTextParser::ParseInt(begin, end, m_Ptr[index]);
+    }
+
   protected:
     Int32Parser(int32_t* ptr, size_t size, const QString& name, int index) :
       m_Ptr(ptr)
@@ -185,6 +197,11 @@ class FloatParser : public DataParser
       m_Ptr[index] = token.toFloat(&ok);
     }
 
+    virtual void parse(const char* begin, const char* end, size_t index)
+    {
+      EbsdTextParser::ParseFloat(begin, end, true, m_Ptr[index]);
+    }
+
   protected:
     FloatParser(float* ptr, size_t size, const QString& name, int index) :
       m_Ptr(ptr)
@@ -204,6 +204,33 @@ QVector<CtfPhase::Pointer> H5CtfVolumeReader::getPhases()
   return m_Phases;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdReader::Pointer H5CtfVolumeReader::readSlice(int slice)
+{
+  H5CtfReader::Pointer reader = H5CtfReader::New();
+  reader->setFileName(getFileName());
+  reader->setHDF5Path(QString::number(slice + getSliceStart()));
+  reader->setUserZDir(getStackingOrder());
+  reader->setSampleTransformationAngle(getSampleTransformationAngle());
+  reader->setSampleTransformationAxis(getSampleTransformationAxis());
+  reader->setEulerTransformationAngle(getEulerTransformationAngle());
+  reader->setEulerTransformationAxis(getEulerTransformationAxis());
+  reader->readAllArrays(getReadAllArrays());
+  reader->setArraysToRead(getArraysToRead());
+
+  int err = reader->readFile();
+  if (err < 0)
+  {
+    std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+    setErrorCode(-77000);
+    setErrorMessage("H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file.");
+    return EbsdReader::NullPointer();
+  }
+  return reader;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -212,7 +239,7 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir)
 {
-  int index = 0;
+  size_t index = 0;
   int err = -1;
 // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
@@ -220,35 +247,24 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
   int readerIndex = 0;
   int64_t xpointsslice = 0;
   int64_t ypointsslice = 0;
-  int64_t xpointstemp = 0;
-  int64_t ypointstemp = 0;
-  int zval = 0;
-
-
-  int xstartspot = 0;
-  int ystartspot = 0;
+  size_t sliceOffset = 0;
 
   err = readVolumeInfo();
 
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5CtfReader::Pointer reader = H5CtfReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-
-    err = reader->readFile();
-    if (err < 0)
+    EbsdReader::Pointer sliceReader = readSlice(slice);
+    if (nullptr == sliceReader.get())
     {
-      std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
       return -77000;
     }
+    H5CtfReader* reader = dynamic_cast<H5CtfReader*>(sliceReader.get());
     readerIndex = 0;
     xpointsslice = reader->getXCells();
     ypointsslice = reader->getYCells();
@@ -264,25 +280,14 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
     int* bcPtr = reader->getBandContrastPointer();
     int* bsPtr = reader->getBandSlopePointer();
 
-    xpointstemp = xpoints;
-    ypointstemp = ypoints;
-    xstartspot = static_cast<int>( (xpointstemp - xpointsslice) / 2 );
-    ystartspot = static_cast<int>( (ypointstemp - ypointsslice) / 2 );
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
-    if (ZDir == 0) { zval = slice; }
-    if (ZDir == 1) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    sliceOffset = getSliceOffset(slice, xpointsslice, ypointsslice, xpoints, ypoints, zpoints, ZDir);
 
     // Copy the data from the current storage into the Storage Location
     for (int j = 0; j < ypointsslice; j++)
     {
       for (int i = 0; i < xpointsslice; i++)
       {
-        index = static_cast<int>( (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
+        index = sliceOffset + (j * xpoints) + i;
         if (nullptr != phasePtr) {m_Phase[index] = phasePtr[readerIndex];}
         if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
         if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
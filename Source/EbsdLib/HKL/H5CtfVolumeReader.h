@@ -92,6 +92,13 @@ class EbsdLib_EXPORT H5CtfVolumeReader : public H5EbsdVolumeReader
     int loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints,
                  uint32_t ZDir);
 
+    /**
+     * @brief Reads a single slice of HKL data into a new H5CtfReader
+     * @param slice The index of the slice relative to the SliceStart value
+     * @return The H5CtfReader holding the slice or a nullptr on error
+     */
+    EbsdReader::Pointer readSlice(int slice);
+
     /**
      * @brief
      * @return
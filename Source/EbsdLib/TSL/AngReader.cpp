@@ -44,6 +44,99 @@
 #include "AngConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
+
+namespace
+{
+/**
+ * @brief The AngChunkParser class parses chunks of data lines from a memory mapped .ang
+ * file. The columns are the same as the ones handled by AngReader::parseDataLine.
+ */
+class AngChunkParser : public EbsdTextParser::LineChunkParser
+{
+public:
+  static const int k_MaxColumns = 10;
+
+  AngChunkParser(float* phi1, float* phi, float* phi2, float* x, float* y, float* iq, float* ci, int* phase, float* semSignal, float* fit)
+  {
+    m_Columns[0] = phi1;
+    m_Columns[1] = phi;
+    m_Columns[2] = phi2;
+    m_Columns[3] = x;
+    m_Columns[4] = y;
+    m_Columns[5] = iq;
+    m_Columns[6] = ci;
+    m_Columns[7] = nullptr;
+    m_Columns[8] = semSignal;
+    m_Columns[9] = fit;
+    m_Phase = phase;
+  }
+  virtual ~AngChunkParser()
+  {
+  }
+
+  int parseLines(const char* begin, const char* end, size_t firstLine, size_t numLines, size_t& errorLine)
+  {
+    int err = 0;
+    const char* pos = begin;
+    for(size_t i = firstLine; i < firstLine + numLines; i++)
+    {
+      const char* lineEnd = EbsdTextParser::LineEnd(pos, end);
+      int lineErr = parseLine(pos, lineEnd, i);
+      if(lineErr < 0 && err == 0)
+      {
+        err = lineErr;
+        errorLine = i;
+      }
+      pos = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+    return err;
+  }
+
+private:
+  float* m_Columns[k_MaxColumns];
+  int* m_Phase;
+
+  int parseLine(const char* pos, const char* lineEnd, size_t offset)
+  {
+    int err = 0;
+    int column = 0;
+    while(column < k_MaxColumns)
+    {
+      while(pos < lineEnd && EbsdTextParser::IsSpace(*pos))
+      {
+        ++pos;
+      }
+      if(pos == lineEnd && column > 0)
+      {
+        break;
+      }
+      const char* tokenEnd = pos;
+      while(tokenEnd < lineEnd && !EbsdTextParser::IsSpace(*tokenEnd))
+      {
+        ++tokenEnd;
+      }
+      bool ok = true;
+      if(column == 7)
+      {
+        ok = EbsdTextParser::ParseInt(pos, tokenEnd, m_Phase[offset]);
+      }
+      else if(nullptr != m_Columns[column])
+      {
+        ok = EbsdTextParser::ParseFloat(pos, tokenEnd, false, m_Columns[column][offset]);
+      }
+      // The SEM Signal and Fit columns are optional and never flagged as errors
+      if(!ok && column < 8)
+      {
+        err = -501 - column;
+      }
+      pos = tokenEnd;
+      ++column;
+    }
+    return err;
+  }
+};
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -303,6 +396,7 @@ int AngReader::readFile()
   setOriginalHeader(origHeader);
   m_PhaseVector.clear();
 
+  size_t headerLineCount = 0;
   while(!in.atEnd() && false == getHeaderIsComplete())
   {
     buf = in.readLine();
@@ -314,6 +408,7 @@ int AngReader::readFile()
     {
       origHeader.append(buf);
       parseHeaderLine(buf);
+      ++headerLineCount;
     }
   }
   // Update the Original Header variable
@@ -337,7 +432,7 @@ int AngReader::readFile()
     return -150;
   }
   // We need to pass in the buffer because it has the first line of data
-  readData(in, buf);
+  readData(in, buf, headerLineCount);
   if(getErrorCode() < 0)
   {
     return getErrorCode();
@@ -349,7 +444,7 @@ int AngReader::readFile()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AngReader::readData(QFile& in, QByteArray& buf)
+void AngReader::readData(QFile& in, QByteArray& buf, size_t headerLineCount)
 {
   QString streamBuf;
   QTextStream ss(&streamBuf);
@@ -437,49 +532,84 @@ void AngReader::readData(QFile& in, QByteArray& buf)
   int nxOdd = 0;
   int nxEven = 0;
   // int nRows = 0;
-
-  for(size_t i = 0; i < totalDataPoints; ++i)
-  {
-    if(i > 0)
-    {
-      //  ::memset(buf, 0, bufSize); // Clear the buffer
-      buf = in.readLine();
-      ++counter;
-    }
-    this->parseDataLine(buf, i);
-    if(getErrorCode() < 0)
-    {
+  bool reachedEnd = false;
+
+  // Memory map the file and parse the data section in parallel chunks. If the file can not be
+  // mapped fall back to reading the data one line at a time.
+  uchar* mappedFile = in.map(0, in.size());
+  if(nullptr != mappedFile)
+  {
+    const char* fileBegin = reinterpret_cast<const char*>(mappedFile);
+    const char* fileEnd = fileBegin + in.size();
+    const char* data = EbsdTextParser::SkipLines(fileBegin, fileEnd, headerLineCount);
+    size_t numLines = 0;
+    size_t errorLine = 0;
+    int err = parseMappedData(data, fileEnd, totalDataPoints, numLines, errorLine);
+    if(err < 0)
+    {
+      const char* line = EbsdTextParser::SkipLines(data, fileEnd, errorLine);
+      buf = QByteArray(line, static_cast<int>(EbsdTextParser::LineEnd(line, fileEnd) - line));
+      counter = errorLine + 1;
+      setErrorCode(err);
       ss.string()->clear();
-
       ss << "Error parsing the data line.\n"
          << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
-         << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+         << "\n***Parsing Position ***\nCurrent Data Point Count: " << counter << "\n";
       setErrorMessage(*(ss.string()));
-      break;
-    }
-
-    if(fabs(m_Y[i] - oldY) > 1e-6)
-    {
-      ++yChange;
-      oldY = m_Y[i];
-      onEvenRow = !onEvenRow;
-      col = 0;
     }
     else
     {
-      col++;
-    }
-    if(yChange == 0)
-    {
-      ++nxOdd;
-    }
-    if(yChange == 1)
-    {
-      ++nxEven;
+      counter = numLines;
+      reachedEnd = (numLines < totalDataPoints);
     }
-    if(in.atEnd() == true)
+    in.unmap(mappedFile);
+  }
+  else
+  {
+    for(size_t i = 0; i < totalDataPoints; ++i)
     {
-      break;
+      if(i > 0)
+      {
+        //  ::memset(buf, 0, bufSize); // Clear the buffer
+        buf = in.readLine();
+        ++counter;
+      }
+      this->parseDataLine(buf, i);
+      if(getErrorCode() < 0)
+      {
+        ss.string()->clear();
+
+        ss << "Error parsing the data line.\n"
+           << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+           << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+        setErrorMessage(*(ss.string()));
+        break;
+      }
+
+      if(fabs(m_Y[i] - oldY) > 1e-6)
+      {
+        ++yChange;
+        oldY = m_Y[i];
+        onEvenRow = !onEvenRow;
+        col = 0;
+      }
+      else
+      {
+        col++;
+      }
+      if(yChange == 0)
+      {
+        ++nxOdd;
+      }
+      if(yChange == 1)
+      {
+        ++nxEven;
+      }
+      if(in.atEnd() == true)
+      {
+        reachedEnd = true;
+        break;
+      }
     }
   }
 
@@ -503,7 +633,7 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  if(counter != totalDataPoints && in.atEnd() == true)
+  if(counter != totalDataPoints && reachedEnd == true)
   {
     ss.string()->clear();
 
@@ -515,6 +645,15 @@ void AngReader::readData(QFile& in, QByteArray& buf)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::parseMappedData(const char* data, const char* end, size_t totalDataPoints, size_t& numLines, size_t& errorLine)
+{
+  AngChunkParser parser(m_Phi1, m_Phi, m_Phi2, m_X, m_Y, m_Iq, m_Ci, m_PhaseData, m_SEMSignal, m_Fit);
+  return EbsdTextParser::ParseLinesInParallel(data, end, totalDataPoints, &parser, numLines, errorLine);
+}
+
 // -----------------------------------------------------------------------------
 //  Read the Header part of the ANG file
 // -----------------------------------------------------------------------------
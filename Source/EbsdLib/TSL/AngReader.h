@@ -148,7 +148,25 @@ class EbsdLib_EXPORT AngReader : public EbsdReader
     AngPhase::Pointer   m_CurrentPhase;
 
 
-    void readData(QFile& in, QByteArray& buf);
+    /**
+     * @brief Reads the data section of the file. The file is memory mapped and parsed in parallel
+     * chunks when possible, otherwise it is read line by line.
+     * @param in The open file
+     * @param buf The first line of data
+     * @param headerLineCount The number of lines before the first line of data
+     */
+    void readData(QFile& in, QByteArray& buf, size_t headerLineCount);
+
+    /**
+     * @brief Parses the data section of a memory mapped file straight into the data arrays
+     * @param data The first character of the data section
+     * @param end One past the last character of the file
+     * @param totalDataPoints The number of data points to parse
+     * @param numLines Set to the number of data lines that were found
+     * @param errorLine Set to the index of the first line that could not be parsed
+     * @return Zero on success or a negative error code
+     */
+    int parseMappedData(const char* data, const char* end, size_t totalDataPoints, size_t& numLines, size_t& errorLine);
 
     /** @brief Parses the value from a single line of the header section of the TSL .ang file
     * @param line The line to parse
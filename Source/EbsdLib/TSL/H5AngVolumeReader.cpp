@@ -203,6 +203,31 @@ QVector<AngPhase::Pointer> H5AngVolumeReader::getPhases()
 
 
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdReader::Pointer H5AngVolumeReader::readSlice(int slice)
+{
+  H5AngReader::Pointer reader = H5AngReader::New();
+  reader->setFileName(getFileName());
+  reader->setHDF5Path(QString::number(slice + getSliceStart()));
+  reader->setUserZDir(getStackingOrder());
+  reader->setSampleTransformationAngle(getSampleTransformationAngle());
+  reader->setSampleTransformationAxis(getSampleTransformationAxis());
+  reader->setEulerTransformationAngle(getEulerTransformationAngle());
+  reader->setEulerTransformationAxis(getEulerTransformationAxis());
+  reader->readAllArrays(getReadAllArrays());
+  reader->setArraysToRead(getArraysToRead());
+  int err = reader->readFile();
+  if(err < 0)
+  {
+    setErrorCode(reader->getErrorCode());
+    setErrorMessage(reader->getErrorMessage());
+    return EbsdReader::NullPointer();
+  }
+  return reader;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -211,44 +236,31 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir )
 {
-  int index = 0;
+  size_t index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-
   int readerIndex = 0;
   int xpointsslice = 0;
   int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
-  int zval = 0;
-
-  int xstartspot = 0;
-  int ystartspot = 0;
+  size_t sliceOffset = 0;
+
   int numPhases = getNumPhases();
   err = readVolumeInfo();
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5AngReader::Pointer reader = H5AngReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
-    if(err < 0)
+    EbsdReader::Pointer sliceReader = readSlice(slice);
+    if(nullptr == sliceReader.get())
     {
-      setErrorCode(reader->getErrorCode());
-      setErrorMessage(reader->getErrorMessage());
       return getErrorCode();
     }
+    H5AngReader* reader = dynamic_cast<H5AngReader*>(sliceReader.get());
     readerIndex = 0;
     xpointsslice = reader->getNumEvenCols();
     ypointsslice = reader->getNumRows();
@@ -264,27 +276,14 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
     float* sigPtr = reader->getSEMSignalPointer();
     float* fitPtr = reader->getFitPointer();
 
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
-    if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
-    if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    sliceOffset = getSliceOffset(slice, xpointsslice, ypointsslice, xpoints, ypoints, zpoints, ZDir);
 
     // Copy the data from the current storage into the new memory Location
-    for (int j = 0; j < ystop; j++)
+    for (int j = 0; j < ypointsslice; j++)
     {
-      for (int i = 0; i < xstop; i++)
+      for (int i = 0; i < xpointsslice; i++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
+        index = sliceOffset + (j * xpoints) + i;
         if (nullptr != euler1Ptr) {m_Phi1[index] = euler1Ptr[readerIndex];}
         if (nullptr != euler2Ptr) {m_Phi[index] = euler2Ptr[readerIndex];}
         if (nullptr != euler3Ptr) {m_Phi2[index] = euler3Ptr[readerIndex];}
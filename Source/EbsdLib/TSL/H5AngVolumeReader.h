@@ -89,6 +89,13 @@ class EbsdLib_EXPORT H5AngVolumeReader : public H5EbsdVolumeReader
      */
     int loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir);
 
+    /**
+     * @brief Reads a single slice of OIM data into a new H5AngReader
+     * @param slice The index of the slice relative to the SliceStart value
+     * @return The H5AngReader holding the slice or a nullptr on error
+     */
+    EbsdReader::Pointer readSlice(int slice);
+
     /**
      * @brief
      * @return
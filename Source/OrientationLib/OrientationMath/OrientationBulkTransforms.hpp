@@ -0,0 +1,435 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _orientationbulktransforms_hpp_
+#define _orientationbulktransforms_hpp_
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief Generates a block conversion that applies the per tuple OrientationTransforms method to each
+ * tuple of the block in turn.
+ */
+#define OC_BULK_SCALAR_BLOCK(METHOD)\
+  static void METHOD(const T* in, size_t inStride, T* out, size_t outStride, size_t count)\
+  {\
+    for(size_t i = 0; i < count; i++)\
+    {\
+      OrientationArray_t rot(const_cast<T*>(in + i * inStride), inStride);\
+      OrientationArray_t res(out + i * outStride, outStride);\
+      Transforms_t::METHOD(rot, res);\
+    }\
+  }
+
+/**
+ * @brief The OrientationBulkTransforms class converts whole arrays of orientations between representations.
+ * The tuples are processed in blocks of k_BlockSize, spread across threads when DREAM.3D is built with
+ * multithreading. The conversions in the Euler/Quaternion/Orientation Matrix chain have dedicated block
+ * kernels that gather a block into one array per component and evaluate the same expressions as
+ * OrientationTransforms in straight loops the compiler can vectorize; all other conversions apply the per
+ * tuple OrientationTransforms method to each tuple. T selects the float or double kernels at compile time.
+ * Quaternions use the (<Vector>, Scalar) layout, as everywhere else in the OrientationConverter classes.
+ */
+template <typename T>
+class OrientationBulkTransforms
+{
+  public:
+    typedef OrientationArray<T> OrientationArray_t;
+    typedef OrientationTransforms<OrientationArray_t, T> Transforms_t;
+
+    /**
+     * @brief BlockFunction Converts count tuples from in to out
+     */
+    typedef void (*BlockFunction)(const T* in, size_t inStride, T* out, size_t outStride, size_t count);
+
+    static const size_t k_BlockSize = 256;
+
+    /**
+     * @brief Convert Runs a block conversion over all tuples of an array
+     * @param function The block conversion, e.g. &OrientationBulkTransforms<T>::eu2qu
+     * @param in Input tuples
+     * @param inStride Number of components of each input tuple
+     * @param out Output tuples
+     * @param outStride Number of components of each output tuple
+     * @param nTuples Number of tuples to convert
+     */
+    static void Convert(BlockFunction function, const T* in, size_t inStride, T* out, size_t outStride, size_t nTuples)
+    {
+      ConvertImpl impl(function, in, inStride, out, outStride);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if(doParallel == true && nTuples > k_BlockSize)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples, k_BlockSize), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.convert(0, nTuples);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Block kernels for the Euler/Quaternion/Orientation Matrix chain
+    // -----------------------------------------------------------------------------
+
+    /**
+     * @brief eu2qu Block version of OrientationTransforms::eu2qu
+     */
+    static void eu2qu(const T* in, size_t inStride, T* out, size_t outStride, size_t count)
+    {
+      T e0[k_BlockSize], e1[k_BlockSize], e2[k_BlockSize];
+      T qx[k_BlockSize], qy[k_BlockSize], qz[k_BlockSize], qw[k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = (count - start < k_BlockSize) ? count - start : k_BlockSize;
+        gather3(in + start * inStride, inStride, n, e0, e1, e2);
+        for(size_t i = 0; i < n; i++)
+        {
+          T ee0 = 0.5 * e0[i];
+          T ee1 = 0.5 * e1[i];
+          T ee2 = 0.5 * e2[i];
+          T cPhi = std::cos(ee1);
+          T sPhi = std::sin(ee1);
+          T cm = std::cos(ee0 - ee2);
+          T sm = std::sin(ee0 - ee2);
+          T cp = std::cos(ee0 + ee2);
+          T sp = std::sin(ee0 + ee2);
+          T w = cPhi * cp;
+          T x = -RConst::epsijk * sPhi * cm;
+          T y = -RConst::epsijk * sPhi * sm;
+          T z = -RConst::epsijk * cPhi * sp;
+          // Keep the scalar part positive
+          bool flip = (w < 0.0);
+          qw[i] = flip ? -w : w;
+          qx[i] = flip ? -x : x;
+          qy[i] = flip ? -y : y;
+          qz[i] = flip ? -z : z;
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          T* res = out + (start + i) * outStride;
+          res[0] = qx[i];
+          res[1] = qy[i];
+          res[2] = qz[i];
+          res[3] = qw[i];
+        }
+      }
+    }
+
+    /**
+     * @brief eu2om Block version of OrientationTransforms::eu2om
+     */
+    static void eu2om(const T* in, size_t inStride, T* out, size_t outStride, size_t count)
+    {
+      const T eps = 1.0E-7f;
+      T e0[k_BlockSize], e1[k_BlockSize], e2[k_BlockSize];
+      T om[9][k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = (count - start < k_BlockSize) ? count - start : k_BlockSize;
+        gather3(in + start * inStride, inStride, n, e0, e1, e2);
+        for(size_t i = 0; i < n; i++)
+        {
+          T c1 = std::cos(e0[i]);
+          T c = std::cos(e1[i]);
+          T c2 = std::cos(e2[i]);
+          T s1 = std::sin(e0[i]);
+          T s = std::sin(e1[i]);
+          T s2 = std::sin(e2[i]);
+          om[0][i] = c1 * c2 - s1 * s2 * c;
+          om[1][i] = s1 * c2 + c1 * s2 * c;
+          om[2][i] = s2 * s;
+          om[3][i] = -c1 * s2 - s1 * c2 * c;
+          om[4][i] = -s1 * s2 + c1 * c2 * c;
+          om[5][i] = c2 * s;
+          om[6][i] = s1 * s;
+          om[7][i] = -c1 * s;
+          om[8][i] = c;
+        }
+        for(size_t c = 0; c < 9; c++)
+        {
+          for(size_t i = 0; i < n; i++)
+          {
+            om[c][i] = (std::fabs(om[c][i]) < eps) ? static_cast<T>(0.0) : om[c][i];
+          }
+        }
+        scatterMatrix(om, n, out + start * outStride, outStride);
+      }
+    }
+
+    /**
+     * @brief qu2om Block version of OrientationTransforms::qu2om
+     */
+    static void qu2om(const T* in, size_t inStride, T* out, size_t outStride, size_t count)
+    {
+      T x[k_BlockSize], y[k_BlockSize], z[k_BlockSize], w[k_BlockSize];
+      T om[9][k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = (count - start < k_BlockSize) ? count - start : k_BlockSize;
+        gather4(in + start * inStride, inStride, n, x, y, z, w);
+        for(size_t i = 0; i < n; i++)
+        {
+          T qq = w[i] * w[i] - (x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+          om[0][i] = qq + 2.0 * x[i] * x[i];
+          om[4][i] = qq + 2.0 * y[i] * y[i];
+          om[8][i] = qq + 2.0 * z[i] * z[i];
+          om[1][i] = 2.0 * (x[i] * y[i] - w[i] * z[i]);
+          om[5][i] = 2.0 * (y[i] * z[i] - w[i] * x[i]);
+          om[6][i] = 2.0 * (z[i] * x[i] - w[i] * y[i]);
+          om[3][i] = 2.0 * (y[i] * x[i] + w[i] * z[i]);
+          om[7][i] = 2.0 * (z[i] * y[i] + w[i] * x[i]);
+          om[2][i] = 2.0 * (x[i] * z[i] + w[i] * y[i]);
+        }
+        if(Rotations::Constants::epsijk != 1.0)
+        {
+          for(size_t i = 0; i < n; i++)
+          {
+            std::swap(om[1][i], om[3][i]);
+            std::swap(om[2][i], om[6][i]);
+            std::swap(om[5][i], om[7][i]);
+          }
+        }
+        scatterMatrix(om, n, out + start * outStride, outStride);
+      }
+    }
+
+    /**
+     * @brief qu2eu Block version of OrientationTransforms::qu2eu. Quaternions with a degenerate second Euler
+     * angle (chi == 0) are handed to the per tuple method.
+     */
+    static void qu2eu(const T* in, size_t inStride, T* out, size_t outStride, size_t count)
+    {
+      if(RConst::epsijk != 1.0)
+      {
+        scalar_qu2eu(in, inStride, out, outStride, count);
+        return;
+      }
+
+      T x[k_BlockSize], y[k_BlockSize], z[k_BlockSize], w[k_BlockSize];
+      T eu[3][k_BlockSize];
+      T chis[k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = (count - start < k_BlockSize) ? count - start : k_BlockSize;
+        gather4(in + start * inStride, inStride, n, x, y, z, w);
+        for(size_t i = 0; i < n; i++)
+        {
+          T q03 = w[i] * w[i] + z[i] * z[i];
+          T q12 = x[i] * x[i] + y[i] * y[i];
+          T chi = std::sqrt(q03 * q12);
+          chis[i] = chi;
+          T invChi = (chi == 0.0) ? static_cast<T>(0.0) : static_cast<T>(1.0 / chi);
+          eu[1][i] = std::atan2(2.0 * chi, q03 - q12);
+          eu[0][i] = std::atan2((-w[i] * y[i] + x[i] * z[i]) * invChi, (-w[i] * x[i] - y[i] * z[i]) * invChi);
+          eu[2][i] = std::atan2((w[i] * y[i] + x[i] * z[i]) * invChi, (-w[i] * x[i] + y[i] * z[i]) * invChi);
+        }
+        for(size_t c = 0; c < 3; c++)
+        {
+          const double period = (c == 1) ? DConst::k_Pi : DConst::k_2Pi;
+          for(size_t i = 0; i < n; i++)
+          {
+            if(eu[c][i] < 0.0)
+            {
+              eu[c][i] = std::fmod(eu[c][i] + 100.0 * DConst::k_Pi, period);
+            }
+          }
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          T* res = out + (start + i) * outStride;
+          if(chis[i] == 0.0)
+          {
+            scalar_qu2eu(in + (start + i) * inStride, inStride, res, outStride, 1);
+            continue;
+          }
+          res[0] = eu[0][i];
+          res[1] = eu[1][i];
+          res[2] = eu[2][i];
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // All other conversions apply the per tuple transform
+    // -----------------------------------------------------------------------------
+    OC_BULK_SCALAR_BLOCK(eu2ax)
+    OC_BULK_SCALAR_BLOCK(eu2ro)
+    OC_BULK_SCALAR_BLOCK(eu2ho)
+    OC_BULK_SCALAR_BLOCK(eu2cu)
+
+    OC_BULK_SCALAR_BLOCK(om2eu)
+    OC_BULK_SCALAR_BLOCK(om2qu)
+    OC_BULK_SCALAR_BLOCK(om2ax)
+    OC_BULK_SCALAR_BLOCK(om2ro)
+    OC_BULK_SCALAR_BLOCK(om2ho)
+    OC_BULK_SCALAR_BLOCK(om2cu)
+
+    OC_BULK_SCALAR_BLOCK(qu2ax)
+    OC_BULK_SCALAR_BLOCK(qu2ro)
+    OC_BULK_SCALAR_BLOCK(qu2ho)
+    OC_BULK_SCALAR_BLOCK(qu2cu)
+
+    OC_BULK_SCALAR_BLOCK(ax2eu)
+    OC_BULK_SCALAR_BLOCK(ax2om)
+    OC_BULK_SCALAR_BLOCK(ax2qu)
+    OC_BULK_SCALAR_BLOCK(ax2ro)
+    OC_BULK_SCALAR_BLOCK(ax2ho)
+    OC_BULK_SCALAR_BLOCK(ax2cu)
+
+    OC_BULK_SCALAR_BLOCK(ro2eu)
+    OC_BULK_SCALAR_BLOCK(ro2om)
+    OC_BULK_SCALAR_BLOCK(ro2qu)
+    OC_BULK_SCALAR_BLOCK(ro2ax)
+    OC_BULK_SCALAR_BLOCK(ro2ho)
+    OC_BULK_SCALAR_BLOCK(ro2cu)
+
+    OC_BULK_SCALAR_BLOCK(ho2eu)
+    OC_BULK_SCALAR_BLOCK(ho2om)
+    OC_BULK_SCALAR_BLOCK(ho2qu)
+    OC_BULK_SCALAR_BLOCK(ho2ax)
+    OC_BULK_SCALAR_BLOCK(ho2ro)
+    OC_BULK_SCALAR_BLOCK(ho2cu)
+
+    OC_BULK_SCALAR_BLOCK(cu2eu)
+    OC_BULK_SCALAR_BLOCK(cu2om)
+    OC_BULK_SCALAR_BLOCK(cu2qu)
+    OC_BULK_SCALAR_BLOCK(cu2ax)
+    OC_BULK_SCALAR_BLOCK(cu2ro)
+    OC_BULK_SCALAR_BLOCK(cu2ho)
+
+  protected:
+    OrientationBulkTransforms() {}
+
+  private:
+    /**
+     * @brief The ConvertImpl class runs a block conversion over a range of tuples
+     */
+    class ConvertImpl
+    {
+      public:
+        ConvertImpl(BlockFunction function, const T* in, size_t inStride, T* out, size_t outStride)
+        : m_Function(function)
+        , m_In(in)
+        , m_InStride(inStride)
+        , m_Out(out)
+        , m_OutStride(outStride)
+        {
+        }
+
+        void convert(size_t start, size_t end) const
+        {
+          m_Function(m_In + start * m_InStride, m_InStride, m_Out + start * m_OutStride, m_OutStride, end - start);
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          convert(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        BlockFunction m_Function;
+        const T* m_In;
+        size_t m_InStride;
+        T* m_Out;
+        size_t m_OutStride;
+    };
+
+    static void scalar_qu2eu(const T* in, size_t inStride, T* out, size_t outStride, size_t count)
+    {
+      for(size_t i = 0; i < count; i++)
+      {
+        OrientationArray_t rot(const_cast<T*>(in + i * inStride), inStride);
+        OrientationArray_t res(out + i * outStride, outStride);
+        Transforms_t::qu2eu(rot, res);
+      }
+    }
+
+    static void gather3(const T* in, size_t inStride, size_t n, T* c0, T* c1, T* c2)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        c0[i] = in[i * inStride];
+        c1[i] = in[i * inStride + 1];
+        c2[i] = in[i * inStride + 2];
+      }
+    }
+
+    static void gather4(const T* in, size_t inStride, size_t n, T* c0, T* c1, T* c2, T* c3)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        c0[i] = in[i * inStride];
+        c1[i] = in[i * inStride + 1];
+        c2[i] = in[i * inStride + 2];
+        c3[i] = in[i * inStride + 3];
+      }
+    }
+
+    static void scatterMatrix(T om[9][k_BlockSize], size_t n, T* out, size_t outStride)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        T* res = out + i * outStride;
+        for(size_t c = 0; c < 9; c++)
+        {
+          res[c] = om[c][i];
+        }
+      }
+    }
+
+    OrientationBulkTransforms(const OrientationBulkTransforms&); // Copy Constructor Not Implemented
+    void operator=(const OrientationBulkTransforms&); // Operator '=' Not Implemented
+};
+
+#endif /* _orientationbulktransforms_hpp_ */
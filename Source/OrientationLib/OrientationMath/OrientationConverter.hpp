@@ -48,6 +48,7 @@
 
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBulkTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 template<typename T>
@@ -240,7 +241,6 @@ class OrientationConverter
 };
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
-  typedef OrientationArray<T> OrientationArray_t;\
   typename DataArray<T>::Pointer input = this->getInputData();\
   T* inPtr = input->getPointer(0);\
   size_t nTuples = input->getNumberOfTuples();\
@@ -250,13 +250,8 @@ class OrientationConverter
   typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
   output->initializeWithZeros(); /* Intialize the array with Zeros */ \
   T* OUT_ARRAY_NAME##Ptr = output->getPointer(0);\
-  for (size_t i = 0; i < nTuples; ++i) { \
-    OrientationArray_t rot(inPtr, inStride); \
-    OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
-    OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-    inPtr = inPtr + inStride; /* Increment input pointer */ \
-    OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
-  }\
+  /* Convert all tuples in blocks, in parallel where available */ \
+  OrientationBulkTransforms<T>::Convert(&OrientationBulkTransforms<T>::CONVERSION_METHOD, inPtr, inStride, OUT_ARRAY_NAME##Ptr, outStride, nTuples);\
   this->setOutputData(output);
 
 
@@ -1353,11 +1353,16 @@ class OrientationTransforms
       res[2] = 2.0 * (r[x] * r[z] + r[w] * r[y]);
       if (Rotations::Constants::epsijk != 1.0)
       {
-
-        RotationMatrixMapType resWrap(const_cast<K*>(&(res[0])));
-        resWrap.transpose();
-
-//        res = OMHelperType::transpose(res);
+        // Transpose in place; Eigen's transpose() only returns an expression and would leave res untouched
+        K t = res[1];
+        res[1] = res[3];
+        res[3] = t;
+        t = res[2];
+        res[2] = res[6];
+        res[6] = t;
+        t = res[5];
+        res[5] = res[7];
+        res[7] = t;
       }
     }
 
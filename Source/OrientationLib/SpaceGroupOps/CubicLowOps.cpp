@@ -220,6 +220,24 @@ float CubicLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float
   return _calcMisoQuat(CubicLowQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicLowOps::getMisoQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes)
+{
+  int numsym = 12;
+  _calcMisoQuats(CubicLowQuatSym, numsym, q1, q2, count, angles, axes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicLowOps::getMisoQuatsBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below)
+{
+  int numsym = 12;
+  _calcMisoQuatsBelowTolerance(CubicLowQuatSym, numsym, q1, q2, count, tolerance, below);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -925,52 +943,24 @@ QVector<UInt8ArrayType::Pointer> CubicLowOps::generatePoleFigure(PoleFigureConfi
   if(config.labels.size() > 1) { label1 = config.labels.at(1); }
   if(config.labels.size() > 2) { label2 = config.labels.at(2); }
 
-  int numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
   QVector<size_t> dims(1, 3);
-  FloatArrayType::Pointer xyz001 = FloatArrayType::CreateArray(numOrientations * Detail::CubicLow::symSize0, dims, label0 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <011> Family
-  FloatArrayType::Pointer xyz011 = FloatArrayType::CreateArray(numOrientations * Detail::CubicLow::symSize1, dims, label1 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <111> Family
-  FloatArrayType::Pointer xyz111 = FloatArrayType::CreateArray(numOrientations * Detail::CubicLow::symSize2, dims, label2 + QString("xyzCoords"));
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
   DoubleArrayType::Pointer intensity001 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
+
+  // Generate the coords on the sphere and bin them into the modified Lambert projections block by block **** Parallelized
+  const int symSizes[3] = {Detail::CubicLow::symSize0, Detail::CubicLow::symSize1, Detail::CubicLow::symSize2};
+  DoubleArrayType* intensities[3] = {intensity001.get(), intensity011.get(), intensity111.get()};
+  _generatePoleFigureIntensities(config, symSizes, intensities);
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-  tbb::task_group* g = new tbb::task_group;
-
-  if(doParallel == true)
-  {
-    g->run(GenerateIntensityMapImpl(xyz001.get(), &config, intensity001.get()));
-    g->run(GenerateIntensityMapImpl(xyz011.get(), &config, intensity011.get()));
-    g->run(GenerateIntensityMapImpl(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-    delete g;
-    g = nullptr;
-  }
-  else
+  tbb::task_group* g = nullptr;
 #endif
-  {
-    GenerateIntensityMapImpl m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    GenerateIntensityMapImpl m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    GenerateIntensityMapImpl m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
   double max = std::numeric_limits<double>::min();
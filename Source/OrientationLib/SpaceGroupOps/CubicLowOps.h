@@ -78,6 +78,8 @@ class OrientationLib_EXPORT CubicLowOps : public SpaceGroupOps
     QString getSymmetryName() { return "Cubic-Low m3 (Tetrahedral)"; }
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes = nullptr);
+    virtual void getMisoQuatsBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
@@ -35,6 +35,8 @@
 
 #include "CubicOps.h"
 
+#include <algorithm>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -68,6 +70,32 @@ namespace Detail
     static const int symSize0 = 6;
     static const int symSize1 = 12;
     static const int symSize2 = 8;
+
+    /**
+     * @brief calcMaxCosHalfAngles Computes cos(w / 2) of the smallest misorientation angle w over the 24 cubic
+     * operators for a block of relative rotations. With |x|, |y|, |z|, |w| sorted as a <= b <= c <= d the largest
+     * scalar part over all the operators is max(d, (c + d) / sqrt(2), (a + b + c + d) / 2), which is the same
+     * reduction _calcMisoQuat performs. Only the two largest components are needed, and the min/max network
+     * below has no branches, so the loop vectorizes.
+     */
+    static void calcMaxCosHalfAngles(const float* rx, const float* ry, const float* rz, const float* rw, size_t count, float* cosHalfAngles)
+    {
+      for(size_t j = 0; j < count; j++)
+      {
+        float x = fabsf(rx[j]);
+        float y = fabsf(ry[j]);
+        float z = fabsf(rz[j]);
+        float w = fabsf(rw[j]);
+        float lo1 = std::min(x, y);
+        float hi1 = std::max(x, y);
+        float lo2 = std::min(z, w);
+        float hi2 = std::max(z, w);
+        float d = std::max(hi1, hi2);
+        float c = std::max(std::min(hi1, hi2), std::max(lo1, lo2));
+        float best = std::max(d, (c + d) / SIMPLib::Constants::k_Sqrt2);
+        cosHalfAngles[j] = std::max(best, (x + y + z + w) / 2.0f);
+      }
+    }
   }
 }
 
@@ -302,6 +330,81 @@ float CubicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n
   return _calcMisoQuat(CubicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes)
+{
+  if(nullptr != axes)
+  {
+    int numsym = 24;
+    QuatF qa;
+    QuatF qb;
+    for(size_t i = 0; i < count; i++)
+    {
+      qa = QuaternionMathF::New(q1.x[i], q1.y[i], q1.z[i], q1.w[i]);
+      qb = QuaternionMathF::New(q2.x[i], q2.y[i], q2.z[i], q2.w[i]);
+      angles[i] = _calcMisoQuat(CubicQuatSym, numsym, qa, qb, axes[3 * i], axes[3 * i + 1], axes[3 * i + 2]);
+    }
+    return;
+  }
+
+  float rx[k_MisoBlockSize];
+  float ry[k_MisoBlockSize];
+  float rz[k_MisoBlockSize];
+  float rw[k_MisoBlockSize];
+  float cosHalfAngles[k_MisoBlockSize];
+  for(size_t offset = 0; offset < count; offset += k_MisoBlockSize)
+  {
+    size_t n = (count - offset < k_MisoBlockSize) ? (count - offset) : k_MisoBlockSize;
+    _calcRelativeQuats(q1, q2, offset, n, rx, ry, rz, rw);
+    Detail::CubicHigh::calcMaxCosHalfAngles(rx, ry, rz, rw, n, cosHalfAngles);
+    for(size_t j = 0; j < n; j++)
+    {
+      angles[offset + j] = 2.0f * acosf(cosHalfAngles[j] > 1.0f ? 1.0f : cosHalfAngles[j]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuatsBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below)
+{
+  // The closed form reduction over the cubic operators is cheaper than any early exit, and comparing
+  // against cos(tolerance / 2) skips the acos entirely
+  const float cosHalfTolerance = cosf(tolerance * 0.5f);
+  const float cosAbove = cosHalfTolerance + k_MisoToleranceMargin;
+  const float cosBelow = cosHalfTolerance - k_MisoToleranceMargin;
+
+  float rx[k_MisoBlockSize];
+  float ry[k_MisoBlockSize];
+  float rz[k_MisoBlockSize];
+  float rw[k_MisoBlockSize];
+  float cosHalfAngles[k_MisoBlockSize];
+  for(size_t offset = 0; offset < count; offset += k_MisoBlockSize)
+  {
+    size_t n = (count - offset < k_MisoBlockSize) ? (count - offset) : k_MisoBlockSize;
+    _calcRelativeQuats(q1, q2, offset, n, rx, ry, rz, rw);
+    Detail::CubicHigh::calcMaxCosHalfAngles(rx, ry, rz, rw, n, cosHalfAngles);
+    for(size_t j = 0; j < n; j++)
+    {
+      if(cosHalfAngles[j] > cosAbove)
+      {
+        below[offset + j] = true;
+      }
+      else if(cosHalfAngles[j] < cosBelow)
+      {
+        below[offset + j] = false;
+      }
+      else
+      {
+        below[offset + j] = _isMisoQuatBelowTolerance(q1, q2, offset + j, tolerance);
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1740,52 +1843,24 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   if(config.labels.size() > 1) { label1 = config.labels.at(1); }
   if(config.labels.size() > 2) { label2 = config.labels.at(2); }
 
-  int numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
   QVector<size_t> dims(1, 3);
-  FloatArrayType::Pointer xyz001 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize0, dims, label0 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <011> Family
-  FloatArrayType::Pointer xyz011 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize1, dims, label1 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <111> Family
-  FloatArrayType::Pointer xyz111 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize2, dims, label2 + QString("xyzCoords"));
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
   DoubleArrayType::Pointer intensity001 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
+
+  // Generate the coords on the sphere and bin them into the modified Lambert projections block by block **** Parallelized
+  const int symSizes[3] = {Detail::CubicHigh::symSize0, Detail::CubicHigh::symSize1, Detail::CubicHigh::symSize2};
+  DoubleArrayType* intensities[3] = {intensity001.get(), intensity011.get(), intensity111.get()};
+  _generatePoleFigureIntensities(config, symSizes, intensities);
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-  tbb::task_group* g = new tbb::task_group;
-
-  if(doParallel == true)
-  {
-    g->run(GenerateIntensityMapImpl(xyz001.get(), &config, intensity001.get()));
-    g->run(GenerateIntensityMapImpl(xyz011.get(), &config, intensity011.get()));
-    g->run(GenerateIntensityMapImpl(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-    delete g;
-    g = nullptr;
-  }
-  else
+  tbb::task_group* g = nullptr;
 #endif
-  {
-    GenerateIntensityMapImpl m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    GenerateIntensityMapImpl m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    GenerateIntensityMapImpl m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
   double max = std::numeric_limits<double>::min();
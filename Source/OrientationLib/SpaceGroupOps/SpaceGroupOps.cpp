@@ -43,10 +43,18 @@
 
 #include <QtCore/QDateTime>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
 #include "OrientationLib/SpaceGroupOps/CubicLowOps.h"
@@ -78,8 +86,130 @@ namespace Detail
   const static float CosOfHalf = cosf(0.5f);
   const static float SinOfZero = sinf(0.0f);
   const static float CosOfZero = cosf(0.0f);
+
+  /**
+   * @brief The BinPoleFigureCoordsImpl class bins the sphere coordinates of one block of orientations into modified
+   * Lambert squares. The coordinates of each pole family are cut into one slice per set of squares of that family, and
+   * each slice is only ever added to its own squares, so all the slices can be binned at the same time.
+   */
+  class BinPoleFigureCoordsImpl
+  {
+    public:
+      BinPoleFigureCoordsImpl(FloatArrayType* coords[3], size_t numCoords[3], ModifiedLambertProjection::Pointer* lamberts, size_t numSlices) :
+        m_Lamberts(lamberts),
+        m_NumSlices(numSlices)
+      {
+        for(int f = 0; f < 3; f++)
+        {
+          m_Coords[f] = coords[f];
+          m_NumCoords[f] = numCoords[f];
+        }
+      }
+      virtual ~BinPoleFigureCoordsImpl() {}
+
+      void generate(size_t start, size_t end) const
+      {
+        float sqCoord[2] = {0.0f, 0.0f};
+        for(size_t t = start; t < end; t++)
+        {
+          size_t family = t / m_NumSlices;
+          size_t slice = t % m_NumSlices;
+          size_t first = m_NumCoords[family] * slice / m_NumSlices;
+          size_t last = m_NumCoords[family] * (slice + 1) / m_NumSlices;
+          ModifiedLambertProjection* lambert = m_Lamberts[t].get();
+          float* xyz = m_Coords[family]->getPointer(0);
+          for(size_t i = first; i < last; i++)
+          {
+            sqCoord[0] = 0.0f;
+            sqCoord[1] = 0.0f;
+            if(lambert->getSquareCoord(xyz + i * 3, sqCoord) == true)
+            {
+              lambert->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+            }
+            else
+            {
+              lambert->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+            }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        generate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      FloatArrayType* m_Coords[3];
+      size_t m_NumCoords[3];
+      ModifiedLambertProjection::Pointer* m_Lamberts;
+      size_t m_NumSlices;
+  };
+
+  /**
+   * @brief The ReducePoleFigureLambertsImpl class sums the modified Lambert squares of all the slices of a pole family
+   * and turns the result into the stereographic intensity image of that family.
+   */
+  class ReducePoleFigureLambertsImpl
+  {
+    public:
+      ReducePoleFigureLambertsImpl(ModifiedLambertProjection::Pointer* lamberts, size_t numSlices, PoleFigureConfiguration_t* config, DoubleArrayType* intensities[3]) :
+        m_Lamberts(lamberts),
+        m_NumSlices(numSlices),
+        m_Config(config)
+      {
+        for(int f = 0; f < 3; f++)
+        {
+          m_Intensities[f] = intensities[f];
+        }
+      }
+      virtual ~ReducePoleFigureLambertsImpl() {}
+
+      void generate(size_t start, size_t end) const
+      {
+        for(size_t family = start; family < end; family++)
+        {
+          ModifiedLambertProjection* total = m_Lamberts[family * m_NumSlices].get();
+          double* north = total->getNorthSquare()->getPointer(0);
+          double* south = total->getSouthSquare()->getPointer(0);
+          size_t numBins = total->getNorthSquare()->getNumberOfTuples();
+          for(size_t slice = 1; slice < m_NumSlices; slice++)
+          {
+            double* sliceNorth = m_Lamberts[family * m_NumSlices + slice]->getNorthSquare()->getPointer(0);
+            double* sliceSouth = m_Lamberts[family * m_NumSlices + slice]->getSouthSquare()->getPointer(0);
+            for(size_t i = 0; i < numBins; i++)
+            {
+              north[i] += sliceNorth[i];
+              south[i] += sliceSouth[i];
+            }
+          }
+          total->normalizeSquaresToMRD();
+          m_Intensities[family]->resize(m_Config->imageDim * m_Config->imageDim);
+          total->createStereographicProjection(m_Config->imageDim, m_Intensities[family]);
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        generate(r.begin(), r.end());
+      }
+#endif
+
+    private:
+      ModifiedLambertProjection::Pointer* m_Lamberts;
+      size_t m_NumSlices;
+      PoleFigureConfiguration_t* m_Config;
+      DoubleArrayType* m_Intensities[3];
+  };
 }
 
+// The batched kernels and getMisoQuat round differently by a few float ulps of cos(angle / 2); this margin is
+// well above that, and only pairs within it of the tolerance take the slower getMisoQuat path
+const float SpaceGroupOps::k_MisoToleranceMargin = 1.0e-5f;
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -163,6 +293,145 @@ float SpaceGroupOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
   return wmin;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpaceGroupOps::_calcRelativeQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t offset, size_t count, float* rx, float* ry, float* rz, float* rw)
+{
+  QuatF qa;
+  QuatF qb;
+  QuatF q2inv;
+  QuatF qr;
+  for(size_t j = 0; j < count; j++)
+  {
+    size_t i = offset + j;
+    qa = QuaternionMathF::New(q1.x[i], q1.y[i], q1.z[i], q1.w[i]);
+    qb = QuaternionMathF::New(q2.x[i], q2.y[i], q2.z[i], q2.w[i]);
+    QuaternionMathF::Conjugate(qb, q2inv);
+    QuaternionMathF::Multiply(qa, q2inv, qr);
+    rx[j] = qr.x;
+    ry[j] = qr.y;
+    rz[j] = qr.z;
+    rw[j] = qr.w;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpaceGroupOps::_calcMisoQuats(const QuatF* quatsym, int numsym, const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes)
+{
+  if(nullptr != axes)
+  {
+    QuatF qa;
+    QuatF qb;
+    for(size_t i = 0; i < count; i++)
+    {
+      qa = QuaternionMathF::New(q1.x[i], q1.y[i], q1.z[i], q1.w[i]);
+      qb = QuaternionMathF::New(q2.x[i], q2.y[i], q2.z[i], q2.w[i]);
+      angles[i] = _calcMisoQuat(quatsym, numsym, qa, qb, axes[3 * i], axes[3 * i + 1], axes[3 * i + 2]);
+    }
+    return;
+  }
+
+  float rx[k_MisoBlockSize];
+  float ry[k_MisoBlockSize];
+  float rz[k_MisoBlockSize];
+  float rw[k_MisoBlockSize];
+  float best[k_MisoBlockSize];
+
+  for(size_t offset = 0; offset < count; offset += k_MisoBlockSize)
+  {
+    size_t n = (count - offset < k_MisoBlockSize) ? (count - offset) : k_MisoBlockSize;
+    _calcRelativeQuats(q1, q2, offset, n, rx, ry, rz, rw);
+    for(size_t j = 0; j < n; j++)
+    {
+      best[j] = 0.0f;
+    }
+    // The rotation angle of quatsym[i] * qr is 2 * acos(|w|), so the smallest angle over all the symmetry
+    // operators belongs to the largest |w|. Only the scalar part of each product has to be computed.
+    for(int i = 0; i < numsym; i++)
+    {
+      const float sx = quatsym[i].x;
+      const float sy = quatsym[i].y;
+      const float sz = quatsym[i].z;
+      const float sw = quatsym[i].w;
+      for(size_t j = 0; j < n; j++)
+      {
+        float c = fabsf(sw * rw[j] - sx * rx[j] - sy * ry[j] - sz * rz[j]);
+        best[j] = (c > best[j]) ? c : best[j];
+      }
+    }
+    for(size_t j = 0; j < n; j++)
+    {
+      angles[offset + j] = 2.0f * acosf(best[j] > 1.0f ? 1.0f : best[j]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpaceGroupOps::_calcMisoQuatsBelowTolerance(const QuatF* quatsym, int numsym, const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below)
+{
+  // angle < tolerance is equivalent to |w| > cos(tolerance / 2) for the scalar part w of the symmetric product
+  const float cosHalfTolerance = cosf(tolerance * 0.5f);
+  const float cosAbove = cosHalfTolerance + k_MisoToleranceMargin;
+  const float cosBelow = cosHalfTolerance - k_MisoToleranceMargin;
+
+  float rx[k_MisoBlockSize];
+  float ry[k_MisoBlockSize];
+  float rz[k_MisoBlockSize];
+  float rw[k_MisoBlockSize];
+
+  for(size_t offset = 0; offset < count; offset += k_MisoBlockSize)
+  {
+    size_t n = (count - offset < k_MisoBlockSize) ? (count - offset) : k_MisoBlockSize;
+    _calcRelativeQuats(q1, q2, offset, n, rx, ry, rz, rw);
+    for(size_t j = 0; j < n; j++)
+    {
+      bool found = false;
+      float best = 0.0f;
+      for(int i = 0; i < numsym; i++)
+      {
+        float c = fabsf(quatsym[i].w * rw[j] - quatsym[i].x * rx[j] - quatsym[i].y * ry[j] - quatsym[i].z * rz[j]);
+        if(c > cosAbove)
+        {
+          found = true;
+          break;
+        }
+        if(c > best)
+        {
+          best = c;
+        }
+      }
+      if(found == true)
+      {
+        below[offset + j] = true;
+      }
+      else if(best < cosBelow)
+      {
+        below[offset + j] = false;
+      }
+      else
+      {
+        below[offset + j] = _isMisoQuatBelowTolerance(q1, q2, offset + j, tolerance);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SpaceGroupOps::_isMisoQuatBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t index, float tolerance)
+{
+  QuatF qa = QuaternionMathF::New(q1.x[index], q1.y[index], q1.z[index], q1.w[index]);
+  QuatF qb = QuaternionMathF::New(q2.x[index], q2.y[index], q2.z[index], q2.w[index]);
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+  return (getMisoQuat(qa, qb, n1, n2, n3) < tolerance);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -433,3 +702,72 @@ size_t SpaceGroupOps::getRandomSymmetryOperatorIndex(int numSymOps)
   size_t symOp = numberGenerator(); // Random remaining position.
   return symOp;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpaceGroupOps::_generatePoleFigureIntensities(PoleFigureConfiguration_t& config, const int symSizes[3], DoubleArrayType* intensities[3])
+{
+  size_t numOrientations = config.eulers->getNumberOfTuples();
+  size_t numSlices = 1;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlices = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  // The coordinate buffers only ever hold one block of orientations
+  size_t blockSize = (numOrientations < k_PoleFigureBlockSize) ? numOrientations : static_cast<size_t>(k_PoleFigureBlockSize);
+  QVector<size_t> cDims(1, 3);
+  FloatArrayType::Pointer coordArrays[3];
+  FloatArrayType* coords[3] = {nullptr, nullptr, nullptr};
+  size_t numCoords[3] = {0, 0, 0};
+  for(int f = 0; f < 3; f++)
+  {
+    coordArrays[f] = FloatArrayType::CreateArray(blockSize * symSizes[f], cDims, "_INTERNAL_USE_ONLY_PoleFigureCoords");
+    coords[f] = coordArrays[f].get();
+  }
+
+  std::vector<ModifiedLambertProjection::Pointer> lamberts(3 * numSlices);
+  for(size_t i = 0; i < lamberts.size(); i++)
+  {
+    lamberts[i] = ModifiedLambertProjection::New();
+    lamberts[i]->initializeSquares(config.lambertDim, config.sphereRadius);
+  }
+
+  for(size_t start = 0; start < numOrientations; start += blockSize)
+  {
+    size_t count = (numOrientations - start < blockSize) ? (numOrientations - start) : blockSize;
+    FloatArrayType::Pointer blockEulers = FloatArrayType::WrapPointer(config.eulers->getPointer(start * 3), count, cDims, "_INTERNAL_USE_ONLY_PoleFigureEulers", false);
+    generateSphereCoordsFromEulers(blockEulers.get(), coords[0], coords[1], coords[2]);
+    for(int f = 0; f < 3; f++)
+    {
+      numCoords[f] = count * symSizes[f];
+    }
+
+    Detail::BinPoleFigureCoordsImpl binner(coords, numCoords, lamberts.data(), numSlices);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, lamberts.size(), 1), binner, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      binner.generate(0, lamberts.size());
+    }
+  }
+
+  Detail::ReducePoleFigureLambertsImpl reducer(lamberts.data(), numSlices, &config, intensities);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, 3, 1), reducer, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    reducer.generate(0, 3);
+  }
+}
@@ -54,6 +54,18 @@
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
 
+/**
+ * @brief The QuatSoA_t struct points at a batch of quaternions stored as a structure of arrays, one
+ * contiguous array per quaternion component. This is the input layout of the batched misorientation methods.
+ */
+typedef struct
+{
+  const float* x;
+  const float* y;
+  const float* z;
+  const float* w;
+} QuatSoA_t;
+
 /*
  * @class SpaceGroupOps SpaceGroupOps.h DREAM3DLib/Common/SpaceGroupOps.h
  * @brief This class performs Crystallographic Misorientation Calculations
@@ -122,6 +134,31 @@ class OrientationLib_EXPORT SpaceGroupOps
      */
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3) = 0;
 
+    /**
+     * @brief getMisoQuats Batched form of getMisoQuat that computes the misorientation of count quaternion pairs
+     * with a single virtual call
+     * @param q1 First quaternion of each pair
+     * @param q2 Second quaternion of each pair
+     * @param count Number of pairs
+     * @param angles [output] Misorientation angle (radians) of each pair
+     * @param axes [output] Optional array of 3 * count values that receives the misorientation axis of each pair.
+     * Pass nullptr when only the angles are needed, which allows the faster angle only kernel to be used
+     */
+    virtual void getMisoQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes = nullptr) = 0;
+
+    /**
+     * @brief getMisoQuatsBelowTolerance Batched threshold test equivalent to getMisoQuat(q1, q2, ...) < tolerance. The
+     * search over the symmetry operators stops as soon as one operator brings a pair within the tolerance, so the
+     * minimum angle itself is never computed. Pairs whose rotation is too close to the tolerance for the batched
+     * rounding to decide are passed to getMisoQuat, so the result matches it exactly
+     * @param q1 First quaternion of each pair
+     * @param q2 Second quaternion of each pair
+     * @param count Number of pairs
+     * @param tolerance Misorientation tolerance (radians)
+     * @param below [output] True for each pair whose misorientation is below the tolerance
+     */
+    virtual void getMisoQuatsBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below) = 0;
+
     /**
      * @brief getQuatSymOp Copies the symmetry operator at index i into q
      * @param i The index into the Symmetry operators array
@@ -209,6 +246,33 @@ class OrientationLib_EXPORT SpaceGroupOps
                         QuatF& q1, QuatF& q2,
                         float& n1, float& n2, float& n3);
 
+    /**
+     * @brief _calcMisoQuats Generic batched misorientation kernel. The pairs are processed in blocks; for each symmetry
+     * operator only the scalar part of the product with the pair's relative rotation is needed, which the compiler
+     * vectorizes across the pairs of a block. When axes are requested every pair goes through _calcMisoQuat instead.
+     */
+    void _calcMisoQuats(const QuatF* quatsym, int numsym, const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float* angles, float* axes);
+
+    /**
+     * @brief _calcMisoQuatsBelowTolerance Generic batched threshold kernel with an early exit over the symmetry operators
+     */
+    void _calcMisoQuatsBelowTolerance(const QuatF* quatsym, int numsym, const QuatSoA_t& q1, const QuatSoA_t& q2, size_t count, float tolerance, bool* below);
+
+    /**
+     * @brief _isMisoQuatBelowTolerance Tests pair index of q1 and q2 with getMisoQuat. The batched threshold kernels
+     * call this for the pairs whose cos(angle / 2) lies within k_MisoToleranceMargin of cos(tolerance / 2)
+     */
+    bool _isMisoQuatBelowTolerance(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t index, float tolerance);
+
+    /**
+     * @brief _calcRelativeQuats Fills the relative rotation q1 * conjugate(q2) of count pairs, starting at offset, into
+     * the structure of array buffers rx, ry, rz and rw
+     */
+    void _calcRelativeQuats(const QuatSoA_t& q1, const QuatSoA_t& q2, size_t offset, size_t count, float* rx, float* ry, float* rz, float* rw);
+
+    static const size_t k_MisoBlockSize = 256;
+    static const float k_MisoToleranceMargin;
+
     FOrientArrayType _calcRodNearestOrigin(const float rodsym[24][3], int numsym, FOrientArrayType rod);
     void _calcNearestQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2);
     void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
@@ -217,6 +281,20 @@ class OrientationLib_EXPORT SpaceGroupOps
     void _calcDetermineHomochoricValues(uint64_t seed, float init[3], float step[3], int32_t phi[3], int choose, float& r1, float& r2, float& r3);
     int _calcODFBin(float dim[3], float bins[3], float step[3], FOrientArrayType homochoric);
 
+    /**
+     * @brief _generatePoleFigureIntensities Fills the stereographic intensity image of each of the 3 pole families of a
+     * pole figure. The orientations are passed through generateSphereCoordsFromEulers() in blocks of k_PoleFigureBlockSize
+     * and the directions of each block are binned straight into modified Lambert squares. The directions of a family are
+     * split into one slice per thread and every slice has its own squares, which are summed once all the blocks have been
+     * binned, so the memory used does not grow with the number of orientations.
+     * @param config The pole figure configuration
+     * @param symSizes Number of directions each orientation adds to each pole family
+     * @param intensities [output] The intensity image of each pole family
+     */
+    void _generatePoleFigureIntensities(PoleFigureConfiguration_t& config, const int symSizes[3], DoubleArrayType* intensities[3]);
+
+    static const size_t k_PoleFigureBlockSize = 16384;
+
   private:
     SpaceGroupOps(const SpaceGroupOps&); // Copy Constructor Not Implemented
     void operator=(const SpaceGroupOps&); // Operator '=' Not Implemented
@@ -0,0 +1,328 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/Utilities/NeighborMisorientationMask.hpp"
+
+class NeighborMisorientationMaskTest
+{
+  public:
+    NeighborMisorientationMaskTest()
+    : m_OrientationOps(SpaceGroupOps::getOrientationOpsQVector())
+    , m_Tolerance(5.0f * SIMPLib::Constants::k_PiOver180)
+    {
+      // Phase 0 has no crystal structure. Phases 1 and 2 share one so only the phase check tells them apart.
+      m_CrystalStructures[0] = Ebsd::CrystalStructure::UnknownCrystalStructure;
+      m_CrystalStructures[1] = Ebsd::CrystalStructure::Cubic_High;
+      m_CrystalStructures[2] = Ebsd::CrystalStructure::Cubic_High;
+    }
+    virtual ~NeighborMisorientationMaskTest(){}
+
+    // -----------------------------------------------------------------------------
+    // Fills the Cells with small random perturbations of two orientations, so that neighbors are sometimes
+    // within the tolerance and sometimes not, and with random phases
+    // -----------------------------------------------------------------------------
+    void generateCells(std::mt19937& generator, std::vector<QuatF>& quats, std::vector<int32_t>& phases)
+    {
+      std::normal_distribution<float> distribution(0.0f, 1.0f);
+      std::uniform_int_distribution<int32_t> phaseDistribution(0, 6);
+      const float bases[2][4] = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.3f, -0.5f, 0.1f, 0.8f}};
+      for(size_t i = 0; i < quats.size(); i++)
+      {
+        const float* base = bases[generator() % 2];
+        float q[4];
+        float mag = 0.0f;
+        for(int32_t c = 0; c < 4; c++)
+        {
+          q[c] = base[c] + 0.015f * distribution(generator);
+          mag += q[c] * q[c];
+        }
+        mag = sqrtf(mag);
+        quats[i] = QuaternionMathF::New(q[0] / mag, q[1] / mag, q[2] / mag, q[3] / mag);
+        // Mostly phase 1, with a few Cells of phase 2 and a few without a phase
+        int32_t phase = phaseDistribution(generator);
+        phases[i] = (phase == 0) ? 0 : ((phase == 1) ? 2 : 1);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The test the mask caches, done directly on the Cell data
+    // -----------------------------------------------------------------------------
+    bool directTest(std::vector<QuatF>& quats, const std::vector<int32_t>& phases, size_t point1, size_t point2)
+    {
+      int32_t phase = phases[point1];
+      if(phase <= 0 || phase != phases[point2])
+      {
+        return false;
+      }
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      float w = m_OrientationOps[m_CrystalStructures[phase]]->getMisoQuat(quats[point1], quats[point2], n1, n2, n3);
+      return (w < m_Tolerance);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns true if the Cells are separated by one of the offsets, in either order
+    // -----------------------------------------------------------------------------
+    bool isNeighborPair(const size_t dims[3], const std::vector<int32_t>& offsets, size_t point1, size_t point2)
+    {
+      int64_t p1[3] = {static_cast<int64_t>(point1 % dims[0]), static_cast<int64_t>((point1 / dims[0]) % dims[1]), static_cast<int64_t>(point1 / (dims[0] * dims[1]))};
+      int64_t p2[3] = {static_cast<int64_t>(point2 % dims[0]), static_cast<int64_t>((point2 / dims[0]) % dims[1]), static_cast<int64_t>(point2 / (dims[0] * dims[1]))};
+      for(size_t o = 0; o < offsets.size() / 3; o++)
+      {
+        bool forward = true;
+        bool backward = true;
+        for(size_t d = 0; d < 3; d++)
+        {
+          forward = forward && (p1[d] + offsets[3 * o + d] == p2[d]);
+          backward = backward && (p2[d] + offsets[3 * o + d] == p1[d]);
+        }
+        if(forward == true || backward == true)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Checks every pair of Cells against the direct test and returns the number of pairs within tolerance
+    // -----------------------------------------------------------------------------
+    size_t checkMask(const NeighborMisorientationMask& mask, const size_t dims[3], const std::vector<int32_t>& offsets, std::vector<QuatF>& quats,
+                     const std::vector<int32_t>& phases)
+    {
+      size_t numPairs = 0;
+      size_t totalPoints = quats.size();
+      for(size_t point1 = 0; point1 < totalPoints; point1++)
+      {
+        for(size_t point2 = 0; point2 < totalPoints; point2++)
+        {
+          bool expected = false;
+          if(point1 != point2 && isNeighborPair(dims, offsets, point1, point2) == true)
+          {
+            expected = directTest(quats, phases, point1, point2);
+          }
+          DREAM3D_REQUIRE_EQUAL(mask.isWithinTolerance(static_cast<int64_t>(point1), static_cast<int64_t>(point2)), expected)
+          if(expected == true)
+          {
+            numPairs++;
+          }
+        }
+      }
+      return numPairs;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestCompute()
+    {
+      std::mt19937 generator(1234);
+      // A width of 3 makes the (2, 0, 0) and (-1, 1, 0) pair offsets share a stride
+      const size_t allDims[4][3] = {{3, 4, 5}, {4, 3, 3}, {1, 5, 4}, {5, 2, 1}};
+      std::vector<int32_t> faceOffsets = NeighborMisorientationMask::FaceOffsets();
+      std::vector<int32_t> pairOffsets = NeighborMisorientationMask::FaceNeighborPairOffsets();
+      DREAM3D_REQUIRE_EQUAL(faceOffsets.size(), 9)
+      DREAM3D_REQUIRE_EQUAL(pairOffsets.size(), 27)
+
+      for(size_t i = 0; i < 4; i++)
+      {
+        const size_t* dims = allDims[i];
+        size_t totalPoints = dims[0] * dims[1] * dims[2];
+        std::vector<QuatF> quats(totalPoints);
+        std::vector<int32_t> phases(totalPoints);
+        generateCells(generator, quats, phases);
+
+        NeighborMisorientationMask faceMask(dims, faceOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+        NeighborMisorientationMask pairMask(dims, pairOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+        faceMask.compute();
+        pairMask.compute();
+        size_t numFacePairs = checkMask(faceMask, dims, faceOffsets, quats, phases);
+        size_t numPairPairs = checkMask(pairMask, dims, pairOffsets, quats, phases);
+        DREAM3D_REQUIRED(numFacePairs, >, 0)
+        DREAM3D_REQUIRED(numPairPairs, >, 0)
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // With a width of 3 every stride of 2 is either (2, 0, 0) or (-1, 1, 0), except where (-1, 1, 0) would leave
+    // the geometry through the last row of a plane
+    // -----------------------------------------------------------------------------
+    void TestStrideAliasing()
+    {
+      const size_t dims[3] = {3, 2, 2};
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      std::vector<QuatF> quats(totalPoints, QuaternionMathF::New(0.0f, 0.0f, 0.0f, 1.0f));
+      std::vector<int32_t> phases(totalPoints, 1);
+      NeighborMisorientationMask pairMask(dims, NeighborMisorientationMask::FaceNeighborPairOffsets(), quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps,
+                                          m_Tolerance);
+      pairMask.compute();
+
+      // Stride 2 as (2, 0, 0) from x = 0 and as (-1, 1, 0) from x = 1 and x = 2
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(0, 2) == true)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(3, 5) == true)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(1, 3) == true)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(2, 4) == true)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(4, 2) == true)
+      // Stride 2 as (-1, -1, 1) from the last row of the first plane, which is not a pair offset
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(4, 6) == false)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(5, 7) == false)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(7, 5) == false)
+      checkMask(pairMask, dims, NeighborMisorientationMask::FaceNeighborPairOffsets(), quats, phases);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestUpdate()
+    {
+      std::mt19937 generator(5489u);
+      const size_t dims[3] = {3, 5, 4};
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      std::vector<QuatF> quats(totalPoints);
+      std::vector<int32_t> phases(totalPoints);
+      generateCells(generator, quats, phases);
+      std::vector<int32_t> faceOffsets = NeighborMisorientationMask::FaceOffsets();
+      std::vector<int32_t> pairOffsets = NeighborMisorientationMask::FaceNeighborPairOffsets();
+
+      NeighborMisorientationMask faceMask(dims, faceOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+      NeighborMisorientationMask pairMask(dims, pairOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+      faceMask.compute();
+      pairMask.compute();
+
+      std::uniform_int_distribution<size_t> pointDistribution(0, totalPoints - 1);
+      for(size_t round = 0; round < 5; round++)
+      {
+        // Copy the phase and orientation of random Cells into a few others, the way the cleanup filters do
+        std::vector<uint8_t> changed(totalPoints, 0);
+        for(size_t i = 0; i < 6; i++)
+        {
+          size_t point = pointDistribution(generator);
+          size_t source = pointDistribution(generator);
+          quats[point] = quats[source];
+          phases[point] = phases[source];
+          changed[point] = 1;
+        }
+        faceMask.update(changed);
+        pairMask.update(changed);
+
+        NeighborMisorientationMask freshFaceMask(dims, faceOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+        NeighborMisorientationMask freshPairMask(dims, pairOffsets, quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+        freshFaceMask.compute();
+        freshPairMask.compute();
+        for(int64_t point1 = 0; point1 < static_cast<int64_t>(totalPoints); point1++)
+        {
+          for(int64_t point2 = 0; point2 < static_cast<int64_t>(totalPoints); point2++)
+          {
+            DREAM3D_REQUIRE_EQUAL(faceMask.isWithinTolerance(point1, point2), freshFaceMask.isWithinTolerance(point1, point2))
+            DREAM3D_REQUIRE_EQUAL(pairMask.isWithinTolerance(point1, point2), freshPairMask.isWithinTolerance(point1, point2))
+          }
+        }
+        checkMask(faceMask, dims, faceOffsets, quats, phases);
+        checkMask(pairMask, dims, pairOffsets, quats, phases);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestPhases()
+    {
+      // Identical orientations everywhere, with the phase alternating along x and a Cell without a phase
+      const size_t dims[3] = {4, 3, 2};
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      std::vector<QuatF> quats(totalPoints, QuaternionMathF::New(0.1f, 0.2f, 0.3f, sqrtf(0.86f)));
+      std::vector<int32_t> phases(totalPoints);
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        phases[i] = static_cast<int32_t>(i % 2) + 1;
+      }
+      phases[5] = 0;
+      phases[7] = 0;
+
+      NeighborMisorientationMask faceMask(dims, NeighborMisorientationMask::FaceOffsets(), quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps, m_Tolerance);
+      NeighborMisorientationMask pairMask(dims, NeighborMisorientationMask::FaceNeighborPairOffsets(), quats.data(), phases.data(), m_CrystalStructures, m_OrientationOps,
+                                          m_Tolerance);
+      faceMask.compute();
+      pairMask.compute();
+      for(int64_t point1 = 0; point1 < static_cast<int64_t>(totalPoints); point1++)
+      {
+        for(int64_t point2 = 0; point2 < static_cast<int64_t>(totalPoints); point2++)
+        {
+          if(phases[point1] != phases[point2] || phases[point1] == 0)
+          {
+            DREAM3D_REQUIRE(faceMask.isWithinTolerance(point1, point2) == false)
+            DREAM3D_REQUIRE(pairMask.isWithinTolerance(point1, point2) == false)
+          }
+        }
+      }
+      // Same phase along y and z, and two apart along x
+      DREAM3D_REQUIRE(faceMask.isWithinTolerance(0, 4) == true)
+      DREAM3D_REQUIRE(faceMask.isWithinTolerance(0, 12) == true)
+      DREAM3D_REQUIRE(pairMask.isWithinTolerance(0, 2) == true)
+      DREAM3D_REQUIRE(faceMask.isWithinTolerance(0, 1) == false)
+      DREAM3D_REQUIRE(faceMask.isWithinTolerance(1, 5) == false)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = 0;
+      DREAM3D_REGISTER_TEST( TestCompute() );
+      DREAM3D_REGISTER_TEST( TestStrideAliasing() );
+      DREAM3D_REGISTER_TEST( TestUpdate() );
+      DREAM3D_REGISTER_TEST( TestPhases() );
+    }
+
+  private:
+    QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+    uint32_t m_CrystalStructures[3];
+    float m_Tolerance;
+
+    NeighborMisorientationMaskTest(const NeighborMisorientationMaskTest&); // Copy Constructor Not Implemented
+    void operator=(const NeighborMisorientationMaskTest&); // Operator '=' Not Implemented
+};
@@ -189,11 +189,74 @@ class OrientationConverterTest
 
     }
 
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    template<typename T>
+    void TestBulkConversion()
+    {
+      typedef OrientationArray<T> OrientationArray_t;
+      typedef OrientationTransforms<OrientationArray_t, T> OrientationTransformType;
+
+      // Enough tuples to span several blocks, including a partial one, and the degenerate Phi = 0 and Phi = Pi cases
+      size_t nTuples = 3 * OrientationBulkTransforms<T>::k_BlockSize + 17;
+      QVector<size_t> cDims(1, 3);
+      typename DataArray<T>::Pointer eulers = DataArray<T>::CreateArray(nTuples, cDims, "Eulers");
+      for(size_t i = 0; i < nTuples; i++)
+      {
+        T phi = static_cast<T>((i % 37) * SIMPLib::Constants::k_Pi / 36.0);
+        eulers->setComponent(i, 0, static_cast<T>((i % 53) * SIMPLib::Constants::k_2Pi / 53.0));
+        eulers->setComponent(i, 1, phi);
+        eulers->setComponent(i, 2, static_cast<T>((i % 71) * SIMPLib::Constants::k_2Pi / 71.0));
+      }
+      T epsilon = static_cast<T>(1.0E-5);
+
+      // Eulers to Quaternions and Orientation Matrices
+      typename OrientationConverter<T>::Pointer ocEulers = EulerConverter<T>::New();
+      ocEulers->setInputData(eulers);
+      ocEulers->convertRepresentationTo(OrientationConverter<T>::Quaternion);
+      typename DataArray<T>::Pointer quats = ocEulers->getOutputData();
+      ocEulers->convertRepresentationTo(OrientationConverter<T>::OrientationMatrix);
+      typename DataArray<T>::Pointer matrices = ocEulers->getOutputData();
+
+      typename OrientationConverter<T>::Pointer ocQuats = QuaternionConverter<T>::New();
+      typename OrientationConverter<T>::Pointer ocMatrices = OrientationMatrixConverter<T>::New();
+      for(size_t i = 0; i < nTuples; i++)
+      {
+        OrientationArray_t eu(eulers->getPointer(i * 3), 3);
+        OrientationArray_t qu(4);
+        OrientationTransformType::eu2qu(eu, qu);
+        DREAM3D_REQUIRE(ocQuats->compareRepresentations(quats->getPointer(i * 4), qu.data(), epsilon) == true);
+        OrientationArray_t om(9);
+        OrientationTransformType::eu2om(eu, om);
+        DREAM3D_REQUIRE(ocMatrices->compareRepresentations(matrices->getPointer(i * 9), om.data(), epsilon) == true);
+      }
+
+      // Quaternions back to Eulers and Orientation Matrices
+      ocQuats->setInputData(quats);
+      ocQuats->convertRepresentationTo(OrientationConverter<T>::Euler);
+      typename DataArray<T>::Pointer quatEulers = ocQuats->getOutputData();
+      ocQuats->convertRepresentationTo(OrientationConverter<T>::OrientationMatrix);
+      typename DataArray<T>::Pointer quatMatrices = ocQuats->getOutputData();
+      for(size_t i = 0; i < nTuples; i++)
+      {
+        OrientationArray_t qu(quats->getPointer(i * 4), 4);
+        OrientationArray_t eu(3);
+        OrientationTransformType::qu2eu(qu, eu);
+        DREAM3D_REQUIRE(ocEulers->compareRepresentations(quatEulers->getPointer(i * 3), eu.data(), epsilon) == true);
+        OrientationArray_t om(9);
+        OrientationTransformType::qu2om(qu, om);
+        DREAM3D_REQUIRE(ocMatrices->compareRepresentations(quatMatrices->getPointer(i * 9), om.data(), epsilon) == true);
+      }
+    }
+
     void operator()()
     {
       int err = 0;
       DREAM3D_REGISTER_TEST( TestEulerConversion() );
       DREAM3D_REGISTER_TEST( TestFilterDesign() );
+      DREAM3D_REGISTER_TEST( TestBulkConversion<float>() );
+      DREAM3D_REGISTER_TEST( TestBulkConversion<double>() );
     }
 
   private:
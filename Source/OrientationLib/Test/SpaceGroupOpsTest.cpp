@@ -0,0 +1,156 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+class SpaceGroupOpsTest
+{
+  public:
+    SpaceGroupOpsTest(){}
+    virtual ~SpaceGroupOpsTest(){}
+
+    static const size_t k_NumPairs = 1000;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      // QFile::remove();
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    // Fills four component arrays with random unit quaternions
+    // -----------------------------------------------------------------------------
+    void generateQuats(std::mt19937& generator, std::vector<float>& x, std::vector<float>& y, std::vector<float>& z, std::vector<float>& w)
+    {
+      std::normal_distribution<float> distribution(0.0f, 1.0f);
+      for(size_t i = 0; i < x.size(); i++)
+      {
+        float q[4] = {distribution(generator), distribution(generator), distribution(generator), distribution(generator)};
+        float mag = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        x[i] = q[0] / mag;
+        y[i] = q[1] / mag;
+        z[i] = q[2] / mag;
+        w[i] = q[3] / mag;
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestBatchedMisorientation()
+    {
+      std::mt19937 generator(5489u);
+      std::vector<float> x1(k_NumPairs), y1(k_NumPairs), z1(k_NumPairs), w1(k_NumPairs);
+      std::vector<float> x2(k_NumPairs), y2(k_NumPairs), z2(k_NumPairs), w2(k_NumPairs);
+      generateQuats(generator, x1, y1, z1, w1);
+      generateQuats(generator, x2, y2, z2, w2);
+      // Make some of the pairs nearly identical so the threshold test sees both outcomes
+      for(size_t i = 0; i < k_NumPairs; i += 3)
+      {
+        x2[i] = x1[i] + 0.01f;
+        y2[i] = y1[i];
+        z2[i] = z1[i];
+        w2[i] = w1[i];
+      }
+      // and rotate some others by very nearly the tolerance, so the pairs that the threshold test passes on to
+      // getMisoQuat are covered too
+      const float tolerance = 5.0f * SIMPLib::Constants::k_PiOver180;
+      std::uniform_real_distribution<float> nearTolerance(0.99f, 1.01f);
+      for(size_t i = 1; i < k_NumPairs; i += 6)
+      {
+        float halfAngle = 0.5f * tolerance * nearTolerance(generator);
+        QuatF qa = QuaternionMathF::New(x1[i], y1[i], z1[i], w1[i]);
+        QuatF rotation = QuaternionMathF::New(sinf(halfAngle), 0.0f, 0.0f, cosf(halfAngle));
+        QuatF qb = QuaternionMathF::New();
+        QuaternionMathF::Multiply(qa, rotation, qb);
+        x2[i] = qb.x;
+        y2[i] = qb.y;
+        z2[i] = qb.z;
+        w2[i] = qb.w;
+      }
+
+      QuatSoA_t q1 = {x1.data(), y1.data(), z1.data(), w1.data()};
+      QuatSoA_t q2 = {x2.data(), y2.data(), z2.data(), w2.data()};
+      std::vector<float> angles(k_NumPairs, 0.0f);
+      std::vector<float> axesAngles(k_NumPairs, 0.0f);
+      std::vector<float> axes(k_NumPairs * 3, 0.0f);
+      std::vector<bool> expectedBelow(k_NumPairs, false);
+      bool* below = new bool[k_NumPairs];
+
+      std::vector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsVector();
+      for(size_t op = 0; op < ops.size(); op++)
+      {
+        ops[op]->getMisoQuats(q1, q2, k_NumPairs, angles.data());
+        ops[op]->getMisoQuats(q1, q2, k_NumPairs, axesAngles.data(), axes.data());
+        ops[op]->getMisoQuatsBelowTolerance(q1, q2, k_NumPairs, tolerance, below);
+        for(size_t i = 0; i < k_NumPairs; i++)
+        {
+          QuatF qa = QuaternionMathF::New(x1[i], y1[i], z1[i], w1[i]);
+          QuatF qb = QuaternionMathF::New(x2[i], y2[i], z2[i], w2[i]);
+          float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+          float w = ops[op]->getMisoQuat(qa, qb, n1, n2, n3);
+
+          DREAM3D_REQUIRE(fabs(angles[i] - w) < 1.0E-4)
+          DREAM3D_REQUIRE_EQUAL(axesAngles[i], w)
+          DREAM3D_REQUIRE_EQUAL(axes[3 * i], n1)
+          DREAM3D_REQUIRE_EQUAL(axes[3 * i + 1], n2)
+          DREAM3D_REQUIRE_EQUAL(axes[3 * i + 2], n3)
+          DREAM3D_REQUIRE_EQUAL(below[i], (w < tolerance))
+        }
+      }
+      delete[] below;
+    }
+
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestBatchedMisorientation() )
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    SpaceGroupOpsTest(const SpaceGroupOpsTest&); // Copy Constructor Not Implemented
+    void operator=(const SpaceGroupOpsTest&); // Operator '=' Not Implemented
+};
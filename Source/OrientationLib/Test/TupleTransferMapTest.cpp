@@ -0,0 +1,246 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
+class TupleTransferMapTest
+{
+  public:
+    TupleTransferMapTest(){}
+    virtual ~TupleTransferMapTest(){}
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    AttributeMatrix::Pointer createAttributeMatrix(size_t numTuples)
+    {
+      QVector<size_t> tDims(1, numTuples);
+      AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, "CellData", SIMPL::AttributeMatrixType::Cell);
+
+      Int32ArrayType::Pointer ids = Int32ArrayType::CreateArray(numTuples, "Ids");
+      FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(numTuples, QVector<size_t>(1, 3), "Vectors");
+      StringDataArray::Pointer names = StringDataArray::CreateArray(numTuples, "Names");
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        ids->setValue(i, static_cast<int32_t>(10 * i + 1));
+        for(int32_t c = 0; c < 3; c++)
+        {
+          vectors->setComponent(i, c, static_cast<float>(i) + 0.25f * static_cast<float>(c + 1));
+        }
+        names->setValue(i, QString("Tuple %1").arg(i));
+      }
+      attrMat->addAttributeArray("Ids", ids);
+      attrMat->addAttributeArray("Vectors", vectors);
+      attrMat->addAttributeArray("Names", names);
+      return attrMat;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Checks every array of attrMat against reference, to which the same copies were made with copyTuple
+    // -----------------------------------------------------------------------------
+    void compareArrays(AttributeMatrix::Pointer attrMat, AttributeMatrix::Pointer reference)
+    {
+      Int32ArrayType::Pointer ids = std::dynamic_pointer_cast<Int32ArrayType>(attrMat->getAttributeArray("Ids"));
+      Int32ArrayType::Pointer refIds = std::dynamic_pointer_cast<Int32ArrayType>(reference->getAttributeArray("Ids"));
+      FloatArrayType::Pointer vectors = std::dynamic_pointer_cast<FloatArrayType>(attrMat->getAttributeArray("Vectors"));
+      FloatArrayType::Pointer refVectors = std::dynamic_pointer_cast<FloatArrayType>(reference->getAttributeArray("Vectors"));
+      StringDataArray::Pointer names = std::dynamic_pointer_cast<StringDataArray>(attrMat->getAttributeArray("Names"));
+      StringDataArray::Pointer refNames = std::dynamic_pointer_cast<StringDataArray>(reference->getAttributeArray("Names"));
+
+      DREAM3D_REQUIRE_EQUAL(ids->getNumberOfTuples(), refIds->getNumberOfTuples())
+      DREAM3D_REQUIRE_EQUAL(names->getNumberOfTuples(), refNames->getNumberOfTuples())
+      for(size_t i = 0; i < ids->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(ids->getValue(i), refIds->getValue(i))
+        for(int32_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(vectors->getComponent(i, c), refVectors->getComponent(i, c))
+        }
+        DREAM3D_REQUIRE(names->getValue(i) == refNames->getValue(i))
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void copyTuples(AttributeMatrix::Pointer attrMat, size_t source, size_t destination)
+    {
+      QList<QString> arrayNames = attrMat->getAttributeArrayNames();
+      for(QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+      {
+        attrMat->getAttributeArray(*iter)->copyTuple(source, destination);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestCopy()
+    {
+      AttributeMatrix::Pointer attrMat = createAttributeMatrix(6);
+      AttributeMatrix::Pointer reference = createAttributeMatrix(6);
+      Int32ArrayType::Pointer ids = std::dynamic_pointer_cast<Int32ArrayType>(attrMat->getAttributeArray("Ids"));
+
+      TupleTransferMap transferMap(6);
+      DREAM3D_REQUIRE(transferMap.isEmpty() == true)
+      transferMap.addCopy(0, 1);
+      transferMap.addCopy(4, 3);
+      DREAM3D_REQUIRE(transferMap.isEmpty() == false)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(1), 0)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(3), 4)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(5), 5)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentValue(ids->getPointer(0), 3), 41)
+
+      copyTuples(reference, 0, 1);
+      copyTuples(reference, 4, 3);
+      transferMap.apply(attrMat);
+      compareArrays(attrMat, reference);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestReset()
+    {
+      AttributeMatrix::Pointer attrMat = createAttributeMatrix(5);
+      Int32ArrayType::Pointer ids = std::dynamic_pointer_cast<Int32ArrayType>(attrMat->getAttributeArray("Ids"));
+      FloatArrayType::Pointer vectors = std::dynamic_pointer_cast<FloatArrayType>(attrMat->getAttributeArray("Vectors"));
+      StringDataArray::Pointer names = std::dynamic_pointer_cast<StringDataArray>(attrMat->getAttributeArray("Names"));
+
+      TupleTransferMap transferMap(5);
+      transferMap.addReset(2);
+      // A copy out of a reset tuple carries the reset along
+      transferMap.addCopy(2, 4);
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(2), -1)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(4), -1)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentValue(ids->getPointer(0), 2), 0)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentValue(ids->getPointer(0), 1), 11)
+
+      transferMap.apply(attrMat);
+      DREAM3D_REQUIRE_EQUAL(ids->getValue(1), 11)
+      DREAM3D_REQUIRE_EQUAL(ids->getValue(2), 0)
+      DREAM3D_REQUIRE_EQUAL(ids->getValue(4), 0)
+      for(int32_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(vectors->getComponent(2, c), 0.0f)
+        DREAM3D_REQUIRE_EQUAL(vectors->getComponent(4, c), 0.0f)
+      }
+      // Arrays without a zero value keep their values at reset tuples
+      DREAM3D_REQUIRE(names->getValue(2) == QString("Tuple 2"))
+      DREAM3D_REQUIRE(names->getValue(4) == QString("Tuple 4"))
+
+      // The map can be reused after clear()
+      transferMap.clear();
+      DREAM3D_REQUIRE(transferMap.isEmpty() == true)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(2), 2)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestChainedCopies()
+    {
+      AttributeMatrix::Pointer attrMat = createAttributeMatrix(4);
+      AttributeMatrix::Pointer reference = createAttributeMatrix(4);
+
+      // 2 takes 0, 0 takes 1 and 1 takes what 2 now holds, so 0 and 1 exchange their original values and
+      // have to be resolved as a cycle. 3 then takes what 0 now holds, which is the original value of 1.
+      const size_t copies[4][2] = {{0, 2}, {1, 0}, {2, 1}, {0, 3}};
+      TupleTransferMap transferMap(4);
+      for(size_t i = 0; i < 4; i++)
+      {
+        transferMap.addCopy(copies[i][0], copies[i][1]);
+        copyTuples(reference, copies[i][0], copies[i][1]);
+      }
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(0), 1)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(1), 0)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(2), 0)
+      DREAM3D_REQUIRE_EQUAL(transferMap.currentSource(3), 1)
+
+      transferMap.apply(attrMat);
+      compareArrays(attrMat, reference);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestRandomCopies()
+    {
+      std::mt19937 generator(1234);
+      for(size_t trial = 0; trial < 20; trial++)
+      {
+        size_t numTuples = 8 + trial * 3;
+        AttributeMatrix::Pointer attrMat = createAttributeMatrix(numTuples);
+        AttributeMatrix::Pointer reference = createAttributeMatrix(numTuples);
+        std::uniform_int_distribution<size_t> distribution(0, numTuples - 1);
+
+        TupleTransferMap transferMap(numTuples);
+        for(size_t i = 0; i < 4 * numTuples; i++)
+        {
+          size_t source = distribution(generator);
+          size_t destination = distribution(generator);
+          transferMap.addCopy(source, destination);
+          copyTuples(reference, source, destination);
+        }
+        transferMap.apply(attrMat);
+        compareArrays(attrMat, reference);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = 0;
+      DREAM3D_REGISTER_TEST( TestCopy() );
+      DREAM3D_REGISTER_TEST( TestReset() );
+      DREAM3D_REGISTER_TEST( TestChainedCopies() );
+      DREAM3D_REGISTER_TEST( TestRandomCopies() );
+    }
+
+  private:
+    TupleTransferMapTest(const TupleTransferMapTest&); // Copy Constructor Not Implemented
+    void operator=(const TupleTransferMapTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,449 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _featurereductionengine_hpp_
+#define _featurereductionengine_hpp_
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The FeatureReductionImpl class accumulates the per Feature sums of a set of contiguous chunks of
+ * Cells. Each chunk writes into its own partial record array, so chunks can be processed concurrently.
+ */
+template <typename T> class FeatureReductionImpl
+{
+public:
+  FeatureReductionImpl(const int32_t* featureIds, const int64_t dims[3], int64_t numFeatures, const size_t layout[7], const T* scalars, const int8_t* boundaryCells,
+                       size_t numChunks, std::vector<std::vector<double>>& partials, std::vector<int32_t>& largestFeatureIds)
+  : m_FeatureIds(featureIds)
+  , m_NumFeatures(numFeatures)
+  , m_Scalars(scalars)
+  , m_BoundaryCells(boundaryCells)
+  , m_NumChunks(numChunks)
+  , m_Partials(partials)
+  , m_LargestFeatureIds(largestFeatureIds)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+    }
+    for(int32_t a = 0; a < 7; a++)
+    {
+      m_Layout[a] = layout[a];
+    }
+  }
+
+  virtual ~FeatureReductionImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      reduceChunk(chunk);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  int64_t m_Dims[3];
+  int64_t m_NumFeatures;
+  size_t m_Layout[7];
+  const T* m_Scalars;
+  const int8_t* m_BoundaryCells;
+  size_t m_NumChunks;
+  std::vector<std::vector<double>>& m_Partials;
+  std::vector<int32_t>& m_LargestFeatureIds;
+
+  void reduceChunk(size_t chunk) const
+  {
+    const size_t npos = static_cast<size_t>(-1);
+    int64_t xyPoints = m_Dims[0] * m_Dims[1];
+    int64_t totalPoints = xyPoints * m_Dims[2];
+    int64_t start = totalPoints * static_cast<int64_t>(chunk) / static_cast<int64_t>(m_NumChunks);
+    int64_t end = totalPoints * static_cast<int64_t>(chunk + 1) / static_cast<int64_t>(m_NumChunks);
+
+    size_t recordSize = m_Layout[6];
+    size_t countOffset = m_Layout[0];
+    size_t firstOffset = m_Layout[1];
+    size_t secondOffset = m_Layout[2];
+    size_t scalarOffset = (nullptr != m_Scalars) ? m_Layout[3] : npos;
+    size_t boundaryOffset = (nullptr != m_BoundaryCells) ? m_Layout[4] : npos;
+    size_t facesOffset = m_Layout[5];
+    double* records = m_Partials[chunk].data();
+    int32_t largest = m_LargestFeatureIds[chunk];
+
+    // Only the starting Cell needs a division; the indices are stepped along with the Cell after that
+    int64_t x = start % m_Dims[0];
+    int64_t y = (start / m_Dims[0]) % m_Dims[1];
+    int64_t z = start / xyPoints;
+
+    for(int64_t i = start; i < end; i++)
+    {
+      int32_t feature = m_FeatureIds[i];
+      if(feature > largest)
+      {
+        largest = feature;
+      }
+      if(feature >= 0 && feature < m_NumFeatures)
+      {
+        double* record = records + static_cast<size_t>(feature) * recordSize;
+        if(countOffset != npos)
+        {
+          record[countOffset] += 1.0;
+        }
+        if(firstOffset != npos)
+        {
+          record[firstOffset + 0] += static_cast<double>(x);
+          record[firstOffset + 1] += static_cast<double>(y);
+          record[firstOffset + 2] += static_cast<double>(z);
+        }
+        if(secondOffset != npos)
+        {
+          double dx = static_cast<double>(x);
+          double dy = static_cast<double>(y);
+          double dz = static_cast<double>(z);
+          record[secondOffset + 0] += dx * dx;
+          record[secondOffset + 1] += dy * dy;
+          record[secondOffset + 2] += dz * dz;
+          record[secondOffset + 3] += dx * dy;
+          record[secondOffset + 4] += dy * dz;
+          record[secondOffset + 5] += dx * dz;
+        }
+        if(scalarOffset != npos)
+        {
+          record[scalarOffset] += static_cast<double>(m_Scalars[i]);
+        }
+        if(boundaryOffset != npos && m_BoundaryCells[i] > 0)
+        {
+          record[boundaryOffset] += 1.0;
+        }
+        if(facesOffset != npos && feature > 0)
+        {
+          if(x > 0 && m_FeatureIds[i - 1] != feature)
+          {
+            record[facesOffset + 0] += 1.0;
+          }
+          if(x < m_Dims[0] - 1 && m_FeatureIds[i + 1] != feature)
+          {
+            record[facesOffset + 0] += 1.0;
+          }
+          if(y > 0 && m_FeatureIds[i - m_Dims[0]] != feature)
+          {
+            record[facesOffset + 1] += 1.0;
+          }
+          if(y < m_Dims[1] - 1 && m_FeatureIds[i + m_Dims[0]] != feature)
+          {
+            record[facesOffset + 1] += 1.0;
+          }
+          if(z > 0 && m_FeatureIds[i - xyPoints] != feature)
+          {
+            record[facesOffset + 2] += 1.0;
+          }
+          if(z < m_Dims[2] - 1 && m_FeatureIds[i + xyPoints] != feature)
+          {
+            record[facesOffset + 2] += 1.0;
+          }
+        }
+      }
+
+      x++;
+      if(x == m_Dims[0])
+      {
+        x = 0;
+        y++;
+        if(y == m_Dims[1])
+        {
+          y = 0;
+          z++;
+        }
+      }
+    }
+    m_LargestFeatureIds[chunk] = largest;
+  }
+};
+
+/**
+ * @brief The FeatureReductionMergeImpl class adds the partial record arrays of every chunk after the first
+ * into the first one, over a range of record values.
+ */
+class FeatureReductionMergeImpl
+{
+public:
+  FeatureReductionMergeImpl(std::vector<std::vector<double>>& partials)
+  : m_Partials(partials)
+  {
+  }
+
+  virtual ~FeatureReductionMergeImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    double* total = m_Partials[0].data();
+    for(size_t p = 1; p < m_Partials.size(); p++)
+    {
+      const double* partial = m_Partials[p].data();
+      for(size_t v = start; v < end; v++)
+      {
+        total[v] += partial[v];
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<std::vector<double>>& m_Partials;
+};
+
+/**
+ * @brief The FeatureReductionEngine class computes a set of per Feature sums over the Cells of an image
+ * geometry in a single pass. The Cells are split into contiguous chunks that each accumulate into their own
+ * partial records, which are added together at the end. The number of chunks is limited so that the partial
+ * records never take more memory than the Feature Ids themselves. Cell indices are used for the moments,
+ * so callers apply their own resolution and origin. Feature Ids outside of [0, numFeatures) are skipped, but
+ * still reported by getLargestFeatureId(). Callers without an image geometry pass { numCells, 1, 1 } as the
+ * dimensions and do not request moments or exposed faces.
+ */
+class FeatureReductionEngine
+{
+public:
+  enum Accumulator
+  {
+    Count = 0x01,         //!< Number of Cells
+    FirstMoments = 0x02,  //!< Sums of the x, y and z Cell indices
+    SecondMoments = 0x04, //!< Sums of the xx, yy, zz, xy, yz and xz Cell index products
+    ScalarSum = 0x08,     //!< Sum of a scalar Cell array
+    BoundaryCount = 0x10, //!< Number of Cells whose boundary value is > 0
+    ExposedFaces = 0x20   //!< Number of x, y and z faces a Feature > 0 shares with a different Feature
+  };
+
+  /**
+   * @brief FeatureReductionEngine
+   * @param featureIds Cell Feature Ids
+   * @param dims Dimensions of the geometry
+   * @param numFeatures Number of Features
+   * @param accumulators Bitwise or of the requested Accumulator values
+   */
+  FeatureReductionEngine(const int32_t* featureIds, const size_t dims[3], size_t numFeatures, uint32_t accumulators)
+  : m_FeatureIds(featureIds)
+  , m_NumFeatures(numFeatures)
+  , m_BoundaryCells(nullptr)
+  , m_NumChunks(0)
+  , m_LargestFeatureId(-1)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = static_cast<int64_t>(dims[d]);
+    }
+    const size_t widths[6] = {1, 3, 6, 1, 1, 3};
+    size_t recordSize = 0;
+    for(int32_t a = 0; a < 6; a++)
+    {
+      m_Layout[a] = static_cast<size_t>(-1);
+      if((accumulators & (1 << a)) != 0)
+      {
+        m_Layout[a] = recordSize;
+        recordSize += widths[a];
+      }
+    }
+    m_Layout[6] = recordSize;
+  }
+
+  virtual ~FeatureReductionEngine()
+  {
+  }
+
+  /**
+   * @brief setBoundaryCells Sets the Cell array used by the BoundaryCount accumulator
+   */
+  void setBoundaryCells(const int8_t* boundaryCells)
+  {
+    m_BoundaryCells = boundaryCells;
+  }
+
+  /**
+   * @brief setNumberOfChunks Sets the number of chunks the Cells are split into. The default of 0 picks it from
+   * the number of threads and the memory budget of the partial records.
+   */
+  void setNumberOfChunks(size_t numChunks)
+  {
+    m_NumChunks = numChunks;
+  }
+
+  /**
+   * @brief execute Runs the reduction, summing the given scalar Cell array for the ScalarSum accumulator
+   */
+  template <typename T> void execute(const T* scalars)
+  {
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    size_t recordValues = m_NumFeatures * m_Layout[6];
+
+    size_t numChunks = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    size_t partialBytes = std::max<size_t>(recordValues * sizeof(double), 1);
+    size_t budget = static_cast<size_t>(totalPoints) * sizeof(int32_t);
+    numChunks = std::min<size_t>(std::max<size_t>(budget / partialBytes, 1), static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()));
+#endif
+    if(m_NumChunks > 0)
+    {
+      numChunks = m_NumChunks;
+    }
+    numChunks = std::min<size_t>(numChunks, std::max<size_t>(static_cast<size_t>(totalPoints), 1));
+
+    m_Partials.assign(numChunks, std::vector<double>(recordValues, 0.0));
+    std::vector<int32_t> largestFeatureIds(numChunks, -1);
+    FeatureReductionImpl<T> impl(m_FeatureIds, m_Dims, static_cast<int64_t>(m_NumFeatures), m_Layout, scalars, m_BoundaryCells, numChunks, m_Partials, largestFeatureIds);
+    FeatureReductionMergeImpl merge(m_Partials);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), impl, tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, recordValues), merge, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(0, numChunks);
+      merge.generate(0, recordValues);
+    }
+
+    m_Partials.resize(1);
+    m_LargestFeatureId = *std::max_element(largestFeatureIds.begin(), largestFeatureIds.end());
+  }
+
+  /**
+   * @brief execute Runs the reduction without a scalar Cell array
+   */
+  void execute()
+  {
+    execute<int8_t>(nullptr);
+  }
+
+  /**
+   * @brief getLargestFeatureId Returns the largest Feature Id found in the last execute(), including Ids that were skipped
+   */
+  int32_t getLargestFeatureId() const
+  {
+    return m_LargestFeatureId;
+  }
+
+  double getCount(size_t feature) const
+  {
+    return value(feature, 0)[0];
+  }
+
+  /**
+   * @brief getFirstMoments Returns the x, y and z Cell index sums of a Feature
+   */
+  const double* getFirstMoments(size_t feature) const
+  {
+    return value(feature, 1);
+  }
+
+  /**
+   * @brief getSecondMoments Returns the xx, yy, zz, xy, yz and xz Cell index product sums of a Feature
+   */
+  const double* getSecondMoments(size_t feature) const
+  {
+    return value(feature, 2);
+  }
+
+  double getScalarSum(size_t feature) const
+  {
+    return value(feature, 3)[0];
+  }
+
+  double getBoundaryCount(size_t feature) const
+  {
+    return value(feature, 4)[0];
+  }
+
+  /**
+   * @brief getExposedFaces Returns the number of exposed faces of a Feature normal to x, y and z
+   */
+  const double* getExposedFaces(size_t feature) const
+  {
+    return value(feature, 5);
+  }
+
+private:
+  const int32_t* m_FeatureIds;
+  int64_t m_Dims[3];
+  size_t m_NumFeatures;
+  const int8_t* m_BoundaryCells;
+  size_t m_NumChunks;
+  size_t m_Layout[7];
+  std::vector<std::vector<double>> m_Partials;
+  int32_t m_LargestFeatureId;
+
+  const double* value(size_t feature, int32_t accumulator) const
+  {
+    return m_Partials[0].data() + feature * m_Layout[6] + m_Layout[accumulator];
+  }
+
+  FeatureReductionEngine(const FeatureReductionEngine&); // Copy Constructor Not Implemented
+  void operator=(const FeatureReductionEngine&);         // Operator '=' Not Implemented
+};
+
+#endif /* _featurereductionengine_hpp_ */
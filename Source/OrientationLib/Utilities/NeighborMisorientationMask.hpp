@@ -0,0 +1,297 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _neighbormisorientationmask_hpp_
+#define _neighbormisorientationmask_hpp_
+
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+/**
+ * @brief The NeighborMisorientationMaskImpl class fills the mask words of a range of Cells. Each Cell only
+ * writes its own word, so ranges can be processed concurrently. When a list of changed Cells is given,
+ * only the bits of pairs that touch a changed Cell are computed again.
+ */
+class NeighborMisorientationMaskImpl
+{
+public:
+  NeighborMisorientationMaskImpl(const int64_t dims[3], const std::vector<int32_t>& offsets, const std::vector<int64_t>& strides, QuatF* quats, int32_t* cellPhases,
+                                 uint32_t* crystalStructures, QVector<SpaceGroupOps::Pointer> orientationOps, float tolerance, const uint8_t* changed, uint16_t* bits)
+  : m_Offsets(offsets)
+  , m_Strides(strides)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_Tolerance(tolerance)
+  , m_Changed(changed)
+  , m_Bits(bits)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+    }
+  }
+
+  virtual ~NeighborMisorientationMaskImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    int64_t numOffsets = static_cast<int64_t>(m_Strides.size());
+
+    for(size_t point = start; point < end; point++)
+    {
+      int64_t column = static_cast<int64_t>(point) % m_Dims[0];
+      int64_t row = (static_cast<int64_t>(point) / m_Dims[0]) % m_Dims[1];
+      int64_t plane = static_cast<int64_t>(point) / (m_Dims[0] * m_Dims[1]);
+      uint16_t word = m_Bits[point];
+
+      for(int64_t o = 0; o < numOffsets; o++)
+      {
+        uint16_t bit = static_cast<uint16_t>(1 << o);
+        int64_t x = column + m_Offsets[3 * o];
+        int64_t y = row + m_Offsets[3 * o + 1];
+        int64_t z = plane + m_Offsets[3 * o + 2];
+        if(x < 0 || x >= m_Dims[0] || y < 0 || y >= m_Dims[1] || z < 0 || z >= m_Dims[2])
+        {
+          word &= ~bit;
+          continue;
+        }
+        size_t neighbor = point + static_cast<size_t>(m_Strides[o]);
+        if(nullptr != m_Changed && m_Changed[point] == 0 && m_Changed[neighbor] == 0)
+        {
+          continue;
+        }
+
+        bool similar = false;
+        int32_t phase = m_CellPhases[point];
+        if(phase > 0 && phase == m_CellPhases[neighbor] && m_CrystalStructures[phase] < static_cast<uint32_t>(m_OrientationOps.size()))
+        {
+          QuaternionMathF::Copy(m_Quats[point], q1);
+          QuaternionMathF::Copy(m_Quats[neighbor], q2);
+          float w = m_OrientationOps[m_CrystalStructures[phase]]->getMisoQuat(q1, q2, n1, n2, n3);
+          similar = (w < m_Tolerance);
+        }
+        if(similar == true)
+        {
+          word |= bit;
+        }
+        else
+        {
+          word &= ~bit;
+        }
+      }
+      m_Bits[point] = word;
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int64_t m_Dims[3];
+  const std::vector<int32_t>& m_Offsets;
+  const std::vector<int64_t>& m_Strides;
+  QuatF* m_Quats;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+  float m_Tolerance;
+  const uint8_t* m_Changed;
+  uint16_t* m_Bits;
+};
+
+/**
+ * @brief The NeighborMisorientationMask class caches, for every Cell of an image geometry and each of a
+ * fixed set of neighbor offsets, whether the Cell and its neighbor at that offset have the same phase (> 0),
+ * a known crystal structure and a misorientation below a tolerance. The cache holds one bit per pair in a
+ * 16 bit word per Cell, so each pair is tested once, in parallel, instead of once for every Cell that looks
+ * at it. Filters that move orientations around between passes call update() with the Cells that changed.
+ */
+class NeighborMisorientationMask
+{
+public:
+  /**
+   * @brief NeighborMisorientationMask
+   * @param dims Dimensions of the image geometry
+   * @param offsets Neighbor offsets as (x, y, z) triplets. Each pair of Cells is stored once, so an offset and
+   * its opposite must not both be given. At most 16 offsets are supported.
+   * @param quats Cell quaternions
+   * @param cellPhases Cell phases
+   * @param crystalStructures Ensemble crystal structures
+   * @param orientationOps Orientation ops indexed by crystal structure
+   * @param tolerance Misorientation tolerance (radians)
+   */
+  NeighborMisorientationMask(const size_t dims[3], const std::vector<int32_t>& offsets, QuatF* quats, int32_t* cellPhases, uint32_t* crystalStructures,
+                             QVector<SpaceGroupOps::Pointer> orientationOps, float tolerance)
+  : m_Offsets(offsets)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_Tolerance(tolerance)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = static_cast<int64_t>(dims[d]);
+    }
+    for(size_t o = 0; o < m_Offsets.size() / 3; o++)
+    {
+      m_Strides.push_back(m_Offsets[3 * o] + m_Offsets[3 * o + 1] * m_Dims[0] + m_Offsets[3 * o + 2] * m_Dims[0] * m_Dims[1]);
+    }
+    m_Bits.resize(static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]), 0);
+  }
+
+  virtual ~NeighborMisorientationMask()
+  {
+  }
+
+  /**
+   * @brief FaceOffsets Returns the offsets of the face neighbors (+x, +y and +z)
+   */
+  static std::vector<int32_t> FaceOffsets()
+  {
+    const int32_t offsets[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    return std::vector<int32_t>(offsets, offsets + 9);
+  }
+
+  /**
+   * @brief FaceNeighborPairOffsets Returns the offsets that separate two face neighbors of the same Cell:
+   * two Cells along each axis and the two diagonals of each axis plane
+   */
+  static std::vector<int32_t> FaceNeighborPairOffsets()
+  {
+    const int32_t offsets[27] = {2, 0, 0, 0, 2, 0, 0, 0, 2, 1, 1, 0, -1, 1, 0, 1, 0, 1, -1, 0, 1, 0, 1, 1, 0, -1, 1};
+    return std::vector<int32_t>(offsets, offsets + 27);
+  }
+
+  /**
+   * @brief compute Tests every pair of the mask
+   */
+  void compute()
+  {
+    run(nullptr);
+  }
+
+  /**
+   * @brief update Tests again every pair that has at least one Cell whose phase or orientation changed
+   * @param changed One value per Cell, non zero for Cells that changed
+   */
+  void update(const std::vector<uint8_t>& changed)
+  {
+    run(changed.data());
+  }
+
+  /**
+   * @brief isWithinTolerance Returns the cached test for a pair of Cells. Pairs that are not separated by
+   * one of the offsets of the mask (in either order) are never within tolerance.
+   * @param point1 First Cell
+   * @param point2 Second Cell
+   */
+  bool isWithinTolerance(int64_t point1, int64_t point2) const
+  {
+    int64_t base = (point1 < point2) ? point1 : point2;
+    int64_t other = (point1 < point2) ? point2 : point1;
+    int64_t stride = other - base;
+    for(size_t o = 0; o < m_Strides.size(); o++)
+    {
+      // A bit is only set when its offset stays inside the geometry, so a set bit with the same stride always
+      // refers to this very pair of Cells
+      if(m_Strides[o] == stride && (m_Bits[base] & (1 << o)) != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  int64_t m_Dims[3];
+  std::vector<int32_t> m_Offsets;
+  std::vector<int64_t> m_Strides;
+  QuatF* m_Quats;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+  float m_Tolerance;
+  std::vector<uint16_t> m_Bits;
+
+  void run(const uint8_t* changed)
+  {
+    size_t totalPoints = m_Bits.size();
+    NeighborMisorientationMaskImpl impl(m_Dims, m_Offsets, m_Strides, m_Quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, m_Tolerance, changed, m_Bits.data());
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(0, totalPoints);
+    }
+  }
+
+  NeighborMisorientationMask(const NeighborMisorientationMask&); // Copy Constructor Not Implemented
+  void operator=(const NeighborMisorientationMask&);             // Operator '=' Not Implemented
+};
+
+#endif /* _neighbormisorientationmask_hpp_ */
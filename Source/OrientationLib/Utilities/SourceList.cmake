@@ -44,6 +44,9 @@ set(OrientationLib_Utilities_HDRS
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionArray.h
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection3D.hpp
   ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureImageUtilities.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/TupleTransferMap.hpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/NeighborMisorientationMask.hpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/FeatureReductionEngine.hpp
 )
 
 set(OrientationLib_Utilities_SRCS
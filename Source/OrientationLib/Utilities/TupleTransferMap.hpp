@@ -0,0 +1,401 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _tupletransfermap_hpp_
+#define _tupletransfermap_hpp_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/OrientationLib.h"
+
+/**
+ * @brief The TupleTransferImpl class moves the tuples of one typed array for a TupleTransferMap. The gather
+ * pass reads every source tuple into a compact buffer and the scatter pass writes the buffer out to the
+ * destination tuples, so no destination is written before every source has been read.
+ */
+template <typename T>
+class TupleTransferImpl
+{
+public:
+  TupleTransferImpl(T* data, T* buffer, size_t numComps, const size_t* destinations, const int64_t* sources, bool scatter)
+  : m_Data(data)
+  , m_Buffer(buffer)
+  , m_NumComps(numComps)
+  , m_Destinations(destinations)
+  , m_Sources(sources)
+  , m_Scatter(scatter)
+  {
+  }
+
+  virtual ~TupleTransferImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      T* value = m_Buffer + i * m_NumComps;
+      if(m_Scatter == true)
+      {
+        T* destination = m_Data + m_Destinations[i] * m_NumComps;
+        for(size_t c = 0; c < m_NumComps; c++)
+        {
+          destination[c] = value[c];
+        }
+      }
+      else if(m_Sources[i] < 0)
+      {
+        for(size_t c = 0; c < m_NumComps; c++)
+        {
+          value[c] = static_cast<T>(0);
+        }
+      }
+      else
+      {
+        T* source = m_Data + static_cast<size_t>(m_Sources[i]) * m_NumComps;
+        for(size_t c = 0; c < m_NumComps; c++)
+        {
+          value[c] = source[c];
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_Data;
+  T* m_Buffer;
+  size_t m_NumComps;
+  const size_t* m_Destinations;
+  const int64_t* m_Sources;
+  bool m_Scatter;
+};
+
+/**
+ * @brief The TupleTransferMap class records the tuple copies a filter would make with IDataArray::copyTuple
+ * inside a loop and then applies all of them to every array of an AttributeMatrix at once. Each copy is
+ * resolved against the copies recorded before it, so the result is the same as calling copyTuple on each
+ * array in the recorded order. Filters that test values of the arrays being copied (usually the Feature Ids)
+ * while recording should read them through currentSource(), which gives the tuple whose original values the
+ * index holds at that point. Arrays of the primitive types are moved with a typed, multithreaded gather and
+ * scatter; any other array falls back to replaying the copies with copyTuple.
+ */
+class TupleTransferMap
+{
+public:
+  /**
+   * @brief TupleTransferMap
+   * @param numTuples Number of tuples in the arrays the map will be applied to
+   */
+  TupleTransferMap(size_t numTuples)
+  : m_CurrentSources(numTuples, static_cast<int64_t>(k_Untouched))
+  {
+  }
+
+  virtual ~TupleTransferMap()
+  {
+  }
+
+  /**
+   * @brief addCopy Records that destination receives the current values of source
+   * @param source Tuple to copy from
+   * @param destination Tuple to copy to
+   */
+  void addCopy(size_t source, size_t destination)
+  {
+    int64_t resolved = m_CurrentSources[source];
+    if(resolved == k_Untouched)
+    {
+      resolved = static_cast<int64_t>(source);
+    }
+    setSource(destination, resolved);
+  }
+
+  /**
+   * @brief addReset Records that destination is set to zero in every component. Arrays that are not of a
+   * primitive type have no zero value and keep their current values at reset tuples.
+   * @param destination Tuple to reset
+   */
+  void addReset(size_t destination)
+  {
+    setSource(destination, k_Reset);
+  }
+
+  /**
+   * @brief currentSource Returns the tuple whose original values index holds after the copies recorded so far.
+   * Callers that index an array with the result must handle -1 (a reset tuple); currentValue() does that.
+   * @param index Tuple to look up
+   * @return Original tuple index, or -1 if index has been reset to zero
+   */
+  int64_t currentSource(size_t index) const
+  {
+    int64_t resolved = m_CurrentSources[index];
+    if(resolved == k_Untouched)
+    {
+      return static_cast<int64_t>(index);
+    }
+    return (resolved == k_Reset) ? -1 : resolved;
+  }
+
+  /**
+   * @brief currentValue Returns the value the first component of index holds in a single component array
+   * after the copies recorded so far, which is zero for a reset tuple
+   * @param data Original values of the array
+   * @param index Tuple to look up
+   */
+  template <typename T>
+  T currentValue(const T* data, size_t index) const
+  {
+    int64_t source = currentSource(index);
+    return (source < 0) ? static_cast<T>(0) : data[source];
+  }
+
+  /**
+   * @brief isEmpty Returns whether any copy or reset has been recorded
+   */
+  bool isEmpty() const
+  {
+    return m_Destinations.empty();
+  }
+
+  /**
+   * @brief clear Forgets every recorded copy and reset so the map can be reused
+   */
+  void clear()
+  {
+    for(size_t i = 0; i < m_Destinations.size(); i++)
+    {
+      m_CurrentSources[m_Destinations[i]] = k_Untouched;
+    }
+    m_Destinations.clear();
+  }
+
+  /**
+   * @brief apply Applies the recorded copies to every array of an AttributeMatrix
+   * @param attrMat AttributeMatrix whose arrays are updated
+   */
+  void apply(AttributeMatrix::Pointer attrMat) const
+  {
+    if(isEmpty() == true)
+    {
+      return;
+    }
+    std::vector<int64_t> sources = resolvedSources();
+    QList<QString> arrayNames = attrMat->getAttributeArrayNames();
+    for(QList<QString>::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+    {
+      applyToArray(attrMat->getAttributeArray(*iter), sources);
+    }
+  }
+
+  /**
+   * @brief apply Applies the recorded copies to a single array
+   * @param array Array to update
+   */
+  void apply(IDataArray::Pointer array) const
+  {
+    if(isEmpty() == true)
+    {
+      return;
+    }
+    applyToArray(array, resolvedSources());
+  }
+
+private:
+  static const int64_t k_Untouched = -1;
+  static const int64_t k_Reset = -2;
+
+  std::vector<int64_t> m_CurrentSources;
+  std::vector<size_t> m_Destinations;
+
+  void setSource(size_t destination, int64_t source)
+  {
+    if(m_CurrentSources[destination] == k_Untouched)
+    {
+      m_Destinations.push_back(destination);
+    }
+    m_CurrentSources[destination] = source;
+  }
+
+  std::vector<int64_t> resolvedSources() const
+  {
+    std::vector<int64_t> sources(m_Destinations.size());
+    for(size_t i = 0; i < m_Destinations.size(); i++)
+    {
+      sources[i] = m_CurrentSources[m_Destinations[i]];
+    }
+    return sources;
+  }
+
+  template <typename T>
+  bool applyTyped(IDataArray::Pointer array, const std::vector<int64_t>& sources) const
+  {
+    typename DataArray<T>::Pointer dataArray = std::dynamic_pointer_cast<DataArray<T> >(array);
+    if(nullptr == dataArray.get())
+    {
+      return false;
+    }
+    size_t numComps = static_cast<size_t>(dataArray->getNumberOfComponents());
+    size_t numDestinations = m_Destinations.size();
+    typename DataArray<T>::Pointer bufferPtr = DataArray<T>::CreateArray(numDestinations, QVector<size_t>(1, numComps), "_INTERNAL_USE_ONLY_TupleTransferBuffer", true);
+    T* data = dataArray->getPointer(0);
+    T* buffer = bufferPtr->getPointer(0);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    for(int32_t pass = 0; pass < 2; pass++)
+    {
+      TupleTransferImpl<T> impl(data, buffer, numComps, m_Destinations.data(), sources.data(), pass == 1);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numDestinations), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.generate(0, numDestinations);
+      }
+    }
+    return true;
+  }
+
+  void applyToArray(IDataArray::Pointer array, const std::vector<int64_t>& sources) const
+  {
+    if(applyTyped<float>(array, sources) || applyTyped<double>(array, sources) || applyTyped<int8_t>(array, sources) || applyTyped<uint8_t>(array, sources) ||
+       applyTyped<int16_t>(array, sources) || applyTyped<uint16_t>(array, sources) || applyTyped<int32_t>(array, sources) || applyTyped<uint32_t>(array, sources) ||
+       applyTyped<int64_t>(array, sources) || applyTyped<uint64_t>(array, sources) || applyTyped<bool>(array, sources))
+    {
+      return;
+    }
+    replayCopies(array, sources);
+  }
+
+  /**
+   * @brief replayCopies Applies the resolved copies to an array that is not of a primitive type with copyTuple.
+   * A tuple is only overwritten once no pending copy still reads it; the copies left over after that form
+   * cycles, which are broken by parking one tuple of each cycle in a spare tuple at the end of the array.
+   * Reset tuples keep their current values.
+   */
+  void replayCopies(IDataArray::Pointer array, const std::vector<int64_t>& sources) const
+  {
+    size_t numTuples = m_CurrentSources.size();
+    std::vector<int32_t> readers(numTuples, 0);
+    std::vector<uint8_t> pending(numTuples, 0);
+    for(size_t i = 0; i < m_Destinations.size(); i++)
+    {
+      if(sources[i] >= 0 && static_cast<size_t>(sources[i]) != m_Destinations[i])
+      {
+        pending[m_Destinations[i]] = 1;
+        readers[sources[i]]++;
+      }
+    }
+
+    std::vector<size_t> ready;
+    for(size_t i = 0; i < m_Destinations.size(); i++)
+    {
+      if(pending[m_Destinations[i]] == 1 && readers[m_Destinations[i]] == 0)
+      {
+        ready.push_back(m_Destinations[i]);
+      }
+    }
+    while(ready.empty() == false)
+    {
+      size_t destination = ready.back();
+      ready.pop_back();
+      size_t source = static_cast<size_t>(m_CurrentSources[destination]);
+      array->copyTuple(source, destination);
+      pending[destination] = 0;
+      readers[source]--;
+      if(readers[source] == 0 && pending[source] == 1)
+      {
+        ready.push_back(source);
+      }
+    }
+
+    for(size_t i = 0; i < m_Destinations.size(); i++)
+    {
+      size_t first = m_Destinations[i];
+      if(pending[first] == 0)
+      {
+        continue;
+      }
+      array->resize(numTuples + 1);
+      array->copyTuple(first, numTuples);
+      size_t destination = first;
+      while(true)
+      {
+        size_t source = static_cast<size_t>(m_CurrentSources[destination]);
+        pending[destination] = 0;
+        if(source == first)
+        {
+          array->copyTuple(numTuples, destination);
+          break;
+        }
+        array->copyTuple(source, destination);
+        destination = source;
+      }
+      array->resize(numTuples);
+    }
+  }
+
+  TupleTransferMap(const TupleTransferMap&); // Copy Constructor Not Implemented
+  void operator=(const TupleTransferMap&);   // Operator '=' Not Implemented
+};
+
+#endif /* _tupletransfermap_hpp_ */
@@ -35,6 +35,13 @@
 
 #include "EMMPMFilter.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "EMMPM/EMMPMConstants.h"
 #include "EMMPM/EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPM/EMMPMLib/Common/EMTime.h"
@@ -48,6 +55,7 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
@@ -64,6 +72,92 @@
 // Include the MOC generated file for this class
 #include "moc_EMMPMFilter.cpp"
 
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InitializationFunction::Pointer createInitializationFunction(EMMPM_InitializationType initType)
+{
+  switch(initType)
+  {
+  case EMMPM_ManualInit:
+    return InitializationFunction::New();
+  case EMMPM_UserInitArea:
+    return UserDefinedAreasInitialization::New();
+  default:
+    break;
+  }
+  return BasicInitialization::New();
+}
+}
+
+/**
+ * @brief The SegmentSlicesImpl class runs an independent EM/MPM segmentation on each z-slice in a range
+ */
+class SegmentSlicesImpl
+{
+public:
+  SegmentSlicesImpl(EMMPMFilter* filter, EMMPM_InitializationType initType, uint8_t* input, uint8_t* output, size_t columns, size_t rows, std::vector<int32_t>& errors)
+  : m_Filter(filter)
+  , m_InitType(initType)
+  , m_Input(input)
+  , m_Output(output)
+  , m_Columns(columns)
+  , m_Rows(rows)
+  , m_Errors(errors)
+  {
+  }
+  virtual ~SegmentSlicesImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    size_t sliceSize = m_Columns * m_Rows;
+    for(size_t z = start; z < end; z++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      EMMPM_Data::Pointer data = EMMPM_Data::New();
+      data->dims = 1;
+      data->inputImage = m_Input + z * sliceSize;
+      data->xt = m_Output + z * sliceSize;
+      m_Filter->setupData(data, m_InitType, m_Columns, m_Rows);
+
+      StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
+      EMMPM::Pointer emmpm = EMMPM::New();
+      emmpm->setData(data);
+      emmpm->setStatsDelegate(statsDelegate.get());
+      emmpm->setInitializationFunction(createInitializationFunction(m_InitType));
+      emmpm->execute();
+      m_Errors[z] = emmpm->getErrorCondition();
+
+      // The input and output belong to the filter's arrays, so keep EMMPM_Data from freeing them
+      data->inputImage = nullptr;
+      data->xt = nullptr;
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  EMMPMFilter* m_Filter;
+  EMMPM_InitializationType m_InitType;
+  uint8_t* m_Input;
+  uint8_t* m_Output;
+  size_t m_Columns;
+  size_t m_Rows;
+  std::vector<int32_t>& m_Errors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -79,6 +173,7 @@ EMMPMFilter::EMMPMFilter()
   m_CurvatureBetaC(1.0f),
   m_CurvatureRMax(15.0f),
   m_CurvatureEMLoopDelay(1),
+  m_VolumeMode(EMMPM_IndependentSlices),
   m_OutputDataArrayPath("", "", ""),
   m_EmmpmInitType(EMMPM_Basic),
   m_Data(EMMPM_Data::New())
@@ -128,6 +223,21 @@ void EMMPMFilter::setupFilterParameters()
     parameters.push_back(parameter);
   }
 
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Volume Segmentation");
+    parameter->setPropertyName("VolumeMode");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(EMMPMFilter, this, VolumeMode));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(EMMPMFilter, this, VolumeMode));
+
+    QVector<QString> choices;
+    choices.push_back("Independent Slices");
+    choices.push_back("Shared Class Statistics");
+    choices.push_back("3D Neighborhood");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
   {
     QStringList linkedProps;
     linkedProps << "GradientBetaE";
@@ -175,6 +285,7 @@ void EMMPMFilter::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCurvatureBetaC(reader->readValue("CurvaturePenalty", getCurvatureBetaC()));
   setCurvatureRMax(reader->readValue("RMax", getCurvatureRMax()));
   setCurvatureEMLoopDelay(reader->readValue("EMLoopDelay", getCurvatureEMLoopDelay()));
+  setVolumeMode(reader->readValue("VolumeMode", getVolumeMode()));
   setOutputDataArrayPath(reader->readDataArrayPath("OutputDataArrayPath", getOutputDataArrayPath()));
   reader->closeFilterGroup();
 }
@@ -280,81 +391,31 @@ void EMMPMFilter::execute()
 // -----------------------------------------------------------------------------
 void EMMPMFilter::segment(EMMPM_InitializationType initType)
 {
-  // Copy all the variables from the filter into the EMmpm Data structure.
-  m_Data->initType = initType;
-
-  InitializationFunction::Pointer initFunction = BasicInitialization::New();
-
-  // Set the initialization function based on the parameters
-  switch(m_Data->initType)
-  {
-  case EMMPM_ManualInit:
-    initFunction = InitializationFunction::New();
-    break;
-  case EMMPM_UserInitArea:
-    initFunction = UserDefinedAreasInitialization::New();
-    break;
-  default:
-    initFunction = BasicInitialization::New();
-    break;
-  }
-
-  m_Data->classes = getNumClasses();
-  m_Data->in_beta = getExchangeEnergy();
-  m_Data->emIterations = getHistogramLoops();
-  m_Data->mpmIterations = getSegmentationLoops();
-
-  DynamicTableData tableDataObj = getEMMPMTableData();
-  std::vector<std::vector<double> > tableData = tableDataObj.getTableData();
-  for(int32_t i = 0; i < m_Data->classes; i++)
-  {
-    int32_t gray = 255 / (m_Data->classes - 1);
-    // Generate a Gray Scale Color Table
-    m_Data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
-    // Hard code the minimum variance to 4.5; This could be a user option.
-    m_Data->min_variance[i] = tableData[i][1];
-    // Do we know what w_gamma is?
-    m_Data->w_gamma[i] = tableData[i][0];
-  }
-
   DataArrayPath dap = getInputDataArrayPath();
   AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
   QVector<size_t> tDims = am->getTupleDimensions();
-  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
-  QVector<size_t> cDims = iDataArray->getComponentDimensions();
+  size_t slices = (tDims.size() > 2) ? tDims[2] : 1;
 
-  m_Data->columns = tDims[0];
-  m_Data->rows = tDims[1];
-  m_Data->inputImageChannels = cDims[0];
+  if(slices > 1 && getVolumeMode() == EMMPM_IndependentSlices)
+  {
+    segmentSlices(initType, tDims);
+    return;
+  }
 
-  m_Data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
-  m_Data->useGradientPenalty = getUseGradientPenalty();
-  m_Data->beta_e = getGradientBetaE();
-  m_Data->useCurvaturePenalty = getUseCurvaturePenalty();
-  m_Data->beta_c = getCurvatureBetaC();
-  m_Data->r_max = getCurvatureRMax();
-  m_Data->ccostLoopDelay = getCurvatureEMLoopDelay();
+  // Any other volume is segmented as one image made of the stacked slices, so the class means and
+  // variances are shared by every slice
+  m_Data->slices = static_cast<unsigned int>(slices);
+  m_Data->use3DNeighborhood = (getVolumeMode() == EMMPM_Neighborhood3D) ? 1 : 0;
 
   // Assign our Data array allocated input and output images into the EMMPData class
   m_Data->inputImage = m_InputImage;
   m_Data->xt = m_OutputImage;
 
-  // Allocate all the memory here
-  m_Data->allocateDataStructureMemory();
+  // Copy all the variables from the filter into the EMmpm Data structure and allocate all the memory
+  setupData(m_Data, initType, tDims[0], tDims[1] * slices);
 
-  // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
-  // variables
-  if(m_Data->initType == EMMPM_ManualInit)
-  {
-    for(int32_t i = 0; i < m_Data->classes; i++)
-    {
-      for(uint32_t d = 0; d < m_Data->dims; d++)
-      {
-        m_Data->mean[i * m_Data->dims + d] = m_PreviousMu[i * m_Data->dims + d];
-        m_Data->variance[i * m_Data->dims + d] = m_PreviousSigma[i * m_Data->dims + d];
-      }
-    }
-  }
+  // Set the initialization function based on the parameters
+  InitializationFunction::Pointer initFunction = createInitializationFunction(m_Data->initType);
 
   // Create a new StatsDelegate so the EMMPM algorith has somewhere to write its statistics
   StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
@@ -395,6 +456,100 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setupData(EMMPM_Data::Pointer data, EMMPM_InitializationType initType, size_t columns, size_t rows)
+{
+  data->initType = initType;
+  data->classes = getNumClasses();
+  data->in_beta = getExchangeEnergy();
+  data->emIterations = getHistogramLoops();
+  data->mpmIterations = getSegmentationLoops();
+
+  DynamicTableData tableDataObj = getEMMPMTableData();
+  std::vector<std::vector<double> > tableData = tableDataObj.getTableData();
+  for(int32_t i = 0; i < data->classes; i++)
+  {
+    int32_t gray = 255 / (data->classes - 1);
+    // Generate a Gray Scale Color Table
+    data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
+    // Hard code the minimum variance to 4.5; This could be a user option.
+    data->min_variance[i] = tableData[i][1];
+    // Do we know what w_gamma is?
+    data->w_gamma[i] = tableData[i][0];
+  }
+
+  data->columns = columns;
+  data->rows = rows;
+  data->inputImageChannels = m_InputImagePtr.lock()->getNumberOfComponents();
+
+  data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
+  data->useGradientPenalty = getUseGradientPenalty();
+  data->beta_e = getGradientBetaE();
+  data->useCurvaturePenalty = getUseCurvaturePenalty();
+  data->beta_c = getCurvatureBetaC();
+  data->r_max = getCurvatureRMax();
+  data->ccostLoopDelay = getCurvatureEMLoopDelay();
+
+  // Allocate all the memory here
+  data->allocateDataStructureMemory();
+
+  // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
+  // variables
+  if(data->initType == EMMPM_ManualInit)
+  {
+    for(int32_t i = 0; i < data->classes; i++)
+    {
+      for(uint32_t d = 0; d < data->dims; d++)
+      {
+        data->mean[i * data->dims + d] = m_PreviousMu[i * data->dims + d];
+        data->variance[i * data->dims + d] = m_PreviousSigma[i * data->dims + d];
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentSlices(EMMPM_InitializationType initType, const QVector<size_t>& tDims)
+{
+  size_t slices = tDims[2];
+  std::vector<int32_t> errors(slices, 0);
+
+  QString ss = QObject::tr("Segmenting %1 slices").arg(slices);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  SegmentSlicesImpl impl(this, initType, m_InputImage, m_OutputImage, tDims[0], tDims[1], errors);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slices, 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.generate(0, slices);
+  }
+
+  for(size_t z = 0; z < slices; z++)
+  {
+    if(errors[z] < 0)
+    {
+      setErrorCondition(errors[z]);
+      QString ss = QObject::tr("Error allocating the EM/MPM working memory for slice %1").arg(z);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -98,6 +98,9 @@ class EMMPMFilter : public AbstractFilter
     SIMPL_FILTER_PARAMETER(int, CurvatureEMLoopDelay)
     Q_PROPERTY(int CurvatureEMLoopDelay READ getCurvatureEMLoopDelay WRITE setCurvatureEMLoopDelay)
 
+    SIMPL_FILTER_PARAMETER(int, VolumeMode)
+    Q_PROPERTY(int VolumeMode READ getVolumeMode WRITE setVolumeMode)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, OutputDataArrayPath)
     Q_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
 
@@ -162,6 +165,16 @@ class EMMPMFilter : public AbstractFilter
     */
     virtual void preflight();
 
+    /**
+     * @brief setupData Copies the filter parameters into an EMMPM_Data object and allocates its working memory.
+     * The input image and xt pointers of the data should already point at the image to segment.
+     * @param data The EMMPM_Data to set up
+     * @param initType Enumeration of EMMPM initialization types
+     * @param columns The width of the image
+     * @param rows The height of the image
+     */
+    void setupData(EMMPM_Data::Pointer data, EMMPM_InitializationType initType, size_t columns, size_t rows);
+
   signals:
     /**
      * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
@@ -204,6 +217,13 @@ class EMMPMFilter : public AbstractFilter
      */
     virtual void segment(EMMPM_InitializationType initType);
 
+    /**
+     * @brief segmentSlices Segments each z-slice of the image on its own, with the slices running concurrently
+     * @param initType Enumeration of EMMPM initialization types
+     * @param tDims The tuple dimensions of the image
+     */
+    void segmentSlices(EMMPM_InitializationType initType, const QVector<size_t>& tDims);
+
     /**
      * @brief getPreviousMu
      * @return
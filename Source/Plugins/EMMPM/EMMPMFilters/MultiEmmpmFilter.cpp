@@ -130,6 +130,7 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
   setCurvatureBetaC(reader->readValue("CurvaturePenalty", getCurvatureBetaC()));
   setCurvatureRMax(reader->readValue("RMax", getCurvatureRMax()));
   setCurvatureEMLoopDelay(reader->readValue("EMLoopDelay", getCurvatureEMLoopDelay()));
+  setVolumeMode(reader->readValue("VolumeMode", getVolumeMode()));
   setOutputAttributeMatrixName(reader->readString("OutputAttributeMatrixName", getOutputAttributeMatrixName()));
   setUsePreviousMuSigma(reader->readValue("UsePreviousMuSigma", getUsePreviousMuSigma()));
   setOutputArrayPrefix(reader->readString("OutputArrayPrefix", getOutputArrayPrefix()));
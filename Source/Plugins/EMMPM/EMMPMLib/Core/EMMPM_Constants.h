@@ -49,5 +49,12 @@ enum EMMPM_InitializationType
   EMMPM_ManualInit
 };
 
+enum EMMPM_VolumeMode
+{
+  EMMPM_IndependentSlices = 0,
+  EMMPM_SharedStatistics,
+  EMMPM_Neighborhood3D
+};
+
 
 #endif /* EMMPM_CONSTANTS_H_ */
@@ -207,6 +207,8 @@ void EMMPM_Data::initVariables()
   this->rows = 0;
   this->columns = 0;
   this->dims = 1;
+  this->slices = 1;
+  this->use3DNeighborhood = 0;
   this->initType = EMMPM_Basic;
   this->couplingBeta = nullptr;
   for(c = 0; c < EMMPM_MAX_CLASSES; c++)
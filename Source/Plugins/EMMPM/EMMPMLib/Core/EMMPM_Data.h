@@ -101,6 +101,8 @@ class EMMPMLib_EXPORT EMMPM_Data
     unsigned int rows; /**< The height of the image.  Applicable for both input and output images */
     unsigned int columns; /**< The width of the image. Applicable for both input and output images */
     unsigned int dims; /**< The number of vector elements in the image.*/
+    unsigned int slices; /**< The number of equally sized slices stacked along the rows of the image. Pixel neighborhoods stop at slice boundaries */
+    char use3DNeighborhood; /**< Also use the 3x3 pixels of the adjacent slices as neighbors in the MPM loop */
     enum EMMPM_InitializationType initType;  /**< The type of initialization algorithm to use  */
     unsigned int initCoords[EMMPM_MAX_CLASSES][4];  /**<  MAX_CLASSES rows x 4 Columns  */
     //unsigned int grayTable[EMMPM_MAX_CLASSES];
@@ -69,7 +69,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #define COMPUTE_C_CLIQUE(C, x, y, ci, cj)                                                                                                                                                              \
-  if((x) < 0 || (x) >= colEnd || (y) < 0 || (y) >= rowEnd)                                                                                                                                             \
+  if((x) < 0 || (x) >= colEnd || (y) < sliceStart || (y) >= sliceEnd)                                                                                                                                  \
   {                                                                                                                                                                                                    \
     C[ci][cj] = classes;                                                                                                                                                                               \
   }                                                                                                                                                                                                    \
@@ -151,14 +151,47 @@ public:
                  // the clique would be off the image then a value = number of classes is
                  // used for the C[i][j]. That way we can figure out if we are off the image
 
+    // The image may be a stack of slices. The in-plane clique stops at the slice boundaries and, for a 3D
+    // neighborhood, the 3x3 pixels of the slices above and below are also used as neighbors.
+    int32_t slices = (data->slices > 0) ? data->slices : 1;
+    int32_t sliceRows = rows / slices;
+    int32_t sliceStride = cols * sliceRows;
+    int32_t zClique[18];
+    int32_t zCount = 0;
+
     std::stringstream ss;
     unsigned int cSize = classes + 1;
     real_t* coupling = data->couplingBeta;
 
     for(int32_t y = rowStart; y < rowEnd; y++)
     {
+      int32_t slice = y / sliceRows;
+      int32_t sliceStart = slice * sliceRows;
+      int32_t sliceEnd = (sliceStart + sliceRows < rowEnd) ? sliceStart + sliceRows : rowEnd;
       for(int32_t x = colStart; x < colEnd; x++)
       {
+        zCount = 0;
+        if(data->use3DNeighborhood)
+        {
+          for(int32_t z = -1; z <= 1; z += 2)
+          {
+            if(slice + z < 0 || slice + z >= slices)
+            {
+              continue;
+            }
+            for(int32_t j = y - 1; j <= y + 1; j++)
+            {
+              for(int32_t i = x - 1; i <= x + 1; i++)
+              {
+                if(i >= 0 && i < cols && j >= sliceStart && j < sliceStart + sliceRows)
+                {
+                  zClique[zCount] = xt[(cols * j) + i + z * sliceStride];
+                  zCount++;
+                }
+              }
+            }
+          }
+        }
 
         /* -------------  */
         COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
@@ -197,6 +230,10 @@ public:
           prior += coupling[(cSize * l) + C[0][2]];
           prior += coupling[(cSize * l) + C[1][2]];
           prior += coupling[(cSize * l) + C[2][2]];
+          for(int32_t n = 0; n < zCount; n++)
+          {
+            prior += coupling[(cSize * l) + zClique[n]];
+          }
 
 #if 0
             if (y == rowStart + 1 && x == colStart + 1)
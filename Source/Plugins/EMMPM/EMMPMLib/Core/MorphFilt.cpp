@@ -101,7 +101,9 @@ void MorphFilter::morphFilt(EMMPM_Data* data, unsigned char* curve, unsigned cha
   unsigned int se_cols;
   size_t ij, i1j1, iirjjr;
 
-  int rows = data->rows;
+  // Stacked slices are filtered one at a time so the structuring element never reaches into the next slice
+  int slices = (data->slices > 0) ? data->slices : 1;
+  int rows = data->rows / slices;
   int cols = data->columns;
   int classes = data->classes;
 
@@ -110,57 +112,63 @@ void MorphFilter::morphFilt(EMMPM_Data* data, unsigned char* curve, unsigned cha
   erosion = (unsigned char*)malloc(cols * rows * sizeof(unsigned char));
   ::memset(erosion, 0, cols * rows * sizeof(unsigned char));
 
-  for(int i = 0; i < rows; i++)
+  for(int s = 0; s < slices; s++)
   {
-    for(int j = 0; j < cols; j++)
+    unsigned char* xt = data->xt + static_cast<size_t>(s) * rows * cols;
+    unsigned char* sliceCurve = curve + static_cast<size_t>(s) * rows * cols;
+
+    for(int i = 0; i < rows; i++)
     {
-      ij = (cols * i) + j;
-
-      curve[ij] = classes;
-      l = data->xt[ij];
-      erosion[ij] = l;
-      maxr = (r < rows - 1 - i ? r : rows - 1 - i); // mini(r, rows - 1 - i);
-      maxc = (r < cols - 1 - j ? r : cols - 1 - j); // mini(r, cols - 1 - j);
-      int mini_ii = (r < i ? r : i);
-      int mini_jj = (r < j ? r : j);
-      for(int ii = -mini_ii; ii <= (int)maxr; ii++)
+      for(int j = 0; j < cols; j++)
       {
-        for(int jj = -mini_jj; jj <= (int)maxc && erosion[ij] == l; jj++)
+        ij = (cols * i) + j;
+
+        sliceCurve[ij] = classes;
+        l = xt[ij];
+        erosion[ij] = l;
+        maxr = (r < rows - 1 - i ? r : rows - 1 - i); // mini(r, rows - 1 - i);
+        maxc = (r < cols - 1 - j ? r : cols - 1 - j); // mini(r, cols - 1 - j);
+        int mini_ii = (r < i ? r : i);
+        int mini_jj = (r < j ? r : j);
+        for(int ii = -mini_ii; ii <= (int)maxr; ii++)
         {
-          i1j1 = (cols * (i + ii)) + (j + jj);
-          iirjjr = (se_cols * (ii + r)) + (jj + r);
-          if(se[iirjjr] == 1 && data->xt[i1j1] != l)
+          for(int jj = -mini_jj; jj <= (int)maxc && erosion[ij] == l; jj++)
           {
-            erosion[ij] = classes;
+            i1j1 = (cols * (i + ii)) + (j + jj);
+            iirjjr = (se_cols * (ii + r)) + (jj + r);
+            if(se[iirjjr] == 1 && xt[i1j1] != l)
+            {
+              erosion[ij] = classes;
+            }
           }
         }
       }
     }
-  }
 
-  // h = r - -r + 1;
-  w = r - -r + 1;
-  for(int ii = -r; ii <= r; ii++)
-  {
-    for(int jj = -r; jj <= r; jj++)
+    // h = r - -r + 1;
+    w = r - -r + 1;
+    for(int ii = -r; ii <= r; ii++)
     {
-      iirjjr = (w * (ii + r)) + (jj + r);
-      if(se[iirjjr] == 1)
+      for(int jj = -r; jj <= r; jj++)
       {
-        maxr = rows - maxi(0, ii);
-        maxc = cols - maxi(0, jj);
-        int maxi_ii = (0 < -ii ? -ii : 0);
-        int maxi_jj = (0 < -jj ? -jj : 0);
-        for(int i = maxi_ii; i < (int)maxr; ++i)
+        iirjjr = (w * (ii + r)) + (jj + r);
+        if(se[iirjjr] == 1)
         {
-          for(int j = maxi_jj; j < (int)maxc; ++j)
+          maxr = rows - maxi(0, ii);
+          maxc = cols - maxi(0, jj);
+          int maxi_ii = (0 < -ii ? -ii : 0);
+          int maxi_jj = (0 < -jj ? -jj : 0);
+          for(int i = maxi_ii; i < (int)maxr; ++i)
           {
-            ij = (cols * i) + j;
-            l = erosion[ij];
-            if(l != (unsigned int)(classes))
+            for(int j = maxi_jj; j < (int)maxc; ++j)
             {
-              i1j1 = (cols * (i + ii)) + (j + jj);
-              curve[i1j1] = l;
+              ij = (cols * i) + j;
+              l = erosion[ij];
+              if(l != (unsigned int)(classes))
+              {
+                i1j1 = (cols * (i + ii)) + (j + jj);
+                sliceCurve[i1j1] = l;
+              }
             }
           }
         }
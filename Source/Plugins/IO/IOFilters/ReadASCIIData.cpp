@@ -14,6 +14,7 @@
 
 #include "IO/IOConstants.h"
 #include "IO/IOVersion.h"
+#include "IO/IOFilters/util/ASCIIBulkImporter.hpp"
 
 #include "Widgets/ImportASCIIDataWizard/AbstractDataParser.hpp"
 #include "Widgets/ImportASCIIDataWizard/ImportASCIIDataWizard.h"
@@ -486,12 +487,71 @@ void ReadASCIIData::execute()
   QFile inputFile(inputFilePath);
   if(inputFile.open(QIODevice::ReadOnly))
   {
+    // Parse the whole file in parallel straight from a memory map. UTF-16/32 files and files that can
+    // not be mapped are read line by line below.
+    qint64 fileSize = inputFile.size();
+    uchar* mappedData = (fileSize > 0) ? inputFile.map(0, fileSize) : nullptr;
+    if(nullptr != mappedData)
+    {
+      const char* data = reinterpret_cast<const char*>(mappedData);
+      size_t dataSize = static_cast<size_t>(fileSize);
+      bool wideText = (dataSize >= 2 && ((mappedData[0] == 0xFF && mappedData[1] == 0xFE) || (mappedData[0] == 0xFE && mappedData[1] == 0xFF))) ||
+                      (dataSize >= 4 && mappedData[0] == 0x00 && mappedData[1] == 0x00 && mappedData[2] == 0xFE && mappedData[3] == 0xFF);
+      if(wideText == false)
+      {
+        if(dataSize >= 3 && mappedData[0] == 0xEF && mappedData[1] == 0xBB && mappedData[2] == 0xBF)
+        {
+          data += 3;
+          dataSize -= 3;
+        }
+
+        QString ss = QObject::tr("Importing ASCII Data from %1").arg(fileName);
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+        ASCIIBulkImporter importer(data, dataSize, delimiters, beginIndex, numLines);
+        for(int i = 0; i < headers.size(); i++)
+        {
+          importer.addColumn(m_ASCIIArrayMap.value(i));
+        }
+        bool imported = importer.import();
+        inputFile.unmap(mappedData);
+        inputFile.close();
+
+        if(imported == false)
+        {
+          const ASCIIBulkImporter::LineError& error = importer.getError();
+          if(error.type == ASCIIBulkImporter::InconsistentColumns)
+          {
+            QString ss = "Line " + QString::number(error.lineNum) + " has an inconsistent number of columns.\n";
+            QTextStream out(&ss);
+            out << "Expecting " << dataTypes.size() << " but found " << error.numTokens << "\n";
+            out << "Input line was:\n";
+            out << QString::fromLocal8Bit(error.line);
+            setErrorCondition(INCONSISTENT_COLS);
+            notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+          }
+          else
+          {
+            QString ss = error.message + "(line " + QString::number(error.lineNum) + ", column " + QString::number(error.column) + ").";
+            setErrorCondition(CONVERSION_FAILURE);
+            notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+          }
+          return;
+        }
+
+        notifyStatusMessage(getHumanLabel(), "Complete");
+        return;
+      }
+      inputFile.unmap(mappedData);
+    }
+
     QTextStream in(&inputFile);
+    QStringList pendingLines;
 
     for(int i = 1; i < beginIndex; i++)
     {
       // Skip to the first data line
-      in.readLine();
+      ImportASCIIDataWizard::ReadNextLine(in, pendingLines);
     }
 
     float threshold = 0.0f;
@@ -499,7 +559,7 @@ void ReadASCIIData::execute()
 
     for(int lineNum = beginIndex; lineNum <= numLines; lineNum++)
     {
-      QString line = in.readLine();
+      QString line = ImportASCIIDataWizard::ReadNextLine(in, pendingLines);
       QStringList tokens = ImportASCIIDataWizard::TokenizeLine(line, delimiters, consecutiveDelimiters);
 
       if(dataTypes.size() != tokens.size())
@@ -34,10 +34,23 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include "VtkStructuredPointsReader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
 
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
@@ -71,6 +84,8 @@ VtkStructuredPointsReader::VtkStructuredPointsReader()
 , m_Comment("")
 , m_DatasetType("")
 , m_FileIsBinary(true)
+, m_MappedData(nullptr)
+, m_MappedSize(0)
 {
   setupFilterParameters();
 }
@@ -206,6 +221,10 @@ void VtkStructuredPointsReader::dataCheck()
 
   // Scan through the file
   readFile();
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
 
   // now check to see what the user wanted
   if(!getReadPointData())
@@ -307,6 +326,83 @@ size_t VtkStructuredPointsReader::parseByteSize(QString text)
   return 0;
 }
 
+namespace
+{
+// Upper bound on the bytes of an ASCII data section that are split into blocks and scanned at once
+const size_t k_AsciiWindowSize = 64 * 1024 * 1024;
+// Bytes of an ASCII data section handled by one parsing task
+const size_t k_AsciiBlockSize = 1024 * 1024;
+// Bytes per value assumed when sizing the first window of an ASCII data section
+const size_t k_AsciiBytesPerValue = 8;
+// Longest ASCII token that is accepted as a value
+const size_t k_AsciiTokenSize = 128;
+// Number of values copied out of a mapped binary data section by one task
+const size_t k_BinaryBlockSize = 1024 * 1024;
+
+inline bool vtkIsSpace(char c)
+{
+  return (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v');
+}
+
+// The QByteArray conversions always use the C locale, so a ',' decimal separator in the user's
+// locale does not change how the file is read. Each returns false if the token is not a number.
+inline bool vtkParseAsciiValue(const char* token, size_t length, float& value)
+{
+  bool ok = false;
+  value = QByteArray::fromRawData(token, static_cast<int>(length)).toFloat(&ok);
+  return ok;
+}
+
+inline bool vtkParseAsciiValue(const char* token, size_t length, double& value)
+{
+  bool ok = false;
+  value = QByteArray::fromRawData(token, static_cast<int>(length)).toDouble(&ok);
+  return ok;
+}
+
+// Integer values, including the 1 byte char and unsigned_char types, are read as numbers and must fit in T
+template <typename T> bool vtkParseAsciiValue(const char* token, size_t length, T& value)
+{
+  bool ok = false;
+  QByteArray bytes = QByteArray::fromRawData(token, static_cast<int>(length));
+  if(std::numeric_limits<T>::is_signed)
+  {
+    qint64 parsed = bytes.toLongLong(&ok, 10);
+    ok = ok && parsed >= static_cast<qint64>(std::numeric_limits<T>::min()) && parsed <= static_cast<qint64>(std::numeric_limits<T>::max());
+    value = static_cast<T>(parsed);
+  }
+  else
+  {
+    // strtoull style conversions wrap a negative value around instead of failing
+    quint64 parsed = bytes.toULongLong(&ok, 10);
+    ok = ok && token[0] != '-' && parsed <= static_cast<quint64>(std::numeric_limits<T>::max());
+    value = static_cast<T>(parsed);
+  }
+  return ok;
+}
+
+/**
+ * @brief vtkReadAsciiValue reads the next whitespace separated value from the stream and parses it
+ * the same way the memory mapped path does.
+ */
+template <typename T> bool vtkReadAsciiValue(std::istream& in, T& value)
+{
+  char token[k_AsciiTokenSize];
+  in.width(k_AsciiTokenSize);
+  in >> token;
+  if(in.fail())
+  {
+    return false;
+  }
+  size_t length = strlen(token);
+  if(length >= k_AsciiTokenSize - 1 && !vtkIsSpace(static_cast<char>(in.peek())) && !in.eof())
+  {
+    return false;
+  }
+  return vtkParseAsciiValue(token, length, value);
+}
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -330,7 +426,10 @@ template <typename T> int32_t skipVolume(std::istream& in, bool binary, size_t t
     T tmp;
     for(size_t z = 0; z < totalSize; ++z)
     {
-      in >> tmp;
+      if(!vtkReadAsciiValue(in, tmp))
+      {
+        return -12022;
+      }
     }
   }
   return err;
@@ -406,20 +505,342 @@ template <typename T> int32_t vtkReadBinaryData(std::istream& in, T* data, int32
   return 0;
 }
 
+namespace
+{
+/**
+ * @brief The VtkCopyBinaryDataImpl class copies big endian values out of a memory mapped file into
+ * a DataArray, swapping the bytes of each value on little endian machines.
+ */
+template <typename T> class VtkCopyBinaryDataImpl
+{
+public:
+  VtkCopyBinaryDataImpl(const char* source, T* destination, size_t totalSize)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_TotalSize(totalSize)
+  {
+  }
+
+  virtual ~VtkCopyBinaryDataImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      size_t first = b * k_BinaryBlockSize;
+      size_t count = std::min(k_BinaryBlockSize, m_TotalSize - first);
+      ::memcpy(m_Destination + first, m_Source + first * sizeof(T), count * sizeof(T));
+      if(BIGENDIAN == 0 && sizeof(T) > 1)
+      {
+        for(size_t i = first; i < first + count; i++)
+        {
+          char* bytes = reinterpret_cast<char*>(m_Destination + i);
+          for(size_t k = 0; k < sizeof(T) / 2; k++)
+          {
+            char tmp = bytes[k];
+            bytes[k] = bytes[sizeof(T) - 1 - k];
+            bytes[sizeof(T) - 1 - k] = tmp;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Source;
+  T* m_Destination;
+  size_t m_TotalSize;
+};
+
+/**
+ * @brief The VtkParseAsciiDataImpl class counts or parses the whitespace separated values of blocks of
+ * a memory mapped ASCII data section. Block boundaries always fall on whitespace, so each block holds
+ * whole values. Values whose index is at or past totalSize belong to the next section and are not parsed.
+ * A block holding a token that is not a number of type T is flagged in blockFailed.
+ */
+template <typename T> class VtkParseAsciiDataImpl
+{
+public:
+  VtkParseAsciiDataImpl(const char* base, const std::vector<size_t>& blockStarts, std::vector<size_t>& blockCounts, const std::vector<size_t>& blockFirstValues,
+                        std::vector<uint8_t>& blockFailed, T* destination, size_t totalSize, bool parse)
+  : m_Base(base)
+  , m_BlockStarts(blockStarts)
+  , m_BlockCounts(blockCounts)
+  , m_BlockFirstValues(blockFirstValues)
+  , m_BlockFailed(blockFailed)
+  , m_Destination(destination)
+  , m_TotalSize(totalSize)
+  , m_Parse(parse)
+  {
+  }
+
+  virtual ~VtkParseAsciiDataImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    char token[k_AsciiTokenSize];
+    for(size_t b = start; b < end; b++)
+    {
+      const char* c = m_Base + m_BlockStarts[b];
+      const char* blockEnd = m_Base + m_BlockStarts[b + 1];
+      size_t count = 0;
+      size_t index = m_Parse ? m_BlockFirstValues[b] : 0;
+      while(c < blockEnd)
+      {
+        while(c < blockEnd && vtkIsSpace(*c))
+        {
+          c++;
+        }
+        if(c == blockEnd)
+        {
+          break;
+        }
+        const char* tokenStart = c;
+        while(c < blockEnd && !vtkIsSpace(*c))
+        {
+          c++;
+        }
+        count++;
+        if(m_Parse == true)
+        {
+          if(index >= m_TotalSize)
+          {
+            break;
+          }
+          size_t length = static_cast<size_t>(c - tokenStart);
+          if(length >= sizeof(token))
+          {
+            m_BlockFailed[b] = 1;
+            break;
+          }
+          ::memcpy(token, tokenStart, length);
+          token[length] = '\0';
+          if(!vtkParseAsciiValue(token, length, m_Destination[index]))
+          {
+            m_BlockFailed[b] = 1;
+            break;
+          }
+          index++;
+        }
+      }
+      if(m_Parse == false)
+      {
+        m_BlockCounts[b] = count;
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Base;
+  const std::vector<size_t>& m_BlockStarts;
+  std::vector<size_t>& m_BlockCounts;
+  const std::vector<size_t>& m_BlockFirstValues;
+  std::vector<uint8_t>& m_BlockFailed;
+  T* m_Destination;
+  size_t m_TotalSize;
+  bool m_Parse;
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> int32_t vtkReadMappedBinaryData(const char* mappedData, size_t mappedSize, size_t offset, T* data, size_t totalSize)
+{
+  if(offset + totalSize * sizeof(T) > mappedSize)
+  {
+    return -12021;
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  size_t numBlocks = (totalSize + k_BinaryBlockSize - 1) / k_BinaryBlockSize;
+  VtkCopyBinaryDataImpl<T> impl(mappedData + offset, data, totalSize);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.generate(0, numBlocks);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Reads totalSize ASCII values starting at offset in a memory mapped file. The mapped bytes are
+// scanned a window at a time: each window is split into blocks on whitespace, the values in every
+// block are counted in parallel and then parsed in parallel straight into their final positions.
+// A window only covers the bytes the remaining values are expected to take, so a small section
+// does not scan the sections after it. If data is a nullptr the values are only counted, which
+// skips the section. On return offset points just past the last value of the section.
+// -----------------------------------------------------------------------------
+template <typename T> int32_t vtkReadMappedAsciiData(const char* mappedData, size_t mappedSize, size_t& offset, T* data, size_t totalSize)
+{
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  size_t valuesFound = 0;
+  size_t pos = offset;
+  size_t bytesPerValue = k_AsciiBytesPerValue;
+  while(valuesFound < totalSize)
+  {
+    if(pos >= mappedSize)
+    {
+      return -12021;
+    }
+    size_t windowSize = std::min(k_AsciiWindowSize, (totalSize - valuesFound) * bytesPerValue);
+    size_t windowEnd = std::min(mappedSize, pos + windowSize);
+
+    std::vector<size_t> blockStarts(1, pos);
+    while(blockStarts.back() < windowEnd)
+    {
+      size_t blockEnd = std::min(windowEnd, blockStarts.back() + k_AsciiBlockSize);
+      while(blockEnd < mappedSize && !vtkIsSpace(mappedData[blockEnd]) && !vtkIsSpace(mappedData[blockEnd - 1]))
+      {
+        blockEnd++;
+      }
+      blockStarts.push_back(blockEnd);
+    }
+    windowEnd = blockStarts.back();
+    size_t numBlocks = blockStarts.size() - 1;
+    std::vector<size_t> blockCounts(numBlocks, 0);
+    std::vector<size_t> blockFirstValues(numBlocks, 0);
+    std::vector<uint8_t> blockFailed(numBlocks, 0);
+
+    for(int32_t pass = 0; pass < 2; pass++)
+    {
+      bool parse = (pass == 1);
+      if(parse == true)
+      {
+        size_t first = valuesFound;
+        for(size_t b = 0; b < numBlocks; b++)
+        {
+          blockFirstValues[b] = first;
+          first += blockCounts[b];
+        }
+        if(nullptr == data)
+        {
+          break;
+        }
+      }
+      VtkParseAsciiDataImpl<T> impl(mappedData, blockStarts, blockCounts, blockFirstValues, blockFailed, data, totalSize, parse);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.generate(0, numBlocks);
+      }
+    }
+    if(std::find(blockFailed.begin(), blockFailed.end(), 1) != blockFailed.end())
+    {
+      return -12022;
+    }
+
+    // Find the block holding the last value of the section and the end of that value
+    for(size_t b = 0; b < numBlocks; b++)
+    {
+      if(blockFirstValues[b] + blockCounts[b] < totalSize)
+      {
+        continue;
+      }
+      size_t remaining = totalSize - blockFirstValues[b];
+      size_t c = blockStarts[b];
+      while(remaining > 0)
+      {
+        while(vtkIsSpace(mappedData[c]))
+        {
+          c++;
+        }
+        while(c < mappedSize && !vtkIsSpace(mappedData[c]))
+        {
+          c++;
+        }
+        remaining--;
+      }
+      offset = c;
+      return 0;
+    }
+    size_t windowValues = blockFirstValues[numBlocks - 1] + blockCounts[numBlocks - 1] - valuesFound;
+    if(windowValues > 0)
+    {
+      // Size the next window from the bytes per value seen so far, rounded up with one byte of slack
+      bytesPerValue = (windowEnd - pos) / windowValues + 2;
+    }
+    valuesFound += windowValues;
+    pos = windowEnd;
+  }
+  offset = pos;
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, std::istream& in, bool inPreflight, bool binary, const QString& scalarName, int32_t scalarNumComp)
+template <typename T>
+int32_t readDataChunk(AttributeMatrix::Pointer attrMat, std::istream& in, bool skipData, bool binary, const QString& scalarName, int32_t scalarNumComp, const char* mappedData, size_t mappedSize)
 {
   size_t numTuples = attrMat->getNumberOfTuples();
 
   QVector<size_t> tDims = attrMat->getTupleDimensions();
   QVector<size_t> cDims(1, scalarNumComp);
 
-  typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(tDims, cDims, scalarName, !inPreflight);
+  typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(tDims, cDims, scalarName, !skipData);
   data->initializeWithZeros();
   attrMat->addAttributeArray(data->getName(), data);
-  if(inPreflight == true)
+  if(nullptr != mappedData && (binary == false || skipData == false))
+  {
+    // The stream was opened in binary mode, so its position is the byte offset into the mapped file
+    size_t offset = static_cast<size_t>(in.tellg());
+    size_t totalSize = numTuples * scalarNumComp;
+    int32_t err = 0;
+    if(binary)
+    {
+      err = vtkReadMappedBinaryData<T>(mappedData, mappedSize, offset, data->getPointer(0), totalSize);
+      offset += totalSize * sizeof(T);
+    }
+    else
+    {
+      err = vtkReadMappedAsciiData<T>(mappedData, mappedSize, offset, skipData ? nullptr : data->getPointer(0), totalSize);
+    }
+    if(err < 0)
+    {
+      std::cout << "Error Reading Data '" << scalarName.toStdString() << "' " << attrMat->getName().toStdString() << " numTuples = " << numTuples << std::endl;
+      return err;
+    }
+    in.seekg(static_cast<std::istream::off_type>(offset), std::ios_base::beg);
+    return 0;
+  }
+  if(skipData == true)
   {
     return skipVolume<T>(in, binary, numTuples * scalarNumComp);
   }
@@ -444,7 +865,11 @@ template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, st
       size_t totalSize = numTuples * scalarNumComp;
       for(size_t i = 0; i < totalSize; ++i)
       {
-        in >> value;
+        if(!vtkReadAsciiValue(in, value))
+        {
+          std::cout << "Error Reading ASCII Data '" << scalarName.toStdString() << "' " << attrMat->getName().toStdString() << " value index = " << i << std::endl;
+          return -12022;
+        }
         data->setValue(i, value);
       }
     }
@@ -613,6 +1038,15 @@ int32_t VtkStructuredPointsReader::readFile()
   volDc->getGeometryAs<ImageGeom>()->setOrigin(origin);
   vertDc->getGeometryAs<ImageGeom>()->setOrigin(origin);
 
+  // Map the file so the data sections can be copied and parsed in place. If the file can not be
+  // mapped the data sections are read through the stream instead.
+  QFile mappedFile(getInputFile());
+  if(mappedFile.open(QIODevice::ReadOnly) == true)
+  {
+    m_MappedSize = static_cast<size_t>(mappedFile.size());
+    m_MappedData = reinterpret_cast<const char*>(mappedFile.map(0, mappedFile.size()));
+  }
+
   // Read the first key word which should be POINT_DATA or CELL_DATA
   err = readLine(in, buffer, kBufferSize); // Read Line 6 which is the first type of data we are going to read
 
@@ -628,6 +1062,7 @@ int32_t VtkStructuredPointsReader::readFile()
     ncells = tokens[1].toInt(&ok);
     if(m_CurrentAttrMat->getNumberOfTuples() != ncells)
     {
+      m_MappedData = nullptr;
       setErrorCondition(-61006);
       notifyErrorMessage(getHumanLabel(), QString("Number of cells does not match number of tuples in the Attribute Matrix"), getErrorCondition());
       return getErrorCondition();
@@ -641,6 +1076,7 @@ int32_t VtkStructuredPointsReader::readFile()
     npts = tokens[1].toInt(&ok);
     if(m_CurrentAttrMat->getNumberOfTuples() != npts)
     {
+      m_MappedData = nullptr;
       setErrorCondition(-61007);
       notifyErrorMessage(getHumanLabel(), QString("Number of points does not match number of tuples in the Attribute Matrix"), getErrorCondition());
       return getErrorCondition();
@@ -649,6 +1085,8 @@ int32_t VtkStructuredPointsReader::readFile()
   }
 
   // Close the file since we are done with it.
+  m_MappedData = nullptr;
+  m_MappedSize = 0;
   in.close();
 
   return err;
@@ -782,14 +1220,14 @@ int32_t VtkStructuredPointsReader::readDataTypeSection(std::istream& in, int32_t
           DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getVolumeDataContainerName());
           m_CurrentAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
           int32_t ncells = QString(line).toInt(&ok);
-          this->readDataTypeSection(in, ncells, "point_data");
+          return this->readDataTypeSection(in, ncells, "point_data");
         }
         else if(nextKeyWord.compare("point_data") == 0)
         {
           DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getVertexDataContainerName());
           m_CurrentAttrMat = m->getAttributeMatrix(getVertexAttributeMatrixName());
           int32_t npts = QString(line).toInt(&ok);
-          this->readDataTypeSection(in, npts, "cell_data");
+          return this->readDataTypeSection(in, npts, "cell_data");
         }
       }
     }
@@ -901,50 +1339,71 @@ int32_t VtkStructuredPointsReader::readScalarData(std::istream& in, int32_t numP
   // Suck up the newline at the end of the current line
   this->readLine(in, line, 1024);
 
+  // Arrays of a data type the user did not ask for are skipped; they are removed after reading
+  bool skipData = getInPreflight();
+  if(m_CurrentAttrMat == getDataContainerArray()->getDataContainer(getVolumeDataContainerName())->getAttributeMatrix(getCellAttributeMatrixName()))
+  {
+    skipData = skipData || !getReadCellData();
+  }
+  else
+  {
+    skipData = skipData || !getReadPointData();
+  }
+
   int32_t err = 1;
   // Read the data
   if(scalarType.compare("unsigned_char") == 0)
   {
-    err = readDataChunk<uint8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint8_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("char") == 0)
   {
-    err = readDataChunk<int8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int8_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("unsigned_short") == 0)
   {
-    err = readDataChunk<uint16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint16_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("short") == 0)
   {
-    err = readDataChunk<int16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int16_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("unsigned_int") == 0)
   {
-    err = readDataChunk<uint32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint32_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("int") == 0)
   {
-    err = readDataChunk<int32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int32_t>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("unsigned_long") == 0)
   {
-    err = readDataChunk<qint64>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<quint64>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("long") == 0)
   {
-    err = readDataChunk<quint64>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<qint64>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("float") == 0)
   {
-    err = readDataChunk<float>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<float>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
   else if(scalarType.compare("double") == 0)
   {
-    err = readDataChunk<double>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<double>(m_CurrentAttrMat, in, skipData, getFileIsBinary(), name, numComp, m_MappedData, m_MappedSize);
   }
 
-  return err;
+  if(err < 0)
+  {
+    QString ss = QObject::tr("Error reading the values of the scalar array '%1' (error %2). The file may be truncated or hold a value that is not a number of type '%3'")
+                     .arg(QString(name))
+                     .arg(err)
+                     .arg(scalarType);
+    setErrorCondition(-61008);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return 0;
+  }
+  return 1;
 }
 
 // -----------------------------------------------------------------------------
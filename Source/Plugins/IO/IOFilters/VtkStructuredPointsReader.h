@@ -267,6 +267,8 @@ class VtkStructuredPointsReader : public AbstractFilter
 
   private:
     AttributeMatrix::Pointer m_CurrentAttrMat;
+    const char* m_MappedData;
+    size_t m_MappedSize;
 
     VtkStructuredPointsReader(const VtkStructuredPointsReader&); // Copy Constructor Not Implemented
     void operator=(const VtkStructuredPointsReader&); // Operator '=' Not Implemented
@@ -0,0 +1,572 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _asciibulkimporter_hpp_
+#define _asciibulkimporter_hpp_
+
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "Widgets/ImportASCIIDataWizard/ParserFunctors.hpp"
+
+/**
+ * @brief The ASCIIBulkImporter class parses delimited ASCII data that is already in memory (usually a memory
+ * mapped file) straight into one DataArray per column. The data is split into line aligned chunks that are
+ * parsed on all cores. Plain decimal numbers are converted without allocating; any other token is handed to
+ * the same ParserFunctor the import wizard uses, so values and error messages match a line by line import.
+ * Lines may end with "\n", "\r\n" or a lone '\r'.
+ */
+class ASCIIBulkImporter
+{
+  public:
+    enum ErrorType
+    {
+      NoError = 0,
+      InconsistentColumns = 1,
+      ConversionFailure = 2
+    };
+
+    /**
+     * @brief The LineError struct describes the first line that could not be imported. The line is
+     * copied, so the error stays valid after the imported data is unmapped.
+     */
+    typedef struct
+    {
+      ErrorType type;
+      int64_t lineNum;
+      int32_t column;
+      int32_t numTokens;
+      QByteArray line;
+      QString message;
+    } LineError;
+
+    /**
+     * @brief ASCIIBulkImporter
+     * @param data Start of the file contents
+     * @param size Number of bytes of file contents
+     * @param delimiters Characters separating the values of a line
+     * @param beginIndex Line number (starting at 1) of the first line to import
+     * @param numLines Line number of the last line to import
+     */
+    ASCIIBulkImporter(const char* data, size_t size, const QList<char>& delimiters, int64_t beginIndex, int64_t numLines)
+    : m_Data(data)
+    , m_Size(size)
+    , m_BeginIndex(beginIndex)
+    , m_NumLines(numLines)
+    {
+      ::memset(m_IsDelimiter, 0, sizeof(m_IsDelimiter));
+      for(int i = 0; i < delimiters.size(); i++)
+      {
+        m_IsDelimiter[static_cast<uint8_t>(delimiters[i])] = true;
+      }
+      m_HasDelimiters = (delimiters.isEmpty() == false);
+      m_Error.type = NoError;
+      m_Error.lineNum = 0;
+      m_Error.column = 0;
+      m_Error.numTokens = 0;
+    }
+
+    virtual ~ASCIIBulkImporter() {}
+
+    /**
+     * @brief addColumn Adds the array receiving the next column of the file. Arrays of a type that can not
+     * be imported (or a null array) leave their column unread, but the column still counts as a column.
+     * @param array Destination array, which must hold one value per imported line
+     */
+    void addColumn(IDataArray::Pointer array)
+    {
+      Column_t column;
+      column.type = k_Skip;
+      column.data = nullptr;
+      if(setColumn<int8_t>(array, k_Int8, column) || setColumn<uint8_t>(array, k_UInt8, column) || setColumn<int16_t>(array, k_Int16, column) ||
+         setColumn<uint16_t>(array, k_UInt16, column) || setColumn<int32_t>(array, k_Int32, column) || setColumn<uint32_t>(array, k_UInt32, column) ||
+         setColumn<int64_t>(array, k_Int64, column) || setColumn<uint64_t>(array, k_UInt64, column) || setColumn<float>(array, k_Float, column) ||
+         setColumn<double>(array, k_Double, column))
+      {
+      }
+      m_Columns.push_back(column);
+    }
+
+    /**
+     * @brief import Parses lines beginIndex through numLines into the column arrays
+     * @return true if every line was imported; otherwise getError() describes the first bad line
+     */
+    bool import()
+    {
+      // Skip the lines before the first data line
+      size_t start = 0;
+      for(int64_t lineNum = 1; lineNum < m_BeginIndex && start < m_Size; lineNum++)
+      {
+        const char* next = nullptr;
+        findLineEnd(m_Data + start, m_Data + m_Size, next);
+        start = static_cast<size_t>(next - m_Data);
+      }
+
+      // Split the rest of the data into chunks that start at the beginning of a line
+      std::vector<size_t> chunkStarts(1, start);
+      while(chunkStarts.back() < m_Size)
+      {
+        size_t end = chunkStarts.back() + k_ChunkSize;
+        if(end >= m_Size)
+        {
+          end = m_Size;
+        }
+        else
+        {
+          const char* next = nullptr;
+          findLineEnd(m_Data + end, m_Data + m_Size, next);
+          end = static_cast<size_t>(next - m_Data);
+        }
+        chunkStarts.push_back(end);
+      }
+      size_t numChunks = chunkStarts.size() - 1;
+      std::vector<int64_t> chunkLines(numChunks, 0);
+      std::vector<int64_t> chunkFirstLines(numChunks, 0);
+      std::vector<LineError> chunkErrors(numChunks, m_Error);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+      // Count the lines of every chunk, then parse each chunk knowing the number of its first line
+      for(int32_t pass = 0; pass < 2; pass++)
+      {
+        if(pass == 1)
+        {
+          int64_t lineNum = m_BeginIndex;
+          for(size_t c = 0; c < numChunks; c++)
+          {
+            chunkFirstLines[c] = lineNum;
+            lineNum += chunkLines[c];
+          }
+          if(lineNum <= m_NumLines)
+          {
+            // The file ends before the last line to import, so the missing lines read as empty lines. They
+            // all import the same way; lines before the first missing one may still hold an earlier error.
+            std::vector<const char*> tokenStarts(m_Columns.size() + 1, nullptr);
+            std::vector<const char*> tokenEnds(m_Columns.size() + 1, nullptr);
+            LineError missing = m_Error;
+            if(parseLine(m_Data + m_Size, m_Data + m_Size, lineNum, tokenStarts, tokenEnds, missing) == false)
+            {
+              chunkErrors.push_back(missing);
+            }
+          }
+        }
+        ParseLinesImpl impl(this, chunkStarts, chunkLines, chunkFirstLines, chunkErrors, pass == 1);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if(doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), impl, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          impl.generate(0, numChunks);
+        }
+      }
+
+      for(size_t c = 0; c < chunkErrors.size(); c++)
+      {
+        if(chunkErrors[c].type != NoError)
+        {
+          m_Error = chunkErrors[c];
+          return false;
+        }
+      }
+      m_Error.type = NoError;
+      return true;
+    }
+
+    /**
+     * @brief getError Returns the first line that could not be imported
+     */
+    const LineError& getError() const
+    {
+      return m_Error;
+    }
+
+  private:
+    enum ColumnType
+    {
+      k_Skip,
+      k_Int8,
+      k_UInt8,
+      k_Int16,
+      k_UInt16,
+      k_Int32,
+      k_UInt32,
+      k_Int64,
+      k_UInt64,
+      k_Float,
+      k_Double
+    };
+
+    typedef struct
+    {
+      ColumnType type;
+      void* data;
+    } Column_t;
+
+    static const size_t k_ChunkSize = 4 * 1024 * 1024;
+    static const size_t k_MaxTokenLength = 63;
+
+    const char* m_Data;
+    size_t m_Size;
+    int64_t m_BeginIndex;
+    int64_t m_NumLines;
+    bool m_IsDelimiter[256];
+    bool m_HasDelimiters;
+    std::vector<Column_t> m_Columns;
+    LineError m_Error;
+
+    template <typename T> bool setColumn(IDataArray::Pointer array, ColumnType type, Column_t& column)
+    {
+      typename DataArray<T>::Pointer typed = std::dynamic_pointer_cast<DataArray<T> >(array);
+      if(nullptr == typed.get())
+      {
+        return false;
+      }
+      column.type = type;
+      column.data = typed->getPointer(0);
+      return true;
+    }
+
+    /**
+     * @brief parseDecimal Converts a token that is a plain decimal integer of at most 18 digits, without a
+     * '+' sign or leading zeros. Returns false for anything else.
+     */
+    static bool parseDecimal(const char* begin, const char* end, int64_t& value)
+    {
+      bool negative = (begin < end && *begin == '-');
+      const char* c = negative ? begin + 1 : begin;
+      if(c == end || end - c > 18 || (*c == '0' && end - c > 1))
+      {
+        return false;
+      }
+      int64_t result = 0;
+      for(; c < end; c++)
+      {
+        if(*c < '0' || *c > '9')
+        {
+          return false;
+        }
+        result = result * 10 + (*c - '0');
+      }
+      value = negative ? -result : result;
+      return true;
+    }
+
+    /**
+     * @brief parseReal Converts a token made only of digits, signs, '.', 'e' and 'E'. Like the QString
+     * conversion in DoubleFunctor, QByteArray::toDouble() ignores the system locale. Returns false for anything else.
+     */
+    static bool parseReal(const char* begin, const char* end, double& value)
+    {
+      size_t length = static_cast<size_t>(end - begin);
+      if(length == 0 || length > k_MaxTokenLength)
+      {
+        return false;
+      }
+      for(size_t i = 0; i < length; i++)
+      {
+        char c = begin[i];
+        if((c < '0' || c > '9') && c != '.' && c != '-' && c != '+' && c != 'e' && c != 'E')
+        {
+          return false;
+        }
+      }
+      bool ok = false;
+      value = QByteArray::fromRawData(begin, static_cast<int>(length)).toDouble(&ok);
+      return (ok && std::isfinite(value));
+    }
+
+    template <typename T, class F> static bool parseSlow(const char* begin, const char* end, T& value, QString& message)
+    {
+      ParserFunctor::ErrorObject obj;
+      value = F()(QString::fromLocal8Bit(begin, static_cast<int>(end - begin)), obj);
+      if(!obj.ok)
+      {
+        message = obj.errorMessage;
+      }
+      return obj.ok;
+    }
+
+    template <typename T, class F> static bool parseInteger(const char* begin, const char* end, T& value, QString& message)
+    {
+      int64_t fast = 0;
+      if(parseDecimal(begin, end, fast) && (fast >= 0 || std::numeric_limits<T>::is_signed) &&
+         fast >= static_cast<int64_t>(std::numeric_limits<T>::min()) && (fast < 0 || static_cast<uint64_t>(fast) <= static_cast<uint64_t>(std::numeric_limits<T>::max())))
+      {
+        value = static_cast<T>(fast);
+        return true;
+      }
+      return parseSlow<T, F>(begin, end, value, message);
+    }
+
+    static bool parseToken(const Column_t& column, const char* begin, const char* end, size_t row, QString& message)
+    {
+      switch(column.type)
+      {
+        case k_Int8:
+          return parseInteger<int8_t, Int8Functor>(begin, end, static_cast<int8_t*>(column.data)[row], message);
+        case k_UInt8:
+          return parseInteger<uint8_t, UInt8Functor>(begin, end, static_cast<uint8_t*>(column.data)[row], message);
+        case k_Int16:
+          return parseInteger<int16_t, Int16Functor>(begin, end, static_cast<int16_t*>(column.data)[row], message);
+        case k_UInt16:
+          return parseInteger<uint16_t, UInt16Functor>(begin, end, static_cast<uint16_t*>(column.data)[row], message);
+        case k_Int32:
+          return parseInteger<int32_t, Int32Functor>(begin, end, static_cast<int32_t*>(column.data)[row], message);
+        case k_UInt32:
+          return parseInteger<uint32_t, UInt32Functor>(begin, end, static_cast<uint32_t*>(column.data)[row], message);
+        case k_Int64:
+          return parseInteger<int64_t, Int64Functor>(begin, end, static_cast<int64_t*>(column.data)[row], message);
+        case k_UInt64:
+          return parseInteger<uint64_t, UInt64Functor>(begin, end, static_cast<uint64_t*>(column.data)[row], message);
+        case k_Float:
+        {
+          // Match QString::toFloat, which converts through double and rejects overflow and underflow
+          double value = 0.0;
+          if(parseReal(begin, end, value) && std::fabs(value) <= FLT_MAX && (value == 0.0 || static_cast<float>(value) != 0.0f))
+          {
+            static_cast<float*>(column.data)[row] = static_cast<float>(value);
+            return true;
+          }
+          return parseSlow<float, FloatFunctor>(begin, end, static_cast<float*>(column.data)[row], message);
+        }
+        case k_Double:
+        {
+          if(parseReal(begin, end, static_cast<double*>(column.data)[row]))
+          {
+            return true;
+          }
+          return parseSlow<double, DoubleFunctor>(begin, end, static_cast<double*>(column.data)[row], message);
+        }
+        case k_Skip:
+          break;
+      }
+      return true;
+    }
+
+    /**
+     * @brief findLineEnd Returns the end of the line starting at pos, which is its first "\n", "\r\n" or lone '\r',
+     * and sets next to the start of the following line. A line without an end of line runs to end.
+     */
+    static const char* findLineEnd(const char* pos, const char* end, const char*& next)
+    {
+      const char* newline = static_cast<const char*>(::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+      const char* lineEnd = (nullptr == newline) ? end : newline;
+      const char* carriageReturn = static_cast<const char*>(::memchr(pos, '\r', static_cast<size_t>(lineEnd - pos)));
+      if(nullptr != carriageReturn)
+      {
+        next = (carriageReturn + 1 == newline) ? newline + 1 : carriageReturn + 1;
+        return carriageReturn;
+      }
+      next = (nullptr == newline) ? end : newline + 1;
+      return lineEnd;
+    }
+
+    /**
+     * @brief parseLine Splits the line [pos, lineEnd) into its tokens the way ImportASCIIDataWizard::TokenizeLine
+     * does and parses them into the row of lineNum. Without delimiters the whole line, even an empty one, is
+     * the only token.
+     * @return false if the line can not be imported, in which case error describes it
+     */
+    bool parseLine(const char* pos, const char* lineEnd, int64_t lineNum, std::vector<const char*>& tokenStarts, std::vector<const char*>& tokenEnds, LineError& error) const
+    {
+      int32_t numColumns = static_cast<int32_t>(m_Columns.size());
+
+      // Split the line into its non-empty tokens, counting past the expected number of columns
+      int32_t numTokens = 0;
+      if(m_HasDelimiters == false)
+      {
+        tokenStarts[0] = pos;
+        tokenEnds[0] = lineEnd;
+        numTokens = 1;
+      }
+      else
+      {
+        const char* t = pos;
+        while(t < lineEnd)
+        {
+          while(t < lineEnd && m_IsDelimiter[static_cast<uint8_t>(*t)])
+          {
+            t++;
+          }
+          if(t == lineEnd)
+          {
+            break;
+          }
+          const char* tokenStart = t;
+          while(t < lineEnd && !m_IsDelimiter[static_cast<uint8_t>(*t)])
+          {
+            t++;
+          }
+          if(numTokens <= numColumns)
+          {
+            tokenStarts[numTokens] = tokenStart;
+            tokenEnds[numTokens] = t;
+          }
+          numTokens++;
+        }
+      }
+
+      if(numTokens != numColumns)
+      {
+        error.type = InconsistentColumns;
+        error.lineNum = lineNum;
+        error.numTokens = numTokens;
+        error.line = QByteArray(pos, static_cast<int>(lineEnd - pos));
+        return false;
+      }
+
+      size_t row = static_cast<size_t>(lineNum - m_BeginIndex);
+      for(int32_t i = 0; i < numColumns; i++)
+      {
+        if(parseToken(m_Columns[i], tokenStarts[i], tokenEnds[i], row, error.message) == false)
+        {
+          error.type = ConversionFailure;
+          error.lineNum = lineNum;
+          error.column = i;
+          error.line = QByteArray(pos, static_cast<int>(lineEnd - pos));
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief The ParseLinesImpl class counts or parses the lines of a range of chunks. Each chunk stops at
+     * its first bad line and records it, so the earliest chunk with an error holds the first bad line.
+     */
+    class ParseLinesImpl
+    {
+      public:
+        ParseLinesImpl(const ASCIIBulkImporter* importer, const std::vector<size_t>& chunkStarts, std::vector<int64_t>& chunkLines, const std::vector<int64_t>& chunkFirstLines,
+                       std::vector<LineError>& chunkErrors, bool parse)
+        : m_Importer(importer)
+        , m_ChunkStarts(chunkStarts)
+        , m_ChunkLines(chunkLines)
+        , m_ChunkFirstLines(chunkFirstLines)
+        , m_ChunkErrors(chunkErrors)
+        , m_Parse(parse)
+        {
+        }
+
+        virtual ~ParseLinesImpl() {}
+
+        void generate(size_t start, size_t end) const
+        {
+          for(size_t c = start; c < end; c++)
+          {
+            if(m_Parse == true)
+            {
+              parseChunk(c);
+            }
+            else
+            {
+              int64_t count = 0;
+              const char* pos = m_Importer->m_Data + m_ChunkStarts[c];
+              const char* chunkEnd = m_Importer->m_Data + m_ChunkStarts[c + 1];
+              while(pos < chunkEnd)
+              {
+                findLineEnd(pos, chunkEnd, pos);
+                count++;
+              }
+              m_ChunkLines[c] = count;
+            }
+          }
+        }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          generate(r.begin(), r.end());
+        }
+#endif
+
+      private:
+        const ASCIIBulkImporter* m_Importer;
+        const std::vector<size_t>& m_ChunkStarts;
+        std::vector<int64_t>& m_ChunkLines;
+        const std::vector<int64_t>& m_ChunkFirstLines;
+        std::vector<LineError>& m_ChunkErrors;
+        bool m_Parse;
+
+        void parseChunk(size_t c) const
+        {
+          const ASCIIBulkImporter* imp = m_Importer;
+          std::vector<const char*> tokenStarts(imp->m_Columns.size() + 1, nullptr);
+          std::vector<const char*> tokenEnds(imp->m_Columns.size() + 1, nullptr);
+
+          const char* pos = imp->m_Data + m_ChunkStarts[c];
+          const char* chunkEnd = imp->m_Data + m_ChunkStarts[c + 1];
+          for(int64_t lineNum = m_ChunkFirstLines[c]; pos < chunkEnd && lineNum <= imp->m_NumLines; lineNum++)
+          {
+            const char* next = nullptr;
+            const char* lineEnd = findLineEnd(pos, chunkEnd, next);
+            if(imp->parseLine(pos, lineEnd, lineNum, tokenStarts, tokenEnds, m_ChunkErrors[c]) == false)
+            {
+              return;
+            }
+            pos = next;
+          }
+        }
+    };
+
+    ASCIIBulkImporter(const ASCIIBulkImporter&); // Copy Constructor Not Implemented
+    void operator=(const ASCIIBulkImporter&); // Operator '=' Not Implemented
+};
+
+#endif /* _asciibulkimporter_hpp_ */
@@ -414,6 +414,152 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteRawFile(const QString& filePath, const QByteArray& contents)
+  {
+    QFile data(filePath);
+    if(data.open(QFile::WriteOnly))
+    {
+      data.write(contents);
+      data.close();
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  ASCIIWizardData CreateInt32WizardData(int numColumns, bool tabDelimited, int numberOfLines)
+  {
+    ASCIIWizardData data;
+    data.automaticAM = false;
+    data.beginIndex = 1;
+    data.consecutiveDelimiters = false;
+    for(int i = 0; i < numColumns; i++)
+    {
+      data.dataHeaders.push_back(QString("Array%1").arg(i + 1));
+      data.dataTypes.push_back(SIMPL::TypeNames::Int32);
+    }
+    if(tabDelimited == true)
+    {
+      data.delimiters.push_back('\t');
+    }
+    data.inputFilePath = UnitTest::ImportASCIIDataTest::TestFile1;
+    data.numberOfLines = numberOfLines;
+    data.selectedPath = DataArrayPath(DataContainerName, AttributeMatrixName, "");
+    data.tupleDims = QVector<size_t>(1, numberOfLines);
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer ImportRawFile(const QByteArray& contents, ASCIIWizardData data)
+  {
+    WriteRawFile(UnitTest::ImportASCIIDataTest::TestFile1, contents);
+
+    AbstractFilter::Pointer importASCIIData = PrepFilter(data);
+    DREAM3D_REQUIRE_VALID_POINTER(importASCIIData.get())
+
+    importASCIIData->execute();
+    return importASCIIData;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckInt32Column(AbstractFilter::Pointer importASCIIData, const QString& arrayName, const QVector<int>& expected)
+  {
+    AttributeMatrix::Pointer am = importASCIIData->getDataContainerArray()->getAttributeMatrix(DataArrayPath(DataContainerName, AttributeMatrixName, ""));
+    Int32ArrayType::Pointer results = std::dynamic_pointer_cast<Int32ArrayType>(am->getAttributeArray(arrayName));
+    DREAM3D_REQUIRE_VALID_POINTER(results.get())
+    DREAM3D_REQUIRE_EQUAL(results->getSize(), expected.size())
+    for(int i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(results->getValue(i), expected[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLineEndings()
+  {
+    QVector<int> column1({1, 2, 3});
+    QVector<int> column2({4, 5, 6});
+
+    // "\n", "\r\n", a lone '\r' and a mix of them all end a line, with or without one after the last line
+    QList<QByteArray> singleColumnFiles;
+    singleColumnFiles << "1\n2\n3"
+                      << "1\r\n2\r\n3\r\n"
+                      << "1\r2\r3"
+                      << "1\r2\r3\r"
+                      << "1\r\n2\r3\n";
+    for(int i = 0; i < singleColumnFiles.size(); i++)
+    {
+      AbstractFilter::Pointer importASCIIData = ImportRawFile(singleColumnFiles[i], CreateInt32WizardData(1, false, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), 0)
+      CheckInt32Column(importASCIIData, "Array1", column1);
+      RemoveTestFiles();
+    }
+
+    QList<QByteArray> twoColumnFiles;
+    twoColumnFiles << "1\t4\n2\t5\n3\t6\n"
+                   << "1\t4\r\n2\t5\r\n3\t6"
+                   << "1\t4\r2\t5\r3\t6\r";
+    for(int i = 0; i < twoColumnFiles.size(); i++)
+    {
+      AbstractFilter::Pointer importASCIIData = ImportRawFile(twoColumnFiles[i], CreateInt32WizardData(2, true, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), 0)
+      CheckInt32Column(importASCIIData, "Array1", column1);
+      CheckInt32Column(importASCIIData, "Array2", column2);
+      RemoveTestFiles();
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLineErrors()
+  {
+    // Too few and too many columns
+    {
+      AbstractFilter::Pointer importASCIIData = ImportRawFile("1\t4\n2\n3\t6\n", CreateInt32WizardData(2, true, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::INCONSISTENT_COLS)
+
+      importASCIIData = ImportRawFile("1\t4\r\n2\t5\t8\r\n3\t6\r\n", CreateInt32WizardData(2, true, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::INCONSISTENT_COLS)
+    }
+
+    // An empty line has no tokens when the line is split at delimiters. Without delimiters the empty line is
+    // the only token, which does not convert to a number.
+    {
+      AbstractFilter::Pointer importASCIIData = ImportRawFile("1\n\n3\n", CreateInt32WizardData(1, true, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::INCONSISTENT_COLS)
+
+      importASCIIData = ImportRawFile("1\n\n3\n", CreateInt32WizardData(1, false, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::CONVERSION_FAILURE)
+
+      importASCIIData = ImportRawFile("1\r\n\r\n3\r\n", CreateInt32WizardData(1, false, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::CONVERSION_FAILURE)
+    }
+
+    // A file that ends before the last line reads the missing lines as empty lines
+    {
+      AbstractFilter::Pointer importASCIIData = ImportRawFile("1\t4\n2\t5\n", CreateInt32WizardData(2, true, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::INCONSISTENT_COLS)
+
+      importASCIIData = ImportRawFile("1\n2\n", CreateInt32WizardData(1, false, 3));
+      DREAM3D_REQUIRE_EQUAL(importASCIIData->getErrorCondition(), ReadASCIIData::CONVERSION_FAILURE)
+    }
+
+    RemoveTestFiles();
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -444,6 +590,8 @@ public:
     DREAM3D_REGISTER_TEST(RemoveTestFiles()) // In case the previous test asserted or stopped prematurely
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(TestLineEndings())
+    DREAM3D_REGISTER_TEST(TestLineErrors())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
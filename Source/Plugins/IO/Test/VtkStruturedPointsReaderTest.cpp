@@ -33,6 +33,8 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -41,6 +43,8 @@
 #include "SIMPLib/Common/FilterManager.h"
 #include "SIMPLib/Common/FilterPipeline.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/SIMPLib.h"
@@ -51,11 +55,6 @@
 
 #include "GenerateFeatureIds.h"
 
-#define mxa_bswap(s, d, t)                                                                                                                                                                             \
-  t[0] = ptr[s];                                                                                                                                                                                       \
-  ptr[s] = ptr[d];                                                                                                                                                                                     \
-  ptr[d] = t[0];
-
 class VtkStruturedPointsReaderTest
 {
 public:
@@ -75,6 +74,8 @@ public:
 #if REMOVE_TEST_FILES
     QFile::remove(UnitTest::VtkStructuredPointsReaderTest::BinaryFile);
     QFile::remove(UnitTest::VtkStructuredPointsReaderTest::AsciiFile);
+    QFile::remove(UnitTest::VtkStructuredPointsReaderTest::SmallAsciiFile);
+    QFile::remove(UnitTest::VtkStructuredPointsReaderTest::BadAsciiFile);
 #endif
   }
 
@@ -117,18 +118,11 @@ public:
       {
         data[i] = static_cast<T>(i);
 
+        // VTK binary files are big endian
         char* ptr = (char*)(dPtr + i);
         if(BIGENDIAN == 0)
         {
-          if(sizeof(T) == 4)
-          {
-            mxa_bswap(0, 3, ptr);
-            mxa_bswap(1, 2, ptr);
-          }
-          if(sizeof(T) == 2)
-          {
-            mxa_bswap(0, 1, ptr);
-          }
+          std::reverse(ptr, ptr + sizeof(T));
         }
       }
       // write to file
@@ -225,36 +219,103 @@ public:
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
-  void ReadTestFile(const std::string& filePath)
+  AbstractFilter::Pointer CreateReader(const QString& filePath, bool readPointData, bool readCellData)
   {
-    DataContainerArray::Pointer dca = DataContainerArray::New();
-
-    // Now instantiate the PhWriter Filter from the FilterManager
+    // Now instantiate the VtkStructuredPointsReader Filter from the FilterManager
     QString filtName = "VtkStructuredPointsReader";
     FilterManager* fm = FilterManager::Instance();
     IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
-    if(nullptr != filterFactory.get())
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(DataContainerArray::New());
+
+    QVariant var;
+    var.setValue(filePath);
+    bool propWasSet = filter->setProperty("InputFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(readPointData);
+    propWasSet = filter->setProperty("ReadPointData", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(readCellData);
+    propWasSet = filter->setProperty("ReadCellData", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void CheckScalars(AttributeMatrix::Pointer attrMat, const QString& name, size_t xDim)
+  {
+    typename DataArray<T>::Pointer data = attrMat->getAttributeArrayAs<DataArray<T>>(name);
+    DREAM3D_REQUIRE_VALID_POINTER(data.get())
+    DREAM3D_REQUIRE_EQUAL(data->getNumberOfTuples(), attrMat->getNumberOfTuples())
+
+    // Every row of the written volume holds 0, 1, ... xDim-1
+    size_t numValues = data->getNumberOfTuples();
+    for(size_t i = 0; i < numValues; i++)
     {
-      // If we get this far, the Factory is good so creating the filter should not fail unless something has
-      // horribly gone wrong in which case the system is going to come down quickly after this.
-      AbstractFilter::Pointer filter = filterFactory->create();
-      filter->setDataContainerArray(dca);
+      DREAM3D_REQUIRE_EQUAL(data->getValue(i), static_cast<T>(i % xDim))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckDataSection(DataContainerArray::Pointer dca, const QString& dcName, size_t xDim)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+    AttributeMatrix::Pointer attrMat = dc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(attrMat.get())
+    DREAM3D_REQUIRE_EQUAL(attrMat->getNumAttributeArrays(), 10)
+
+    CheckScalars<quint8>(attrMat, "Data_uint8", xDim);
+    CheckScalars<qint8>(attrMat, "Data_int8", xDim);
+    CheckScalars<quint16>(attrMat, "Data_uint16", xDim);
+    CheckScalars<qint16>(attrMat, "Data_int16", xDim);
+    CheckScalars<quint32>(attrMat, "Data_uint32", xDim);
+    CheckScalars<qint32>(attrMat, "Data_int32", xDim);
+    CheckScalars<quint64>(attrMat, "Data_uint64", xDim);
+    CheckScalars<qint64>(attrMat, "Data_int64", xDim);
+    CheckScalars<float>(attrMat, "Data_float", xDim);
+    CheckScalars<double>(attrMat, "Data_double", xDim);
+  }
 
-      QVariant var;
-      var.setValue(QString::fromStdString(filePath));
-      bool propWasSet = filter->setProperty("InputFile", var);
-      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void ReadTestFile(const QString& filePath, bool readPointData, bool readCellData)
+  {
+    AbstractFilter::Pointer filter = CreateReader(filePath, readPointData, readCellData);
 
-      filter->preflight();
-      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+    filter->preflight();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
 
-      filter->setDataContainerArray(DataContainerArray::New());
+    filter->setDataContainerArray(DataContainerArray::New());
 
-      filter->execute();
-      DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
-      dca = filter->getDataContainerArray();
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+    DataContainerArray::Pointer dca = filter->getDataContainerArray();
 
-      // Need to actually check the data against what _should_ have been written
+    // The point data section comes first in the file, so reading only the cell data also checks
+    // that the point data section was skipped correctly
+    if(readPointData)
+    {
+      CheckDataSection(dca, "ImageDataContainer_PointData", 10);
+    }
+    else
+    {
+      DREAM3D_REQUIRE(dca->getDataContainer("ImageDataContainer_PointData").get() == nullptr)
+    }
+    if(readCellData)
+    {
+      CheckDataSection(dca, "ImageDataContainer_CellData", 9);
+    }
+    else
+    {
+      DREAM3D_REQUIRE(dca->getDataContainer("ImageDataContainer_CellData").get() == nullptr)
     }
   }
 
@@ -263,7 +324,69 @@ public:
   // -----------------------------------------------------------------------------
   void TestReadingFiles()
   {
-    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::BinaryFile.toStdString());
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::BinaryFile, true, true);
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::BinaryFile, true, false);
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::BinaryFile, false, true);
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::AsciiFile, true, true);
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::AsciiFile, true, false);
+    ReadTestFile(UnitTest::VtkStructuredPointsReaderTest::AsciiFile, false, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteSmallAsciiFile(const QString& filePath, const char* charValues)
+  {
+    FILE* f = fopen(filePath.toStdString().c_str(), "wb");
+    int dims[3] = {4, 2, 2};
+    float origin[3] = {0.0f, 0.0f, 0.0f};
+    float scaling[3] = {1.0f, 1.0f, 1.0f};
+    WriteHeader(f, false, dims, origin, scaling);
+
+    // Decimal values, CRLF line endings and values split over lines with extra white space
+    fprintf(f, "CELL_DATA 3\n");
+    fprintf(f, "SCALARS Data_float float 1\n");
+    fprintf(f, "LOOKUP_TABLE default\n");
+    fprintf(f, "0.25 -1.5\r\n\r\n  2e3\r\n");
+    fprintf(f, "SCALARS Data_int8 char 1\n");
+    fprintf(f, "LOOKUP_TABLE default\n");
+    fprintf(f, "%s\n", charValues);
+    fclose(f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReadingAsciiValues()
+  {
+    // char values are numbers in the file, not single characters
+    WriteSmallAsciiFile(UnitTest::VtkStructuredPointsReaderTest::SmallAsciiFile, "-5 12 127");
+    AbstractFilter::Pointer filter = CreateReader(UnitTest::VtkStructuredPointsReaderTest::SmallAsciiFile, false, true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    AttributeMatrix::Pointer attrMat = filter->getDataContainerArray()->getDataContainer("ImageDataContainer_CellData")->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    FloatArrayType::Pointer floats = attrMat->getAttributeArrayAs<FloatArrayType>("Data_float");
+    DREAM3D_REQUIRE_VALID_POINTER(floats.get())
+    DREAM3D_REQUIRE_EQUAL(floats->getValue(0), 0.25f)
+    DREAM3D_REQUIRE_EQUAL(floats->getValue(1), -1.5f)
+    DREAM3D_REQUIRE_EQUAL(floats->getValue(2), 2000.0f)
+    Int8ArrayType::Pointer chars = attrMat->getAttributeArrayAs<Int8ArrayType>("Data_int8");
+    DREAM3D_REQUIRE_VALID_POINTER(chars.get())
+    DREAM3D_REQUIRE_EQUAL(chars->getValue(0), -5)
+    DREAM3D_REQUIRE_EQUAL(chars->getValue(1), 12)
+    DREAM3D_REQUIRE_EQUAL(chars->getValue(2), 127)
+
+    // A token that is not a number, or a value that does not fit the type, is an error instead of a 0
+    WriteSmallAsciiFile(UnitTest::VtkStructuredPointsReaderTest::BadAsciiFile, "-5 abc 127");
+    filter = CreateReader(UnitTest::VtkStructuredPointsReaderTest::BadAsciiFile, false, true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), <, 0);
+
+    WriteSmallAsciiFile(UnitTest::VtkStructuredPointsReaderTest::BadAsciiFile, "-5 12 300");
+    filter = CreateReader(UnitTest::VtkStructuredPointsReaderTest::BadAsciiFile, false, true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), <, 0);
   }
 
   /**
@@ -274,6 +397,8 @@ public:
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestWritingFiles());
     DREAM3D_REGISTER_TEST(TestReadingFiles());
+    DREAM3D_REGISTER_TEST(TestReadingAsciiValues());
+    DREAM3D_REGISTER_TEST(RemoveTestFiles());
   }
 
 private:
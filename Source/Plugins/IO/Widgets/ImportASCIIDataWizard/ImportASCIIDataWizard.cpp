@@ -205,6 +205,23 @@ QString ImportASCIIDataWizard::ReadLine(const QString& inputFilePath, int line)
   return lines[0];
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ImportASCIIDataWizard::ReadNextLine(QTextStream& in, QStringList& pendingLines)
+{
+  if(pendingLines.isEmpty())
+  {
+    QString line = in.readLine();
+    if(line.isNull() == true || line.contains('\r') == false)
+    {
+      return line;
+    }
+    pendingLines = line.split('\r');
+  }
+  return pendingLines.takeFirst();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -219,16 +236,17 @@ QStringList ImportASCIIDataWizard::ReadLines(const QString& inputFilePath, int b
   if(inputFile.open(QIODevice::ReadOnly))
   {
     QTextStream in(&inputFile);
+    QStringList pendingLines;
 
     for(int i = 1; i < beginLine; i++)
     {
       // Skip all lines before "value"
-      in.readLine();
+      ReadNextLine(in, pendingLines);
     }
 
     for(int i = beginLine; i < beginLine + numOfLines; i++)
     {
-      QString line = in.readLine();
+      QString line = ReadNextLine(in, pendingLines);
       result.push_back(line);
     }
     inputFile.close();
@@ -37,6 +37,7 @@
 #ifndef _importasciidatawizard_h_
 #define _importasciidatawizard_h_
 
+#include <QtCore/QTextStream>
 #include <QtWidgets/QWizard>
 
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -104,6 +105,14 @@ class ImportASCIIDataWizard : public QWizard
     */
     static QString ReadLine(const QString &inputFilePath, int line);
 
+    /**
+    * @brief Static function that reads the next line from a stream. QTextStream only ends lines at "\n" and "\r\n", so
+    * a line it returns is split again at each lone '\r' and the lines after the first are kept for the following calls.
+    * @param in The stream to read from
+    * @param pendingLines Lines already split off that have not been returned yet
+    */
+    static QString ReadNextLine(QTextStream& in, QStringList& pendingLines);
+
     /**
     * @brief Static function that loads lines into the table objects.  The full lines are stored in the ASCIIDataItem object that backs up each table item, and are not actually displayed in the table yet.
     * @param inputFilePath The path to the file to load
@@ -115,12 +115,13 @@ void LineCounterObject::run()
   }
 
   int64_t currentByte = 0;
+  char previousChar = '\0';
   while(qFile.atEnd() == false)
   {
     // Copy the file contents into the buffer
     result = qFile.read(buffer, actualSize);
 
-    // Check the buffer for new lines and carriage returns
+    // Check the buffer for new lines and carriage returns. A line ends with "\n", "\r\n" or a lone '\r'.
     int64_t fiveThresh = fileSize / 20.0;
     int64_t currentThresh = fiveThresh;
     for(int i = 0; i < result; i++)
@@ -137,13 +138,17 @@ void LineCounterObject::run()
 
       if(currentChar == '\n')
       {
-        m_NumOfLines++;
+        // The '\n' of a "\r\n" was counted with its '\r', which may be in the previous buffer
+        if(previousChar != '\r')
+        {
+          m_NumOfLines++;
+        }
       }
-      else if(currentChar == '\r' && i + 1 < actualSize && buffer[i + 1] == '\n')
+      else if(currentChar == '\r')
       {
         m_NumOfLines++;
-        i++;
       }
+      previousChar = currentChar;
     }
   }
 
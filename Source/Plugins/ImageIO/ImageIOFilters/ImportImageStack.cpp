@@ -35,8 +35,17 @@
 
 #include "ImportImageStack.h"
 
+#include <algorithm>
+
 #include <QtGui/QImageReader>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
@@ -52,6 +61,100 @@
 #include "ImageIO/ImageIOConstants.h"
 #include "ImageIO/ImageIOVersion.h"
 
+/**
+ * @brief The ImportImageStackImpl class implements a threaded algorithm that decodes a range of image
+ * files and copies each one directly into its own z slice of the output array. Each slice records its
+ * own error code so the calling thread can report the first failure.
+ */
+class ImportImageStackImpl
+{
+  const QVector<QString>* m_FileList;
+  uint8_t* m_Data;
+  size_t m_Width;
+  size_t m_Height;
+  size_t m_PixelBytes;
+  int32_t* m_SliceErrors;
+
+public:
+  ImportImageStackImpl(const QVector<QString>* fileList, uint8_t* data, size_t width, size_t height, size_t pixelBytes, int32_t* sliceErrors)
+  : m_FileList(fileList)
+  , m_Data(data)
+  , m_Width(width)
+  , m_Height(height)
+  , m_PixelBytes(pixelBytes)
+  , m_SliceErrors(sliceErrors)
+  {
+  }
+  virtual ~ImportImageStackImpl()
+  {
+  }
+
+  /**
+   * @brief copySlice Copies a decoded image into slice z of the output array
+   * @return 0 on success or a negative error code if the image does not match the first image of the stack
+   */
+  int32_t copySlice(const QImage& image, size_t z) const
+  {
+    if(static_cast<size_t>(image.width()) != m_Width || static_cast<size_t>(image.height()) != m_Height || static_cast<size_t>(image.depth()) != 8 * m_PixelBytes)
+    {
+      return -14001;
+    }
+
+    uint8_t* slicePtr = m_Data + z * m_Width * m_Height * m_PixelBytes;
+    if(m_PixelBytes == 1)
+    {
+      // Grayscale and indexed pixels are copied as they were decoded
+      for(size_t i = 0; i < m_Height; ++i)
+      {
+        ::memcpy(slicePtr + i * m_Width, image.constScanLine(static_cast<int>(i)), m_Width);
+      }
+      return 0;
+    }
+
+#if defined(CMP_WORDS_BIGENDIAN)
+#error
+#else
+    // We need to convert from Little Endian based ARGB to a physical RGB layout. This swaps the
+    // red and blue bytes while copying instead of making a swapped copy of the whole image first.
+    for(size_t i = 0; i < m_Height; ++i)
+    {
+      const uint8_t* source = image.constScanLine(static_cast<int>(i));
+      uint8_t* dest = slicePtr + i * m_Width * 4;
+      for(size_t j = 0; j < m_Width; ++j)
+      {
+        dest[4 * j] = source[4 * j + 2];
+        dest[4 * j + 1] = source[4 * j + 1];
+        dest[4 * j + 2] = source[4 * j];
+        dest[4 * j + 3] = source[4 * j + 3];
+      }
+    }
+#endif
+    return 0;
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t z = start; z < end; z++)
+    {
+      QImageReader reader(m_FileList->at(static_cast<int>(z)));
+      QImage image;
+      if(reader.read(&image) == false || image.isNull() == true)
+      {
+        m_SliceErrors[z] = -14000;
+        continue;
+      }
+      m_SliceErrors[z] = copySlice(image, z);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_ImportImageStack.cpp"
 
@@ -366,10 +469,6 @@ void ImportImageStack::execute()
   }
   UInt8ArrayType::Pointer data = UInt8ArrayType::NullPointer();
 
-  uint8_t* imagePtr = nullptr;
-
-  int64_t z = m_InputFileListInfo.StartIndex;
-  int64_t zSpot = 0;
   size_t pixelBytes = 0; // MUST BE Defined & Initialized out here.
   bool hasMissingFiles = false;
   bool orderAscending = false;
@@ -391,84 +490,128 @@ void ImportImageStack::execute()
     QString ss = QObject::tr("No files have been selected for import");
     setErrorCondition(-11);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
 
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
+  // The first image sets the dimensions and pixel format of the whole stack
+  QString ss = QObject::tr("Importing file %1").arg(fileList[0]);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  QImageReader reader(fileList[0]);
+  const QImage::Format format = reader.imageFormat();
+  QImage image;
+  if(reader.read(&image) == false || image.isNull() == true)
   {
-    QString imageFName = *filepath;
-    QString ss = QObject::tr("Importing file %1").arg(imageFName);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    QImageReader reader(imageFName);
-    QImage image(imageFName);
-    if(image.isNull() == true)
-    {
-      setErrorCondition(-14000);
-      notifyErrorMessage(getHumanLabel(), "Failed to load image file", getErrorCondition());
-      return;
-    }
-#if defined(CMP_WORDS_BIGENDIAN)
-#error
+    setErrorCondition(-14000);
+    notifyErrorMessage(getHumanLabel(), "Failed to load image file", getErrorCondition());
+    return;
+  }
+  size_t height = static_cast<size_t>(image.height());
+  size_t width = static_cast<size_t>(image.width());
+
+  if(m_GeometryType == 0)
+  {
+    m->getGeometryAs<ImageGeom>()->setDimensions(width, height, fileList.size());
+  }
+  else if(m_GeometryType == 1)
+  {
+    m->getGeometryAs<RectGridGeom>()->setDimensions(width, height, fileList.size());
+  }
+
+  switch(format)
+  {
+  case QImage::Format_Indexed8:
+#if(QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
+  case QImage::Format_Grayscale8:
+#endif
+    pixelBytes = 1;
+    break;
+  case QImage::Format_RGB32:
+  case QImage::Format_ARGB32:
+    pixelBytes = 4;
+    break;
+  default:
+    pixelBytes = 0;
+  }
+
+  if(pixelBytes == 0)
+  {
+    ss = QObject::tr("Image format is of unsupported type (QImage::Format=%1). Imported images must be either grayscale, RGB, or ARGB").arg(format);
+    setErrorCondition(-4400);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QVector<size_t> cDims(1, pixelBytes);
+
+  data = UInt8ArrayType::CreateArray(size_t(fileList.size()) * height * width, cDims, m_ImageDataArrayName);
+  data->initializeWithValue(128);
+
+  QVector<int32_t> sliceErrors(fileList.size(), 0);
+  ImportImageStackImpl importer(&fileList, data->getPointer(0), width, height, pixelBytes, sliceErrors.data());
+  sliceErrors[0] = importer.copySlice(image, 0);
+  if(sliceErrors[0] < 0)
+  {
+    // The first image sets the dimensions, so only its decoded pixel depth can disagree with the format the reader reported
+    setErrorCondition(sliceErrors[0]);
+    ss = QObject::tr("Image file %1 reported QImage::Format=%2 but decoded as QImage::Format=%3 with %4 bits per pixel. Imported images must be either grayscale, RGB, or ARGB")
+             .arg(fileList[0])
+             .arg(format)
+             .arg(image.format())
+             .arg(image.depth());
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  image = QImage();
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  // Bound the number of decoded images held in memory at once
+  size_t slicesPerChunk = static_cast<size_t>(2 * tbb::task_scheduler_init::default_num_threads());
 #else
-    // We need to convert from Little Endian based ARGB to a physical RGB layout
-    image = image.rgbSwapped();
+  size_t slicesPerChunk = 1;
 #endif
-    size_t height = static_cast<size_t>(image.height());
-    size_t width = static_cast<size_t>(image.width());
-    size_t totalPixels = width * height;
 
-    // This is the first image so we need to create our block of data to store the data
-    if(z == m_InputFileListInfo.StartIndex)
+  size_t numSlices = static_cast<size_t>(fileList.size());
+  for(size_t z = 0; z < numSlices; z += slicesPerChunk)
+  {
+    size_t zStart = (z == 0) ? 1 : z;
+    size_t zEnd = std::min(z + slicesPerChunk, numSlices);
+    if(zStart < zEnd)
     {
-      if(m_GeometryType == 0)
+      ss = QObject::tr("Importing files %1 to %2 of %3").arg(zStart + 1).arg(zEnd).arg(numSlices);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
       {
-        m->getGeometryAs<ImageGeom>()->setDimensions(width, height, fileList.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(zStart, zEnd, 1), importer, tbb::auto_partitioner());
       }
-      else if(m_GeometryType == 1)
+      else
+#endif
       {
-        m->getGeometryAs<RectGridGeom>()->setDimensions(width, height, fileList.size());
+        importer.generate(zStart, zEnd);
       }
+    }
 
-      const QImage::Format format = reader.imageFormat();
-      switch(format)
+    for(size_t i = z; i < zEnd; i++)
+    {
+      if(sliceErrors[static_cast<int>(i)] == -14000)
       {
-      case QImage::Format_Indexed8:
-#if(QT_VERSION >= QT_VERSION_CHECK(5, 5, 0))
-      case QImage::Format_Grayscale8:
-#endif
-        pixelBytes = 1;
-        break;
-      case QImage::Format_RGB32:
-      case QImage::Format_ARGB32:
-        pixelBytes = 4;
-        break;
-      default:
-        pixelBytes = 0;
+        setErrorCondition(-14000);
+        ss = QObject::tr("Failed to load image file %1").arg(fileList[static_cast<int>(i)]);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
       }
-
-      if(pixelBytes == 0)
+      if(sliceErrors[static_cast<int>(i)] < 0)
       {
-        ss = QObject::tr("Image format is of unsupported type (QImage::Format=%1). Imported images must be either grayscale, RGB, or ARGB").arg(format);
-        setErrorCondition(-4400);
+        setErrorCondition(sliceErrors[static_cast<int>(i)]);
+        ss = QObject::tr("Image file %1 does not have the same dimensions or pixel format as the first image of the stack").arg(fileList[static_cast<int>(i)]);
         notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
         return;
       }
-
-      QVector<size_t> cDims(1, pixelBytes);
-
-      data = UInt8ArrayType::CreateArray(size_t(fileList.size()) * height * width, cDims, m_ImageDataArrayName);
-      data->initializeWithValue(128);
-    }
-
-    // Get the current position in the array to copy the image into
-    zSpot = (z - m_InputFileListInfo.StartIndex);
-    for(size_t i = 0; i < height; ++i)
-    {
-      imagePtr = data->getPointer((zSpot)*totalPixels * pixelBytes + i * (width * pixelBytes));
-      uint8_t* source = image.scanLine(i);
-      ::memcpy(imagePtr, source, width * pixelBytes);
     }
 
-    ++z;
     if(getCancel() == true)
     {
       return;
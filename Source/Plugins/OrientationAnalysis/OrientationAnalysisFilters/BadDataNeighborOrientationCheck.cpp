@@ -43,6 +43,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/NeighborMisorientationMask.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -236,12 +238,10 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
+  // The quaternions and phases do not change in this filter, so every face is tested once up front
+  NeighborMisorientationMask faceMask(udims, NeighborMisorientationMask::FaceOffsets(), reinterpret_cast<QuatF*>(m_Quats), m_CellPhases, m_CrystalStructures, m_OrientationOps,
+                                      m_MisorientationTolerance);
+  faceMask.compute();
 
   QVector<int32_t> neighborCount(totalPoints, 0);
 
@@ -280,22 +280,9 @@ void BadDataNeighborOrientationCheck::execute()
         {
           good = 0;
         }
-        if(good == 1 && m_GoodVoxels[neighbor] == true)
+        if(good == 1 && m_GoodVoxels[neighbor] == true && faceMask.isWithinTolerance(i, neighbor) == true)
         {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
-
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-          }
-          if(w < m_MisorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
+          neighborCount[i]++;
         }
       }
     }
@@ -347,22 +334,9 @@ void BadDataNeighborOrientationCheck::execute()
             {
               good = 0;
             }
-            if(good == 1 && m_GoodVoxels[neighbor] == false)
+            if(good == 1 && m_GoodVoxels[neighbor] == false && faceMask.isWithinTolerance(i, neighbor) == true)
             {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-              }
-              if(w < m_MisorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
+              neighborCount[neighbor]++;
             }
           }
         }
@@ -35,8 +35,16 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -48,6 +56,286 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class computes the kernel average misorientation for
+ * rectangular tiles of the volume. Tiles are independent and are walked in memory order. When
+ * reuse is enabled, the misorientation of each Cell pair that lies inside a tile, belongs to the same
+ * Feature and shares a crystal structure is computed once and used by both Cells of the pair.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(int32_t* featureIds, int32_t* cellPhases, QuatF* quats, uint32_t* crystalStructures, float* kam, int64_t dims[3], IntVec3_t kernelSize,
+                                   QVector<SpaceGroupOps::Pointer> orientationOps, bool reuse)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_KernelAverageMisorientations(kam)
+  , m_OrientationOps(orientationOps)
+  , m_Reuse(reuse)
+  , m_NumPairSlots(0)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+    }
+
+    // The offsets are visited in the same order as the per Cell summation
+    for(int32_t j = -kernelSize.z; j < kernelSize.z + 1; j++)
+    {
+      for(int32_t k = -kernelSize.y; k < kernelSize.y + 1; k++)
+      {
+        for(int32_t l = -kernelSize.x; l < kernelSize.z + 1; l++)
+        {
+          KernelOffset_t offset;
+          offset.dz = j;
+          offset.dy = k;
+          offset.dx = l;
+          offset.stride = (j * m_Dims[0] * m_Dims[1]) + (k * m_Dims[0]) + l;
+          offset.slot = -1;
+          offset.owner = false;
+          m_Offsets.push_back(offset);
+        }
+      }
+    }
+
+    // Pair each offset with its opposite; the first of the two owns the shared slot
+    for(size_t i = 0; i < m_Offsets.size(); i++)
+    {
+      if(m_Offsets[i].slot >= 0)
+      {
+        continue;
+      }
+      for(size_t n = i + 1; n < m_Offsets.size(); n++)
+      {
+        if(m_Offsets[n].dz == -m_Offsets[i].dz && m_Offsets[n].dy == -m_Offsets[i].dy && m_Offsets[n].dx == -m_Offsets[i].dx)
+        {
+          m_Offsets[i].slot = m_NumPairSlots;
+          m_Offsets[i].owner = true;
+          m_Offsets[n].slot = m_NumPairSlots;
+          m_NumPairSlots++;
+          break;
+        }
+      }
+    }
+
+    // Keep the per tile pair cache to a few MB
+    int64_t edge = k_MaxTileEdge;
+    if(m_Reuse == true && m_NumPairSlots > 0)
+    {
+      while(edge > k_MinTileEdge && edge * edge * edge * m_NumPairSlots * static_cast<int64_t>(sizeof(float)) > k_MaxPairCacheBytes)
+      {
+        edge = edge / 2;
+      }
+    }
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_TileDims[d] = (m_Dims[d] < edge) ? m_Dims[d] : edge;
+      m_NumTiles[d] = (m_TileDims[d] > 0) ? (m_Dims[d] + m_TileDims[d] - 1) / m_TileDims[d] : 0;
+    }
+  }
+  virtual ~FindKernelAvgMisorientationsImpl()
+  {
+  }
+
+  size_t getNumberOfTiles() const
+  {
+    return static_cast<size_t>(m_NumTiles[0] * m_NumTiles[1] * m_NumTiles[2]);
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    std::vector<float> pairCache;
+    for(size_t t = start; t < end; t++)
+    {
+      int64_t tile = static_cast<int64_t>(t);
+      int64_t lo[3] = {0, 0, 0};
+      int64_t hi[3] = {0, 0, 0};
+      lo[0] = (tile % m_NumTiles[0]) * m_TileDims[0];
+      lo[1] = ((tile / m_NumTiles[0]) % m_NumTiles[1]) * m_TileDims[1];
+      lo[2] = (tile / (m_NumTiles[0] * m_NumTiles[1])) * m_TileDims[2];
+      for(int32_t d = 0; d < 3; d++)
+      {
+        hi[d] = (lo[d] + m_TileDims[d] < m_Dims[d]) ? lo[d] + m_TileDims[d] : m_Dims[d];
+      }
+      computeTile(lo, hi, pairCache);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  static const int64_t k_MaxTileEdge = 32;
+  static const int64_t k_MinTileEdge = 4;
+  static const int64_t k_MaxPairCacheBytes = 4 * 1024 * 1024;
+
+  typedef struct
+  {
+    int64_t dz;
+    int64_t dy;
+    int64_t dx;
+    int64_t stride;
+    int32_t slot;
+    bool owner;
+  } KernelOffset_t;
+
+  int32_t* m_FeatureIds;
+  int32_t* m_CellPhases;
+  QuatF* m_Quats;
+  uint32_t* m_CrystalStructures;
+  float* m_KernelAverageMisorientations;
+  QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+  bool m_Reuse;
+  int32_t m_NumPairSlots;
+  int64_t m_Dims[3];
+  int64_t m_TileDims[3];
+  int64_t m_NumTiles[3];
+  std::vector<KernelOffset_t> m_Offsets;
+
+  bool isKernelCenter(int64_t point) const
+  {
+    return (m_FeatureIds[point] > 0 && m_CellPhases[point] > 0);
+  }
+
+  /**
+   * @brief Returns true if the misorientation between the two Cells is shared through the pair cache.
+   * The test is symmetric so both Cells of a pair reach the same answer.
+   */
+  bool isSharedPair(int64_t point, int64_t neighbor, const int64_t nPos[3], const int64_t lo[3], const int64_t hi[3]) const
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      if(nPos[d] < lo[d] || nPos[d] >= hi[d])
+      {
+        return false;
+      }
+    }
+    if(isKernelCenter(neighbor) == false || m_FeatureIds[point] != m_FeatureIds[neighbor])
+    {
+      return false;
+    }
+    return m_CrystalStructures[m_CellPhases[point]] == m_CrystalStructures[m_CellPhases[neighbor]];
+  }
+
+  float misorientation(int64_t point, int64_t neighbor) const
+  {
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    QuaternionMathF::Copy(m_Quats[point], q1);
+    QuaternionMathF::Copy(m_Quats[neighbor], q2);
+    uint32_t phase1 = m_CrystalStructures[m_CellPhases[point]];
+    float w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+    w = w * (180.0f / SIMPLib::Constants::k_Pi);
+    return w;
+  }
+
+  void computeTile(const int64_t lo[3], const int64_t hi[3], std::vector<float>& pairCache) const
+  {
+    int64_t tileX = hi[0] - lo[0];
+    int64_t tileY = hi[1] - lo[1];
+    int64_t tileZ = hi[2] - lo[2];
+    bool reuse = (m_Reuse == true && m_NumPairSlots > 0);
+    int64_t nPos[3] = {0, 0, 0};
+
+    if(reuse == true)
+    {
+      pairCache.resize(static_cast<size_t>(tileX * tileY * tileZ * m_NumPairSlots));
+      for(int64_t plane = lo[2]; plane < hi[2]; plane++)
+      {
+        for(int64_t row = lo[1]; row < hi[1]; row++)
+        {
+          for(int64_t col = lo[0]; col < hi[0]; col++)
+          {
+            int64_t point = (plane * m_Dims[0] * m_Dims[1]) + (row * m_Dims[0]) + col;
+            if(isKernelCenter(point) == false)
+            {
+              continue;
+            }
+            float* cache = &(pairCache[static_cast<size_t>((((plane - lo[2]) * tileY + (row - lo[1])) * tileX + (col - lo[0])) * m_NumPairSlots)]);
+            for(std::vector<KernelOffset_t>::const_iterator iter = m_Offsets.begin(); iter != m_Offsets.end(); ++iter)
+            {
+              if(iter->owner == false)
+              {
+                continue;
+              }
+              nPos[0] = col + iter->dx;
+              nPos[1] = row + iter->dy;
+              nPos[2] = plane + iter->dz;
+              int64_t neighbor = point + iter->stride;
+              if(isSharedPair(point, neighbor, nPos, lo, hi) == true)
+              {
+                cache[iter->slot] = misorientation(point, neighbor);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for(int64_t plane = lo[2]; plane < hi[2]; plane++)
+    {
+      for(int64_t row = lo[1]; row < hi[1]; row++)
+      {
+        for(int64_t col = lo[0]; col < hi[0]; col++)
+        {
+          int64_t point = (plane * m_Dims[0] * m_Dims[1]) + (row * m_Dims[0]) + col;
+          if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+          {
+            m_KernelAverageMisorientations[point] = 0.0f;
+            continue;
+          }
+          if(isKernelCenter(point) == false)
+          {
+            continue;
+          }
+          float totalmisorientation = 0.0f;
+          int32_t numVoxel = 0;
+          for(std::vector<KernelOffset_t>::const_iterator iter = m_Offsets.begin(); iter != m_Offsets.end(); ++iter)
+          {
+            nPos[0] = col + iter->dx;
+            nPos[1] = row + iter->dy;
+            nPos[2] = plane + iter->dz;
+            if(nPos[0] < 0 || nPos[0] > m_Dims[0] - 1 || nPos[1] < 0 || nPos[1] > m_Dims[1] - 1 || nPos[2] < 0 || nPos[2] > m_Dims[2] - 1)
+            {
+              continue;
+            }
+            int64_t neighbor = point + iter->stride;
+            if(m_FeatureIds[point] != m_FeatureIds[neighbor])
+            {
+              continue;
+            }
+            float w = 0.0f;
+            if(reuse == true && iter->slot >= 0 && isSharedPair(point, neighbor, nPos, lo, hi) == true)
+            {
+              int64_t owner = iter->owner ? point : neighbor;
+              int64_t ownerPos[3] = {owner % m_Dims[0], (owner / m_Dims[0]) % m_Dims[1], owner / (m_Dims[0] * m_Dims[1])};
+              w = pairCache[static_cast<size_t>((((ownerPos[2] - lo[2]) * tileY + (ownerPos[1] - lo[1])) * tileX + (ownerPos[0] - lo[0])) * m_NumPairSlots + iter->slot)];
+            }
+            else
+            {
+              w = misorientation(point, neighbor);
+            }
+            totalmisorientation = totalmisorientation + w;
+            numVoxel++;
+          }
+          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
+          if(numVoxel == 0)
+          {
+            m_KernelAverageMisorientations[point] = 0.0f;
+          }
+        }
+      }
+    }
+  }
+};
+
 // Include the MOC generated file for this class
 #include "moc_FindKernelAvgMisorientations.cpp"
 
@@ -61,6 +349,7 @@ FindKernelAvgMisorientations::FindKernelAvgMisorientations()
 , m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_KernelAverageMisorientationsArrayName(SIMPL::CellData::KernelAverageMisorientations)
+, m_ReuseSymmetricMisorientations(false)
 , m_FeatureIds(nullptr)
 , m_CellPhases(nullptr)
 , m_Quats(nullptr)
@@ -90,6 +379,7 @@ void FindKernelAvgMisorientations::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Kernel Radius", KernelSize, FilterParameter::Parameter, FindKernelAvgMisorientations));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Reuse Symmetric Misorientations", ReuseSymmetricMisorientations, FilterParameter::Parameter, FindKernelAvgMisorientations));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
 
   {
@@ -128,6 +418,7 @@ void FindKernelAvgMisorientations::readFilterParameters(AbstractFilterParameters
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setKernelSize(reader->readIntVec3("KernelSize", getKernelSize()));
+  setReuseSymmetricMisorientations(reader->readValue("ReuseSymmetricMisorientations", getReuseSymmetricMisorientations()));
   reader->closeFilterGroup();
 }
 
@@ -230,100 +521,27 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+  int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
+  FindKernelAvgMisorientationsImpl serial(m_FeatureIds, m_CellPhases, reinterpret_cast<QuatF*>(m_Quats), m_CrystalStructures, m_KernelAverageMisorientations, dims, m_KernelSize, m_OrientationOps,
+                                          m_ReuseSymmetricMisorientations);
 
-  for(int64_t col = 0; col < xPoints; col++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    for(int64_t row = 0; row < yPoints; row++)
-    {
-      for(int64_t plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, serial.getNumberOfTiles()), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.generate(0, serial.getNumberOfTiles());
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
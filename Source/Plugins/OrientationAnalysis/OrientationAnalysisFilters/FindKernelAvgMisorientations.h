@@ -75,6 +75,9 @@ class FindKernelAvgMisorientations : public AbstractFilter
     SIMPL_FILTER_PARAMETER(IntVec3_t, KernelSize)
     Q_PROPERTY(IntVec3_t KernelSize READ getKernelSize WRITE setKernelSize)
 
+    SIMPL_FILTER_PARAMETER(bool, ReuseSymmetricMisorientations)
+    Q_PROPERTY(bool ReuseSymmetricMisorientations READ getReuseSymmetricMisorientations WRITE setReuseSymmetricMisorientations)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
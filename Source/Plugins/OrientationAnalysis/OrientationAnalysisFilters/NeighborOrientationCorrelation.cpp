@@ -43,6 +43,9 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/NeighborMisorientationMask.hpp"
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -245,16 +248,16 @@ void NeighborOrientationCorrelation::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  QVector<int32_t> neighborDiffCount(totalPoints, 0);
   QVector<int32_t> neighborSimCount(6, 0);
   QVector<int64_t> bestNeighbor(totalPoints, -1);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+
+  // Every pair of face neighbors of a Cell is separated by one of these offsets. The pairs are tested once up
+  // front and then again only where the copies of the previous level changed a Cell.
+  NeighborMisorientationMask pairMask(udims, NeighborMisorientationMask::FaceNeighborPairOffsets(), reinterpret_cast<QuatF*>(m_Quats), m_CellPhases, m_CrystalStructures,
+                                      m_OrientationOps, misorientationToleranceR);
+  pairMask.compute();
+  std::vector<uint8_t> changed(totalPoints, 0);
+  bool maskIsStale = false;
 
   int32_t startLevel = 6;
   for(int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
@@ -264,6 +267,13 @@ void NeighborOrientationCorrelation::execute()
       break;
     }
 
+    if(maskIsStale == true)
+    {
+      pairMask.update(changed);
+      changed.assign(totalPoints, 0);
+      maskIsStale = false;
+    }
+
     int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
     int64_t prog = 1;
     int64_t progressInt = 0;
@@ -313,20 +323,6 @@ void NeighborOrientationCorrelation::execute()
           }
           if(good == true)
           {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
-
-            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-            {
-              w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-            }
-            if(w > misorientationToleranceR)
-            {
-              neighborDiffCount[i]++;
-            }
             for(int32_t k = j + 1; k < 6; k++)
             {
               good2 = true;
@@ -355,22 +351,10 @@ void NeighborOrientationCorrelation::execute()
               {
                 good2 = false;
               }
-              if(good2 == true)
+              if(good2 == true && pairMask.isWithinTolerance(neighbor2, neighbor) == true)
               {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                }
-                if(w < misorientationToleranceR)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
+                neighborSimCount[j]++;
+                neighborSimCount[k]++;
               }
             }
           }
@@ -417,7 +401,7 @@ void NeighborOrientationCorrelation::execute()
       }
     }
     QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    TupleTransferMap transferMap(totalPoints);
 
     if(getCancel())
     {
@@ -439,13 +423,12 @@ void NeighborOrientationCorrelation::execute()
       neighbor = bestNeighbor[i];
       if(neighbor != -1)
       {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-          p->copyTuple(neighbor, i);
-        }
+        transferMap.addCopy(neighbor, i);
+        changed[i] = 1;
+        maskIsStale = true;
       }
     }
+    transferMap.apply(m->getAttributeMatrix(attrMatName));
     currentLevel = currentLevel - 1;
   }
 
@@ -37,6 +37,11 @@
 
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/FilterManager.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -58,6 +63,104 @@
 // Include the MOC generated file for this class
 #include "moc_ReadH5Ebsd.cpp"
 
+/**
+ * @brief The CopyEbsdSliceImpl class copies the columns of a single slice straight into the
+ * cell arrays of the volume and applies the per voxel phase and Euler angle corrections.
+ * Each instance owns the reader of its slice so the slice data is released as soon as it
+ * has been copied.
+ */
+class CopyEbsdSliceImpl
+{
+public:
+  CopyEbsdSliceImpl(EbsdReader::Pointer reader, size_t sliceOffset, int64_t xpoints, const QVector<EbsdSliceColumn_t>& columns, int32_t* phases, int32_t phaseFloor, float* eulers,
+                    uint32_t* crystalStructures, double hexOffset)
+  : m_Reader(reader)
+  , m_SliceOffset(sliceOffset)
+  , m_XPoints(xpoints)
+  , m_Columns(columns)
+  , m_Phases(phases)
+  , m_PhaseFloor(phaseFloor)
+  , m_Eulers(eulers)
+  , m_CrystalStructures(crystalStructures)
+  , m_HexOffset(hexOffset)
+  {
+  }
+  virtual ~CopyEbsdSliceImpl()
+  {
+  }
+
+  template <typename T> void copyColumn(T* src, T* dest, size_t numComps, size_t comp, T scale) const
+  {
+    int64_t sliceXPoints = m_Reader->getXDimension();
+    int64_t sliceYPoints = m_Reader->getYDimension();
+    size_t readerIndex = 0;
+    for(int64_t j = 0; j < sliceYPoints; j++)
+    {
+      T* destRow = dest + (m_SliceOffset + j * m_XPoints) * numComps + comp;
+      for(int64_t i = 0; i < sliceXPoints; i++)
+      {
+        destRow[i * numComps] = src[readerIndex] * scale;
+        ++readerIndex;
+      }
+    }
+  }
+
+  void operator()() const
+  {
+    for(int32_t c = 0; c < m_Columns.size(); c++)
+    {
+      const EbsdSliceColumn_t& column = m_Columns[c];
+      void* src = m_Reader->getPointerByName(column.name);
+      if(nullptr == src)
+      {
+        continue;
+      }
+      if(m_Reader->getPointerType(column.name) == Ebsd::Int32)
+      {
+        copyColumn<int32_t>(static_cast<int32_t*>(src), static_cast<int32_t*>(column.destination), column.numComps, column.comp, 1);
+      }
+      else
+      {
+        copyColumn<float>(static_cast<float*>(src), static_cast<float*>(column.destination), column.numComps, column.comp, column.scale);
+      }
+    }
+
+    if(nullptr == m_Phases)
+    {
+      return;
+    }
+
+    int64_t sliceXPoints = m_Reader->getXDimension();
+    int64_t sliceYPoints = m_Reader->getYDimension();
+    for(int64_t j = 0; j < sliceYPoints; j++)
+    {
+      size_t index = m_SliceOffset + j * m_XPoints;
+      for(int64_t i = 0; i < sliceXPoints; i++, index++)
+      {
+        if(m_PhaseFloor > 0 && m_Phases[index] < m_PhaseFloor)
+        {
+          m_Phases[index] = m_PhaseFloor;
+        }
+        if(nullptr != m_Eulers && nullptr != m_CrystalStructures && m_CrystalStructures[m_Phases[index]] == Ebsd::CrystalStructure::Hexagonal_High)
+        {
+          m_Eulers[3 * index + 2] = static_cast<float>(m_Eulers[3 * index + 2] + m_HexOffset);
+        }
+      }
+    }
+  }
+
+private:
+  EbsdReader::Pointer m_Reader;
+  size_t m_SliceOffset;
+  int64_t m_XPoints;
+  QVector<EbsdSliceColumn_t> m_Columns;
+  int32_t* m_Phases;
+  int32_t m_PhaseFloor;
+  float* m_Eulers;
+  uint32_t* m_CrystalStructures;
+  double m_HexOffset;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -559,16 +662,9 @@ void ReadH5Ebsd::execute()
   ebsdReader->setSliceEnd(m_ZEndIndex);
   ebsdReader->readAllArrays(false);
   ebsdReader->setArraysToRead(m_SelectedArrayNames);
-  err = ebsdReader->loadData(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
-  if(err < 0)
-  {
-    setErrorCondition(err);
-    notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
-    notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
-    return;
-  }
+  ebsdReader->readVolumeInfo();
 
-  // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
+  // Read the slices straight into the data container structure (Cell arrays).
   if(manufacturer.compare(Ebsd::Ang::Manufacturer) == 0)
   {
     copyTSLArrays(ebsdReader.get());
@@ -577,13 +673,13 @@ void ReadH5Ebsd::execute()
   {
     copyHKLArrays(ebsdReader.get());
   }
-
-  else
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+  // A cancel during the slice reads leaves the volume partly filled, so do not transform it
+  if(getCancel() == true)
   {
-    QString ss =
-        QObject::tr("Could not determine or match a supported manufacturer from the data file. Supported manufacturer codes are: %1 and %2").arg(Ebsd::Ctf::Manufacturer).arg(Ebsd::Ang::Manufacturer);
-    setErrorCondition(-109875);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
     return;
   }
 
@@ -800,11 +896,79 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
     m_SelectedArrayNames.insert(Ebsd::Ctf::Euler2);
     m_SelectedArrayNames.insert(Ebsd::Ctf::Euler3);
   }
-  if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
+  // The phases are always copied for HKL data since the Euler angle correction depends on them
+  m_SelectedArrayNames.insert(Ebsd::Ctf::Phase);
+  return ebsdReader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::readSlices(H5EbsdVolumeReader* ebsdReader, const QVector<EbsdSliceColumn_t>& columns, int32_t* phases, int32_t phaseFloor, float* eulers, uint32_t* crystalStructures,
+                            double hexOffset)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  int64_t xpoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
+  int64_t ypoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
+  int64_t zpoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
+
+  // If no stacking order preference was found, read it from the file and use that value
+  uint32_t zDir = m_RefFrameZDir;
+  if(zDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
   {
-    m_SelectedArrayNames.insert(Ebsd::Ctf::Phase);
+    zDir = ebsdReader->getStackingOrder();
   }
-  return ebsdReader;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  // The HDF5 reads stay on this thread while the copies run on the worker threads. Only a
+  // bounded number of slices are kept in flight so the peak memory stays close to one volume.
+  int32_t maxSlicesInFlight = 2 * tbb::task_scheduler_init::default_num_threads();
+  int32_t slicesInFlight = 0;
+  tbb::task_group* g = new tbb::task_group;
+#endif
+
+  for(int64_t slice = 0; slice < zpoints; slice++)
+  {
+    if(getCancel() == true)
+    {
+      break;
+    }
+    EbsdReader::Pointer sliceReader = ebsdReader->readSlice(static_cast<int>(slice));
+    if(nullptr == sliceReader.get())
+    {
+      setErrorCondition(ebsdReader->getErrorCode() < 0 ? ebsdReader->getErrorCode() : -1);
+      notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
+      notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
+      break;
+    }
+    size_t sliceOffset = H5EbsdVolumeReader::getSliceOffset(static_cast<int>(slice), sliceReader->getXDimension(), sliceReader->getYDimension(), xpoints, ypoints, zpoints, zDir);
+    CopyEbsdSliceImpl copier(sliceReader, sliceOffset, xpoints, columns, phases, phaseFloor, eulers, crystalStructures, hexOffset);
+    sliceReader = EbsdReader::NullPointer();
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      g->run(copier);
+      slicesInFlight++;
+      if(slicesInFlight == maxSlicesInFlight)
+      {
+        g->wait();
+        slicesInFlight = 0;
+      }
+    }
+    else
+#endif
+    {
+      copier();
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  g->wait();
+  delete g;
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -812,10 +976,9 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
 // -----------------------------------------------------------------------------
 void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
   int32_t* phasePtr = nullptr;
+  float* cellEulerAngles = nullptr;
+  QVector<EbsdSliceColumn_t> columns;
 
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
@@ -828,88 +991,58 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> cDims(1, 1);
   if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ang::PhaseData));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    iArray->initializeWithZeros();
+    phasePtr = iArray->getPointer(0);
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ang::PhaseData, phasePtr, 1, 0, 1.0f});
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
   }
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi2));
     cDims[0] = 3;
     fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
+    fArray->initializeWithZeros();
+    cellEulerAngles = fArray->getPointer(0);
     float degToRad = 1.0f;
     if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
     {
       degToRad = SIMPLib::Constants::k_PiOver180;
     }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-    }
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ang::Phi1, cellEulerAngles, 3, 0, degToRad});
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ang::Phi, cellEulerAngles, 3, 1, degToRad});
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ang::Phi2, cellEulerAngles, 3, 2, degToRad});
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
   }
 
   // Reset this back to 1 for the rest of the arrays
   cDims[0] = 1;
 
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ImageQuality) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ImageQuality));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ImageQuality);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ImageQuality, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ConfidenceIndex) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ConfidenceIndex));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ConfidenceIndex);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ConfidenceIndex, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::SEMSignal) != m_SelectedArrayNames.end())
+  QStringList floatNames;
+  floatNames << Ebsd::Ang::ImageQuality << Ebsd::Ang::ConfidenceIndex << Ebsd::Ang::SEMSignal << Ebsd::Ang::Fit << Ebsd::Ang::XPosition << Ebsd::Ang::YPosition;
+  foreach(const QString& name, floatNames)
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::SEMSignal));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::SEMSignal);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::SEMSignal, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::Fit) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Fit));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::Fit);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::Fit, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::XPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::XPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::XPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::XPosition, fArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      fArray = FloatArrayType::CreateArray(tDims, cDims, name);
+      fArray->initializeWithZeros();
+      columns.push_back(EbsdSliceColumn_t{name, fArray->getPointer(0), 1, 0, 1.0f});
+      cellAttrMatrix->addAttributeArray(name, fArray);
+    }
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ang::YPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::YPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::YPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::YPosition, fArray);
-  }
+  /* For TSL OIM Files if there is a single phase then the value of the phase
+   * data is zero (0). If there are 2 or more phases then the lowest value
+   * of phase is one (1). In the rest of the reconstruction code we follow the
+   * convention that the lowest value is One (1) even if there is only a single
+   * phase. The phase floor converts all zeros to ones if there is a single
+   * phase in the OIM data.
+   */
+  int32_t phaseFloor = (ebsdReader->getNumPhases() == 1) ? 1 : 0;
+  readSlices(ebsdReader, columns, phasePtr, phaseFloor, nullptr, nullptr, 0.0);
 }
 
 // -----------------------------------------------------------------------------
@@ -917,10 +1050,8 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
 // -----------------------------------------------------------------------------
 void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
+  float* cellEulerAngles = nullptr;
+  QVector<EbsdSliceColumn_t> columns;
 
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
@@ -932,95 +1063,60 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> cDims(1, 1);
-  phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Phase));
   iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+  iArray->initializeWithZeros();
+  int32_t* cellPhases = iArray->getPointer(0);
+  columns.push_back(EbsdSliceColumn_t{Ebsd::Ctf::Phase, cellPhases, 1, 0, 1.0f});
   cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
 
+  double hexOffset = 0.0;
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler3));
     cDims[0] = 3;
     fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    int32_t* cellPhases = iArray->getPointer(0);
+    fArray->initializeWithZeros();
+    cellEulerAngles = fArray->getPointer(0);
     float degToRad = 1.0f;
     if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
     {
       degToRad = SIMPLib::Constants::k_PiOver180;
     }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
-      {
-        cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
-      }
-    }
+    hexOffset = 30.0 * degToRad;
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ctf::Euler1, cellEulerAngles, 3, 0, degToRad});
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ctf::Euler2, cellEulerAngles, 3, 1, degToRad});
+    columns.push_back(EbsdSliceColumn_t{Ebsd::Ctf::Euler3, cellEulerAngles, 3, 2, degToRad});
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
   }
 
   cDims[0] = 1;
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Bands) != m_SelectedArrayNames.end())
+  QStringList intNames;
+  intNames << Ebsd::Ctf::Bands << Ebsd::Ctf::Error << Ebsd::Ctf::BC << Ebsd::Ctf::BS;
+  foreach(const QString& name, intNames)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Bands));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Bands);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Bands, iArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Error) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Error));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Error);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Error, iArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::MAD) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::MAD));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::MAD);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::MAD, fArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      iArray = Int32ArrayType::CreateArray(tDims, cDims, name);
+      iArray->initializeWithZeros();
+      columns.push_back(EbsdSliceColumn_t{name, iArray->getPointer(0), 1, 0, 1.0f});
+      cellAttrMatrix->addAttributeArray(name, iArray);
+    }
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BC) != m_SelectedArrayNames.end())
+  QStringList floatNames;
+  floatNames << Ebsd::Ctf::MAD << Ebsd::Ctf::X << Ebsd::Ctf::Y;
+  foreach(const QString& name, floatNames)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BC));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BC);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BC, iArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      fArray = FloatArrayType::CreateArray(tDims, cDims, name);
+      fArray->initializeWithZeros();
+      columns.push_back(EbsdSliceColumn_t{name, fArray->getPointer(0), 1, 0, 1.0f});
+      cellAttrMatrix->addAttributeArray(name, fArray);
+    }
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BS) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BS));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BS);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BS, iArray);
-  }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::X) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::X));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::X);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::X, fArray);
-  }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Y) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Y));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Y);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Y, fArray);
-  }
+  readSlices(ebsdReader, columns, cellPhases, 0, cellEulerAngles, m_CrystalStructures, hexOffset);
 }
 
 // -----------------------------------------------------------------------------
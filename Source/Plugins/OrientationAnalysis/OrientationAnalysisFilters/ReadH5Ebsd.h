@@ -47,6 +47,20 @@
 
 class H5EbsdVolumeReader;
 
+/**
+ * @brief The EbsdSliceColumn_t struct describes where a column of an EBSD slice is written in the
+ * cell arrays: the column name in the reader, the destination array, its number of components, the
+ * component that receives the column and a scale factor applied to floating point columns.
+ */
+typedef struct
+{
+  QString name;
+  void* destination;
+  size_t numComps;
+  size_t comp;
+  float scale;
+} EbsdSliceColumn_t;
+
 /**
  * @brief The ReadH5Ebsd class. See [Filter documentation](@ref readh5ebsd) for details.
  */
@@ -230,13 +244,27 @@ class ReadH5Ebsd : public AbstractFilter
     H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
 
     /**
-     * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
+     * @brief readSlices Reads every slice of the volume and copies its columns straight into the cell
+     * arrays. The HDF5 reads happen on the calling thread while the copies of the previous slices are
+     * performed on worker threads.
+     * @param ebsdReader H5EbsdVolumeReader instance pointer
+     * @param columns The columns to copy and their destinations
+     * @param phases The cell phases or nullptr if the phases are not read
+     * @param phaseFloor Phase values below this floor are raised to it if it is greater than zero
+     * @param eulers The cell Euler angles or nullptr if the Euler angles are not read
+     * @param crystalStructures The ensemble crystal structures or nullptr to skip the hexagonal correction
+     * @param hexOffset The angle added to the third Euler angle of Hexagonal_High voxels
+     */
+    void readSlices(H5EbsdVolumeReader* ebsdReader, const QVector<EbsdSliceColumn_t>& columns, int32_t* phases, int32_t phaseFloor, float* eulers, uint32_t* crystalStructures, double hexOffset);
+
+    /**
+     * @brief copyTSLArrays Creates the cell arrays and reads the slices straight into them (TSL variant)
      * @param ebsdReader H5EbsdVolumeReader instance pointer
      */
     void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
 
     /**
-     * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
+     * @brief copyHKLArrays Creates the cell arrays and reads the slices straight into them (HKL variant)
      * @param ebsdReader H5EbsdVolumeReader instance pointer
      */
     void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -222,7 +224,7 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
       }
     }
     QString attrMatName = dataArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    TupleTransferMap transferMap(totalPoints);
 
     if(filter->getCancel())
     {
@@ -245,13 +247,10 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
       neighbor = bestNeighbor[i];
       if(neighbor != -1)
       {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-          p->copyTuple(neighbor, i);
-        }
+        transferMap.addCopy(neighbor, i);
       }
     }
+    transferMap.apply(m->getAttributeMatrix(attrMatName));
     if(filter->getLoop() == true && count > 0)
     {
       keepGoing = true;
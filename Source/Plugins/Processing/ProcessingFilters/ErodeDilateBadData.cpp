@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -328,7 +330,7 @@ void ErodeDilateBadData::execute()
     }
 
     QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    TupleTransferMap transferMap(totalPoints);
 
     for(size_t j = 0; j < totalPoints; j++)
     {
@@ -336,16 +338,14 @@ void ErodeDilateBadData::execute()
       int32_t neighbor = m_Neighbors[j];
       if(neighbor >= 0)
       {
-        if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
+        int32_t neighborFeature = transferMap.currentValue(m_FeatureIds, neighbor);
+        if((featurename == 0 && neighborFeature > 0 && m_Direction == 1) || (featurename > 0 && neighborFeature == 0 && m_Direction == 0))
         {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
+          transferMap.addCopy(neighbor, j);
         }
       }
     }
+    transferMap.apply(m->getAttributeMatrix(attrMatName));
   }
 
   // If there is an error set this to something negative and also set a message
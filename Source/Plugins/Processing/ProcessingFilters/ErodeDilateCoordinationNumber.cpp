@@ -43,6 +43,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -200,7 +202,7 @@ void ErodeDilateCoordinationNumber::execute()
   neighpoints[5] = dims[0] * dims[1];
 
   QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  TupleTransferMap transferMap(totalPoints);
 
   QVector<int32_t> n(numfeatures + 1, 0);
   QVector<int32_t> coordinationNumber(totalPoints, 0);
@@ -258,7 +260,7 @@ void ErodeDilateCoordinationNumber::execute()
             }
             if(good == 1)
             {
-              feature = m_FeatureIds[neighpoint];
+              feature = transferMap.currentValue(m_FeatureIds, neighpoint);
               if((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
               {
                 coordination = coordination + 1;
@@ -276,11 +278,7 @@ void ErodeDilateCoordinationNumber::execute()
           int32_t neighbor = m_Neighbors[point];
           if(coordinationNumber[point] >= m_CoordinationNumber && coordinationNumber[point] > 0)
           {
-            for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-              p->copyTuple(neighbor, point);
-            }
+            transferMap.addCopy(neighbor, point);
           }
           for(int32_t l = 0; l < 6; l++)
           {
@@ -312,7 +310,7 @@ void ErodeDilateCoordinationNumber::execute()
             }
             if(good == 1)
             {
-              feature = m_FeatureIds[neighpoint];
+              feature = transferMap.currentValue(m_FeatureIds, neighpoint);
               if(feature > 0)
               {
                 n[feature] = 0;
@@ -322,6 +320,8 @@ void ErodeDilateCoordinationNumber::execute()
         }
       }
     }
+    transferMap.apply(m->getAttributeMatrix(attrMatName));
+    transferMap.clear();
     for(int64_t k = 0; k < dims[2]; k++)
     {
       kstride = static_cast<int64_t>(dims[0] * dims[1] * k);
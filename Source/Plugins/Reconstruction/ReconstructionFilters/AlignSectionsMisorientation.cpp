@@ -35,12 +35,22 @@
 
 #include "AlignSectionsMisorientation.h"
 
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 #include <QtCore/QDateTime>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -48,8 +58,214 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/util/SectionShiftSearch.hpp"
 #include "Reconstruction/ReconstructionVersion.h"
+
 #include "moc_AlignSectionsMisorientation.cpp"
+
+/**
+ * @brief The AlignSectionsMisorientationCost class scores one candidate shift between a section and the
+ * section above it: the fraction of sampled Cell pairs that are misoriented by more than the tolerance. The
+ * pairs that need a misorientation are gathered into small batches and tested with
+ * SpaceGroupOps::getMisoQuatsBelowTolerance. Each instance holds its own batch buffers, so each thread needs
+ * its own instance.
+ */
+class AlignSectionsMisorientationCost
+{
+  public:
+    AlignSectionsMisorientationCost(float* quats, int32_t* cellPhases, bool* goodVoxels, uint32_t* crystalStructures, QVector<SpaceGroupOps::Pointer>& orientationOps, float tolerance,
+                                    const int64_t dims[3], int64_t slice)
+    : m_Quats(quats)
+    , m_CellPhases(cellPhases)
+    , m_GoodVoxels(goodVoxels)
+    , m_CrystalStructures(crystalStructures)
+    , m_OrientationOps(orientationOps)
+    , m_Tolerance(tolerance)
+    , m_Slice(slice)
+    , m_BatchPhase(0)
+    , m_BatchSize(0)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+
+    float operator()(int64_t xShift, int64_t yShift, int64_t sampleStep)
+    {
+      float disorientation = 0.0f;
+      float count = 0.0f;
+      m_BatchSize = 0;
+
+      for(int64_t l = 0; l < m_Dims[1]; l = l + sampleStep)
+      {
+        for(int64_t n = 0; n < m_Dims[0]; n = n + sampleStep)
+        {
+          if((l + yShift) < 0 || (l + yShift) >= m_Dims[1] || (n + xShift) < 0 || (n + xShift) >= m_Dims[0])
+          {
+            continue;
+          }
+          count++;
+          int64_t refposition = ((m_Slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+          int64_t curposition = (m_Slice * m_Dims[0] * m_Dims[1]) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+          if(nullptr == m_GoodVoxels || (m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true))
+          {
+            bool tested = false;
+            if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+            {
+              uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+              uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+              if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
+              {
+                disorientation += addPair(phase1, refposition, curposition);
+                tested = true;
+              }
+            }
+            if(tested == false)
+            {
+              disorientation++;
+            }
+          }
+          if(nullptr != m_GoodVoxels && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+          {
+            disorientation++;
+          }
+        }
+      }
+      disorientation += flushBatch();
+
+      if(count == 0.0f)
+      {
+        return std::numeric_limits<float>::max();
+      }
+      return disorientation / count;
+    }
+
+  private:
+    static const size_t k_BatchSize = 256;
+
+    float* m_Quats;
+    int32_t* m_CellPhases;
+    bool* m_GoodVoxels;
+    uint32_t* m_CrystalStructures;
+    QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    float m_Tolerance;
+    int64_t m_Dims[3];
+    int64_t m_Slice;
+
+    uint32_t m_BatchPhase;
+    size_t m_BatchSize;
+    float m_RefQuats[4][k_BatchSize];
+    float m_CurQuats[4][k_BatchSize];
+    bool m_Below[k_BatchSize];
+
+    /**
+     * @brief addPair Queues a Cell pair for the misorientation test
+     * @return The number of misoriented pairs found if queuing forced a pending batch to be tested
+     */
+    float addPair(uint32_t phase, int64_t refposition, int64_t curposition)
+    {
+      float misoriented = 0.0f;
+      if(m_BatchSize == k_BatchSize || (m_BatchSize > 0 && phase != m_BatchPhase))
+      {
+        misoriented = flushBatch();
+      }
+      m_BatchPhase = phase;
+      for(int32_t c = 0; c < 4; c++)
+      {
+        m_RefQuats[c][m_BatchSize] = m_Quats[refposition * 4 + c];
+        m_CurQuats[c][m_BatchSize] = m_Quats[curposition * 4 + c];
+      }
+      m_BatchSize++;
+      return misoriented;
+    }
+
+    /**
+     * @brief flushBatch Tests the queued pairs against the tolerance
+     * @return The number of queued pairs whose misorientation is above the tolerance
+     */
+    float flushBatch()
+    {
+      if(m_BatchSize == 0)
+      {
+        return 0.0f;
+      }
+      QuatSoA_t ref = {m_RefQuats[0], m_RefQuats[1], m_RefQuats[2], m_RefQuats[3]};
+      QuatSoA_t cur = {m_CurQuats[0], m_CurQuats[1], m_CurQuats[2], m_CurQuats[3]};
+      // getMisoQuat(...) > tolerance counts a pair as misoriented, so a pair exactly at the tolerance is not;
+      // for floats, angle < nextafterf(tolerance) is the same test as angle <= tolerance
+      float belowTolerance = nextafterf(m_Tolerance, std::numeric_limits<float>::max());
+      m_OrientationOps[m_BatchPhase]->getMisoQuatsBelowTolerance(ref, cur, m_BatchSize, belowTolerance, m_Below);
+      float misoriented = 0.0f;
+      for(size_t i = 0; i < m_BatchSize; i++)
+      {
+        if(m_Below[i] == false)
+        {
+          misoriented++;
+        }
+      }
+      m_BatchSize = 0;
+      return misoriented;
+    }
+};
+
+/**
+ * @brief The AlignSectionsMisorientationImpl class finds the relative shift of each pair of adjacent
+ * sections with a multi-resolution search. The pairs do not depend on each other, so they may be searched in
+ * any order; the shifts are accumulated afterwards.
+ */
+class AlignSectionsMisorientationImpl
+{
+  public:
+    AlignSectionsMisorientationImpl(float* quats, int32_t* cellPhases, bool* goodVoxels, uint32_t* crystalStructures, QVector<SpaceGroupOps::Pointer>& orientationOps, float tolerance,
+                                    int64_t dims[3], int64_t* xShifts, int64_t* yShifts)
+    : m_Quats(quats)
+    , m_CellPhases(cellPhases)
+    , m_GoodVoxels(goodVoxels)
+    , m_CrystalStructures(crystalStructures)
+    , m_OrientationOps(orientationOps)
+    , m_Tolerance(tolerance)
+    , m_XShifts(xShifts)
+    , m_YShifts(yShifts)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~AlignSectionsMisorientationImpl()
+    {
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      int32_t numLevels = SectionShiftSearch::NumberOfLevels(m_Dims[0], m_Dims[1]);
+      for(size_t iter = start; iter < end; iter++)
+      {
+        int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+        AlignSectionsMisorientationCost cost(m_Quats, m_CellPhases, m_GoodVoxels, m_CrystalStructures, m_OrientationOps, m_Tolerance, m_Dims, slice);
+        SectionShiftSearch::FindShift(cost, m_Dims[0], m_Dims[1], numLevels, m_XShifts[iter], m_YShifts[iter]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    float* m_Quats;
+    int32_t* m_CellPhases;
+    bool* m_GoodVoxels;
+    uint32_t* m_CrystalStructures;
+    QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    float m_Tolerance;
+    int64_t m_Dims[3];
+    int64_t* m_XShifts;
+    int64_t* m_YShifts;
+};
+
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -57,6 +273,7 @@ AlignSectionsMisorientation::AlignSectionsMisorientation()
 : AlignSections()
 , m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_UsePyramidSearch(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -91,6 +308,7 @@ void AlignSectionsMisorientation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMisorientation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMisorientation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Parallel Multi-Resolution Search", UsePyramidSearch, FilterParameter::Parameter, AlignSectionsMisorientation));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -127,6 +345,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUsePyramidSearch(reader->readValue("UsePyramidSearch", getUsePyramidSearch()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
@@ -261,6 +480,45 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
   uint32_t phase1 = 0, phase2 = 0;
   int64_t progInt = 0;
 
+  if(m_UsePyramidSearch == true)
+  {
+    // Search every pair of adjacent sections independently, then accumulate the shifts in order
+    std::vector<int64_t> pairXShifts(dims[2], 0);
+    std::vector<int64_t> pairYShifts(dims[2], 0);
+    bool* goodVoxels = (m_UseGoodVoxels == true) ? m_GoodVoxels : nullptr;
+    AlignSectionsMisorientationImpl impl(m_Quats, m_CellPhases, goodVoxels, m_CrystalStructures, m_OrientationOps, m_MisorientationTolerance, dims, pairXShifts.data(), pairYShifts.data());
+
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Aligning Sections || Determining Shifts");
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(1, dims[2]), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(1, dims[2]);
+    }
+
+    for(int64_t iter = 1; iter < dims[2]; iter++)
+    {
+      slice = (dims[2] - 1) - iter;
+      xshifts[iter] = xshifts[iter - 1] + pairXShifts[iter];
+      yshifts[iter] = yshifts[iter - 1] + pairYShifts[iter];
+      if(getWriteAlignmentShifts() == true)
+      {
+        outFile << slice << "	" << slice + 1 << "	" << pairXShifts[iter] << "	" << pairYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      }
+    }
+    if(getWriteAlignmentShifts() == true)
+    {
+      outFile.close();
+    }
+    return;
+  }
+
   // Allocate a 2D Array which will be reused from slice to slice
   BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], "_INTERNAL_USE_ONLY_Misorients");
   misorientsPtr->initializeWithValue(false);
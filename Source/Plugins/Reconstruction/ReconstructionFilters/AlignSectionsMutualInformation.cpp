@@ -34,10 +34,19 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -46,9 +55,158 @@
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/util/SectionShiftSearch.hpp"
 #include "Reconstruction/ReconstructionVersion.h"
 
 #include "moc_AlignSectionsMutualInformation.cpp"
+
+/**
+ * @brief The AlignSectionsMutualInformationCost class scores one candidate shift between a section and the
+ * section above it as the inverse of the mutual information between their per-section Feature Ids. Each
+ * instance holds its own histograms, so each thread needs its own instance.
+ */
+class AlignSectionsMutualInformationCost
+{
+  public:
+    AlignSectionsMutualInformationCost(int32_t* miFeatureIds, int32_t featureCount1, int32_t featureCount2, const int64_t dims[3], int64_t slice)
+    : m_MIFeatureIds(miFeatureIds)
+    , m_FeatureCount1(featureCount1)
+    , m_FeatureCount2(featureCount2)
+    , m_Slice(slice)
+    , m_MutualInfo12(featureCount1 * featureCount2, 0.0f)
+    , m_MutualInfo1(featureCount1, 0.0f)
+    , m_MutualInfo2(featureCount2, 0.0f)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+
+    float operator()(int64_t xShift, int64_t yShift, int64_t sampleStep)
+    {
+      std::fill(m_MutualInfo12.begin(), m_MutualInfo12.end(), 0.0f);
+      std::fill(m_MutualInfo1.begin(), m_MutualInfo1.end(), 0.0f);
+      std::fill(m_MutualInfo2.begin(), m_MutualInfo2.end(), 0.0f);
+
+      float count = 0.0f;
+      for(int64_t l = 0; l < m_Dims[1]; l = l + sampleStep)
+      {
+        for(int64_t n = 0; n < m_Dims[0]; n = n + sampleStep)
+        {
+          if((l + yShift) >= 0 && (l + yShift) < m_Dims[1] && (n + xShift) >= 0 && (n + xShift) < m_Dims[0])
+          {
+            int64_t refposition = ((m_Slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+            int64_t curposition = (m_Slice * m_Dims[0] * m_Dims[1]) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+            int32_t refgnum = m_MIFeatureIds[refposition];
+            int32_t curgnum = m_MIFeatureIds[curposition];
+            if(curgnum >= 0 && refgnum >= 0)
+            {
+              m_MutualInfo12[curgnum * m_FeatureCount2 + refgnum]++;
+              m_MutualInfo1[curgnum]++;
+              m_MutualInfo2[refgnum]++;
+              count++;
+            }
+          }
+          else
+          {
+            m_MutualInfo12[0]++;
+            m_MutualInfo1[0]++;
+            m_MutualInfo2[0]++;
+          }
+        }
+      }
+      if(count == 0.0f)
+      {
+        return std::numeric_limits<float>::max();
+      }
+
+      for(int32_t b = 0; b < m_FeatureCount1; b++)
+      {
+        m_MutualInfo1[b] = m_MutualInfo1[b] / count;
+      }
+      for(int32_t c = 0; c < m_FeatureCount2; c++)
+      {
+        m_MutualInfo2[c] = m_MutualInfo2[c] / count;
+      }
+      float disorientation = 0.0f;
+      for(int32_t b = 0; b < m_FeatureCount1; b++)
+      {
+        for(int32_t c = 0; c < m_FeatureCount2; c++)
+        {
+          float joint = m_MutualInfo12[b * m_FeatureCount2 + c] / count;
+          float value = 0.0f;
+          if(m_MutualInfo1[b] > 0 && m_MutualInfo2[c] > 0)
+          {
+            value = (joint / (m_MutualInfo1[b] * m_MutualInfo2[c]));
+          }
+          if(value != 0)
+          {
+            disorientation = disorientation + (joint * logf(value));
+          }
+        }
+      }
+      return 1.0f / disorientation;
+    }
+
+  private:
+    int32_t* m_MIFeatureIds;
+    int32_t m_FeatureCount1;
+    int32_t m_FeatureCount2;
+    int64_t m_Dims[3];
+    int64_t m_Slice;
+    std::vector<float> m_MutualInfo12;
+    std::vector<float> m_MutualInfo1;
+    std::vector<float> m_MutualInfo2;
+};
+
+/**
+ * @brief The AlignSectionsMutualInformationImpl class finds the relative shift of each pair of adjacent
+ * sections with a multi-resolution search. The pairs do not depend on each other, so they may be searched in
+ * any order; the shifts are accumulated afterwards.
+ */
+class AlignSectionsMutualInformationImpl
+{
+  public:
+    AlignSectionsMutualInformationImpl(int32_t* miFeatureIds, int32_t* featureCounts, int64_t dims[3], int64_t* xShifts, int64_t* yShifts)
+    : m_MIFeatureIds(miFeatureIds)
+    , m_FeatureCounts(featureCounts)
+    , m_XShifts(xShifts)
+    , m_YShifts(yShifts)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~AlignSectionsMutualInformationImpl()
+    {
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      int32_t numLevels = SectionShiftSearch::NumberOfLevels(m_Dims[0], m_Dims[1]);
+      for(size_t iter = start; iter < end; iter++)
+      {
+        int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+        AlignSectionsMutualInformationCost cost(m_MIFeatureIds, m_FeatureCounts[slice], m_FeatureCounts[slice + 1], m_Dims, slice);
+        SectionShiftSearch::FindShift(cost, m_Dims[0], m_Dims[1], numLevels, m_XShifts[iter], m_YShifts[iter]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int32_t* m_MIFeatureIds;
+    int32_t* m_FeatureCounts;
+    int64_t m_Dims[3];
+    int64_t* m_XShifts;
+    int64_t* m_YShifts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -56,6 +214,7 @@ AlignSectionsMutualInformation::AlignSectionsMutualInformation()
 : AlignSections()
 , m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_UsePyramidSearch(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -92,6 +251,7 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMutualInformation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMutualInformation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Parallel Multi-Resolution Search", UsePyramidSearch, FilterParameter::Parameter, AlignSectionsMutualInformation));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -127,6 +287,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   reader->openFilterGroup(this, index);
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUsePyramidSearch(reader->readValue("UsePyramidSearch", getUsePyramidSearch()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
@@ -268,6 +429,47 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
 
   form_features_sections();
 
+  if(m_UsePyramidSearch == true)
+  {
+    // Search every pair of adjacent sections independently, then accumulate the shifts in order
+    std::vector<int64_t> pairXShifts(dims[2], 0);
+    std::vector<int64_t> pairYShifts(dims[2], 0);
+    AlignSectionsMutualInformationImpl impl(miFeatureIds, featurecounts, dims, pairXShifts.data(), pairYShifts.data());
+
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Aligning Sections || Determining Shifts");
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(1, dims[2]), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(1, dims[2]);
+    }
+
+    for(int64_t iter = 1; iter < dims[2]; iter++)
+    {
+      slice = (dims[2] - 1) - iter;
+      xshifts[iter] = xshifts[iter - 1] + pairXShifts[iter];
+      yshifts[iter] = yshifts[iter - 1] + pairYShifts[iter];
+      if(getWriteAlignmentShifts() == true)
+      {
+        outFile << slice << "	" << slice + 1 << "	" << pairXShifts[iter] << "	" << pairYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      }
+    }
+
+    m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
+
+    if(getWriteAlignmentShifts() == true)
+    {
+      outFile.close();
+    }
+    return;
+  }
+
   std::vector<std::vector<float>> misorients;
   misorients.resize(dims[0]);
   for(int64_t a = 0; a < dims[0]; a++)
@@ -66,6 +66,9 @@ class AlignSectionsMutualInformation : public AlignSections
     SIMPL_FILTER_PARAMETER(bool, UseGoodVoxels)
     Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+    SIMPL_FILTER_PARAMETER(bool, UsePyramidSearch)
+    Q_PROPERTY(bool UsePyramidSearch READ getUsePyramidSearch WRITE setUsePyramidSearch)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, QuatsArrayPath)
     Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
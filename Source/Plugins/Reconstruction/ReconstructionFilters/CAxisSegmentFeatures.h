@@ -177,6 +177,26 @@ class CAxisSegmentFeatures : public SegmentFeatures
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isSeedable(int64_t point);
+
+    /**
+     * @brief isGroupable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureArrays Reimplemented from @see SegmentFeatures class
+     */
+    virtual void resizeFeatureArrays(size_t numFeatures);
+
   private:
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
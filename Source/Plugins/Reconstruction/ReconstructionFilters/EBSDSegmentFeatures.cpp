@@ -97,6 +97,7 @@ void EBSDSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, EBSDSegmentFeatures));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, EBSDSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Segmentation", UseParallelSegmentation, FilterParameter::Parameter, EBSDSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -142,6 +143,7 @@ void EBSDSegmentFeatures::readFilterParameters(AbstractFilterParametersReader* r
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelSegmentation(reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -333,7 +335,7 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true) && m_CellPhases[randpoint] > 0)
+      if(isSeedable(randpoint) == true)
       {
         seed = randpoint;
       }
@@ -362,39 +364,66 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && isGroupable(referencepoint, neighborpoint) == true)
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::isSeedable(int64_t point)
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[point] == false)
+  {
+    return false;
+  }
+  return m_CellPhases[point] > 0;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::isGroupable(int64_t referencepoint, int64_t neighborpoint)
+{
   // Get the phases for each voxel
   int32_t phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
   int32_t phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
   // If either of the phases is 999 then we bail out now.
   if(phase1 >= m_OrientationOps.size() || phase2 >= m_OrientationOps.size())
   {
-    return group;
+    return false;
   }
 
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
   {
-    float w = std::numeric_limits<float>::max();
-    QuatF q1 = QuaternionMathF::New();
-    QuatF q2 = QuaternionMathF::New();
-    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    return false;
+  }
 
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
+  // Only face neighbors are ever compared, and their misorientations were all tested up front in execute()
+  return m_FaceMask->isWithinTolerance(referencepoint, neighborpoint);
+}
 
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-    }
-    if(w < m_MisoTolerance)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
-  }
-  return group;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* EBSDSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::resizeFeatureArrays(size_t numFeatures)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numFeatures);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -439,7 +468,14 @@ void EBSDSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
+  size_t udims[3] = {0, 0, 0};
+  m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+  m_FaceMask = std::shared_ptr<NeighborMisorientationMask>(new NeighborMisorientationMask(udims, NeighborMisorientationMask::FaceOffsets(), reinterpret_cast<QuatF*>(m_Quats),
+                                                                                          m_CellPhases, m_CrystalStructures, m_OrientationOps, m_MisoTolerance));
+  m_FaceMask->compute();
+
   SegmentFeatures::execute();
+  m_FaceMask.reset();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
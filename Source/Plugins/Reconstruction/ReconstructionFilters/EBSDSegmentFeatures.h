@@ -46,6 +46,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/Utilities/NeighborMisorientationMask.hpp"
 
 #include "Reconstruction/ReconstructionFilters/SegmentFeatures.h"
 
@@ -176,6 +177,26 @@ class EBSDSegmentFeatures : public SegmentFeatures
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isSeedable(int64_t point);
+
+    /**
+     * @brief isGroupable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureArrays Reimplemented from @see SegmentFeatures class
+     */
+    virtual void resizeFeatureArrays(size_t numFeatures);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(float, Quats)
     DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
@@ -192,6 +213,7 @@ class EBSDSegmentFeatures : public SegmentFeatures
     std::shared_ptr<Generator> m_NumberGenerator;
 
     float m_MisoTolerance;
+    std::shared_ptr<NeighborMisorientationMask> m_FaceMask;
 
     /**
      * @brief randomizeGrainIds Randomizes Feature Ids
@@ -61,7 +61,7 @@ public:
   {
   }
 
-  virtual bool operator()(int64_t index, int64_t neighIndex, int32_t gnum) // call using () operator
+  virtual bool operator()(int64_t index, int64_t neighIndex) // call using () operator
   {
     return false;
   }
@@ -73,9 +73,8 @@ public:
 class TSpecificCompareFunctorBool : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance, int32_t* featureIds)
+  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance)
   : m_Length(length)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<bool*>(data);
   }
@@ -83,7 +82,7 @@ public:
   {
   }
 
-  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint)
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -93,7 +92,6 @@ public:
 
     if(m_Data[neighborpoint] == m_Data[referencepoint])
     {
-      m_FeatureIds[neighborpoint] = gnum;
       return true;
     }
     return false;
@@ -107,7 +105,6 @@ protected:
 private:
   bool* m_Data;          // The data that is being compared
   int64_t m_Length;      // Length of the Data Array
-  int32_t* m_FeatureIds; // The Feature Ids
 };
 
 /**
@@ -116,10 +113,9 @@ private:
 template <class T> class TSpecificCompareFunctor : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctor(void* data, int64_t length, T tolerance, int32_t* featureIds)
+  TSpecificCompareFunctor(void* data, int64_t length, T tolerance)
   : m_Length(length)
   , m_Tolerance(tolerance)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<T*>(data);
   }
@@ -127,7 +123,7 @@ public:
   {
   }
 
-  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint)
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -139,7 +135,6 @@ public:
     {
       if((m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance)
       {
-        m_FeatureIds[neighborpoint] = gnum;
         return true;
       }
     }
@@ -147,7 +142,6 @@ public:
     {
       if((m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance)
       {
-        m_FeatureIds[neighborpoint] = gnum;
         return true;
       }
     }
@@ -163,7 +157,6 @@ private:
   T* m_Data;             // The data that is being compared
   int64_t m_Length;      // Length of the Data Array
   T m_Tolerance;         // The tolerance of the comparison
-  int32_t* m_FeatureIds; // The Feature Ids
 };
 
 // Include the MOC generated file for this class
@@ -206,6 +199,7 @@ void ScalarSegmentFeatures::setupFilterParameters()
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Scalar Tolerance", ScalarTolerance, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, ScalarSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Segmentation", UseParallelSegmentation, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -236,6 +230,7 @@ void ScalarSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelSegmentation(reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()));
   setScalarArrayPath(reader->readDataArrayPath("ScalarArrayPath", getScalarArrayPath()));
   setScalarTolerance(reader->readValue("ScalarTolerance", getScalarTolerance()));
   reader->closeFilterGroup();
@@ -416,7 +411,7 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true)
+      if(isSeedable(randpoint) == true)
       {
         seed = randpoint;
       }
@@ -445,16 +440,53 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool ScalarSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  if(m_FeatureIds[neighborpoint] == 0 && isGroupable(referencepoint, neighborpoint) == true)
   {
-    CompareFunctor* func = m_Compare.get();
-    return (*func)((size_t)(referencepoint), (size_t)(neighborpoint), gnum);
-    //     | Functor  ||calling the operator() method of the CompareFunctor Class |
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
   }
-  else
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isSeedable(int64_t point)
+{
+  return (m_UseGoodVoxels == false || m_GoodVoxels[point] == true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isGroupable(int64_t referencepoint, int64_t neighborpoint)
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
   {
     return false;
   }
+  CompareFunctor* func = m_Compare.get();
+  return (*func)(referencepoint, neighborpoint);
+  //     | Functor  ||calling the operator() method of the CompareFunctor Class |
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* ScalarSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScalarSegmentFeatures::resizeFeatureArrays(size_t numFeatures)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numFeatures);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -496,47 +528,47 @@ void ScalarSegmentFeatures::execute()
   }
   else if(dType.compare("int8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("bool") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("int16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("int32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("int64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("float") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("double") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
@@ -35,6 +35,16 @@
 
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -45,12 +55,212 @@
 // Include the MOC generated file for this class
 #include "moc_SegmentFeatures.cpp"
 
+namespace
+{
+/**
+ * @brief findRoot Returns the root of the union-find set containing index, halving the path along the way.
+ * Parents always have a lower index than their children, so the root is the lowest index in the set
+ */
+int64_t findRoot(std::vector<int64_t>& parent, int64_t index)
+{
+  while(parent[index] != index)
+  {
+    parent[index] = parent[parent[index]];
+    index = parent[index];
+  }
+  return index;
+}
+
+/**
+ * @brief unite Merges the union-find sets containing a and b, keeping the lower root
+ */
+void unite(std::vector<int64_t>& parent, int64_t a, int64_t b)
+{
+  int64_t rootA = findRoot(parent, a);
+  int64_t rootB = findRoot(parent, b);
+  if(rootA < rootB)
+  {
+    parent[rootB] = rootA;
+  }
+  else if(rootB < rootA)
+  {
+    parent[rootA] = rootB;
+  }
+}
+}
+
+/**
+ * @brief The LabelSlabsImpl class labels the connected components inside each slab of Cells independently.
+ * Slab local components are numbered from 1 in the order of their lowest Cell index and written into the
+ * Feature Ids; grouped Cell pairs that straddle the lower slab boundary are recorded for the merge step.
+ */
+class LabelSlabsImpl
+{
+  SegmentFeatures* m_Filter;
+  int64_t m_Dims[3];
+  int64_t m_SlabSize;
+  int32_t* m_FeatureIds;
+  std::vector<int32_t>& m_FeatureCounts;
+  std::vector<std::vector<std::pair<int64_t, int64_t>>>& m_BoundaryPairs;
+
+public:
+  LabelSlabsImpl(SegmentFeatures* filter, int64_t dims[3], int64_t slabSize, int32_t* featureIds, std::vector<int32_t>& featureCounts,
+                 std::vector<std::vector<std::pair<int64_t, int64_t>>>& boundaryPairs)
+  : m_Filter(filter)
+  , m_SlabSize(slabSize)
+  , m_FeatureIds(featureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_BoundaryPairs(boundaryPairs)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~LabelSlabsImpl()
+  {
+  }
+
+  void label(size_t slab) const
+  {
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    int64_t start = static_cast<int64_t>(slab) * m_SlabSize;
+    int64_t end = std::min(start + m_SlabSize, totalPoints);
+    std::vector<int64_t> parent(end - start, -1);
+    std::vector<std::pair<int64_t, int64_t>>& boundaryPairs = m_BoundaryPairs[slab];
+
+    // Only the -x, -y and -z neighbors are visited; the +x, +y and +z faces are seen from the other Cell
+    int64_t neighpoints[3] = {-1, -m_Dims[0], -(m_Dims[0] * m_Dims[1])};
+    bool good[3] = {false, false, false};
+    int64_t col = 0, row = 0, plane = 0;
+    for(int64_t point = start; point < end; point++)
+    {
+      if(m_Filter->isSeedable(point) == false)
+      {
+        continue;
+      }
+      int64_t local = point - start;
+      parent[local] = local;
+      col = point % m_Dims[0];
+      row = (point / m_Dims[0]) % m_Dims[1];
+      plane = point / (m_Dims[0] * m_Dims[1]);
+      good[0] = (col > 0);
+      good[1] = (row > 0);
+      good[2] = (plane > 0);
+      for(int32_t i = 0; i < 3; i++)
+      {
+        if(good[i] == false)
+        {
+          continue;
+        }
+        int64_t neighbor = point + neighpoints[i];
+        if(neighbor >= start)
+        {
+          if(parent[neighbor - start] >= 0 && m_Filter->isGroupable(neighbor, point) == true)
+          {
+            unite(parent, neighbor - start, local);
+          }
+        }
+        else if(m_Filter->isSeedable(neighbor) == true && m_Filter->isGroupable(neighbor, point) == true)
+        {
+          boundaryPairs.push_back(std::make_pair(point, neighbor));
+        }
+      }
+    }
+
+    int32_t count = 0;
+    for(int64_t local = 0; local < end - start; local++)
+    {
+      if(parent[local] < 0)
+      {
+        m_FeatureIds[start + local] = 0;
+        continue;
+      }
+      int64_t root = findRoot(parent, local);
+      if(root == local)
+      {
+        count++;
+        m_FeatureIds[start + local] = count;
+      }
+      else
+      {
+        m_FeatureIds[start + local] = m_FeatureIds[start + root];
+      }
+    }
+    m_FeatureCounts[slab] = count;
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      label(slab);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The RelabelSlabsImpl class replaces the slab local labels written by @see LabelSlabsImpl with the final Feature Ids
+ */
+class RelabelSlabsImpl
+{
+  int64_t m_TotalPoints;
+  int64_t m_SlabSize;
+  int32_t* m_FeatureIds;
+  const std::vector<int64_t>& m_SlabOffsets;
+  const std::vector<int32_t>& m_FinalLabels;
+
+public:
+  RelabelSlabsImpl(int64_t totalPoints, int64_t slabSize, int32_t* featureIds, const std::vector<int64_t>& slabOffsets, const std::vector<int32_t>& finalLabels)
+  : m_TotalPoints(totalPoints)
+  , m_SlabSize(slabSize)
+  , m_FeatureIds(featureIds)
+  , m_SlabOffsets(slabOffsets)
+  , m_FinalLabels(finalLabels)
+  {
+  }
+  virtual ~RelabelSlabsImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      int64_t first = static_cast<int64_t>(slab) * m_SlabSize;
+      int64_t last = std::min(first + m_SlabSize, m_TotalPoints);
+      int64_t offset = m_SlabOffsets[slab] - 1;
+      for(int64_t point = first; point < last; point++)
+      {
+        if(m_FeatureIds[point] > 0)
+        {
+          m_FeatureIds[point] = m_FinalLabels[offset + m_FeatureIds[point]];
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 SegmentFeatures::SegmentFeatures()
 : AbstractFilter()
 , m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_UseParallelSegmentation(false)
 {
 }
 
@@ -67,6 +277,7 @@ SegmentFeatures::~SegmentFeatures()
 void SegmentFeatures::readFilterParameters(AbstractFilterParametersReader* reader, int index)
 {
   reader->openFilterGroup(this, index);
+  setUseParallelSegmentation(reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()));
   reader->closeFilterGroup();
 }
 
@@ -116,6 +327,154 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isSeedable(int64_t point)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isGroupable(int64_t referencepoint, int64_t neighborpoint)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SegmentFeatures::getFeatureIdsPointer()
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::resizeFeatureArrays(size_t numFeatures)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::executeParallel(int64_t dims[3])
+{
+  int32_t* featureIds = getFeatureIdsPointer();
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int64_t numSlabs = 1;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = 4 * static_cast<int64_t>(init.default_num_threads());
+#endif
+
+  // Slabs are built from whole rows of Cells so that single slice images still decompose. Whole planes
+  // are used when there are enough of them, which keeps the number of cross slab Cell pairs small
+  int64_t rowsPerSlab = 0;
+  if(dims[2] >= numSlabs)
+  {
+    rowsPerSlab = ((dims[2] + numSlabs - 1) / numSlabs) * dims[1];
+  }
+  else
+  {
+    rowsPerSlab = (dims[1] * dims[2] + numSlabs - 1) / numSlabs;
+  }
+  int64_t slabSize = rowsPerSlab * dims[0];
+  numSlabs = (totalPoints + slabSize - 1) / slabSize;
+
+  std::vector<int32_t> featureCounts(numSlabs, 0);
+  std::vector<std::vector<std::pair<int64_t, int64_t>>> boundaryPairs(numSlabs);
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), QObject::tr("Labeling %1 Slabs").arg(numSlabs));
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), LabelSlabsImpl(this, dims, slabSize, featureIds, featureCounts, boundaryPairs), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    LabelSlabsImpl serial(this, dims, slabSize, featureIds, featureCounts, boundaryPairs);
+    serial.generate(0, numSlabs);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Give every slab local component a provisional label that is unique over the whole volume
+  std::vector<int64_t> slabOffsets(numSlabs, 0);
+  int64_t totalProvisional = 0;
+  for(int64_t slab = 0; slab < numSlabs; slab++)
+  {
+    slabOffsets[slab] = totalProvisional;
+    totalProvisional += featureCounts[slab];
+  }
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Merging Slab Boundaries");
+
+  std::vector<int64_t> parent(totalProvisional, 0);
+  for(int64_t i = 0; i < totalProvisional; i++)
+  {
+    parent[i] = i;
+  }
+  for(int64_t slab = 0; slab < numSlabs; slab++)
+  {
+    for(std::vector<std::pair<int64_t, int64_t>>::size_type i = 0; i < boundaryPairs[slab].size(); i++)
+    {
+      int64_t point = boundaryPairs[slab][i].first;
+      int64_t neighbor = boundaryPairs[slab][i].second;
+      int64_t a = slabOffsets[slab] + featureIds[point] - 1;
+      int64_t b = slabOffsets[neighbor / slabSize] + featureIds[neighbor] - 1;
+      unite(parent, a, b);
+    }
+    std::vector<std::pair<int64_t, int64_t>>().swap(boundaryPairs[slab]);
+  }
+
+  // Slabs are contiguous in Cell index and slab local labels follow the lowest Cell index, so the root of
+  // each merged set is the piece holding the lowest Cell of the Feature. Numbering the roots in order
+  // therefore reproduces the seed order of the serial burn algorithm exactly
+  std::vector<int32_t> finalLabels(totalProvisional, 0);
+  int32_t gnum = 0;
+  for(int64_t i = 0; i < totalProvisional; i++)
+  {
+    int64_t root = findRoot(parent, i);
+    if(root == i)
+    {
+      gnum++;
+      finalLabels[i] = gnum;
+    }
+    else
+    {
+      finalLabels[i] = finalLabels[root];
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), RelabelSlabsImpl(totalPoints, slabSize, featureIds, slabOffsets, finalLabels), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    RelabelSlabsImpl serial(totalPoints, slabSize, featureIds, slabOffsets, finalLabels);
+    serial.generate(0, numSlabs);
+  }
+
+  resizeFeatureArrays(static_cast<size_t>(gnum) + 1);
+
+  QString ss = QObject::tr("Total Features: %1").arg(gnum);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -137,6 +496,13 @@ void SegmentFeatures::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
+  if(getUseParallelSegmentation() == true && nullptr != getFeatureIdsPointer())
+  {
+    executeParallel(dims);
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   int32_t gnum = 1;
   int64_t seed = 0;
   int64_t neighbor = 0;
@@ -60,6 +60,9 @@ class SegmentFeatures : public AbstractFilter
 
     SIMPL_INSTANCE_STRING_PROPERTY(DataContainerName)
 
+    SIMPL_FILTER_PARAMETER(bool, UseParallelSegmentation)
+    Q_PROPERTY(bool UseParallelSegmentation READ getUseParallelSegmentation WRITE setUseParallelSegmentation)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -167,7 +170,47 @@ class SegmentFeatures : public AbstractFilter
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedable Determines if a Cell is allowed to belong to a Feature at all. Every Cell that
+     * getSeed() may return or that determineGrouping() may add must satisfy this test.
+     * @param point Index of the Cell
+     * @return Boolean check for whether the Cell can be part of a Feature
+     */
+    virtual bool isSeedable(int64_t point);
+
+    /**
+     * @brief isGroupable Side effect free form of determineGrouping(). Must not read or write the Feature Ids
+     * and must be safe to call concurrently, as it is used by the parallel labeling engine
+     * @param referencepoint Point of growing seed
+     * @param neighborpoint Point to be compared for adding
+     * @return Boolean check for whether the two Cells belong to the same Feature
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Returns the raw Feature Ids array written by the parallel labeling engine
+     * @return Pointer to the Feature Ids, or nullptr if the subclass does not support parallel segmentation
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureArrays Resizes the Feature Attribute Matrix once the parallel labeling engine
+     * knows the final number of Features
+     * @param numFeatures Number of Feature tuples, including the zero Feature
+     */
+    virtual void resizeFeatureArrays(size_t numFeatures);
+
   private:
+    friend class LabelSlabsImpl;
+    friend class RelabelSlabsImpl;
+
+    /**
+     * @brief executeParallel Segments the volume with a slab decomposed union-find connected component labeling.
+     * Produces the same Features, numbered in the same order, as the serial burn algorithm in execute()
+     * @param dims Dimensions of the Image Geometry
+     */
+    void executeParallel(int64_t dims[3]);
+
     SegmentFeatures(const SegmentFeatures&); // Copy Constructor Not Implemented
     void operator=(const SegmentFeatures&); // Operator '=' Not Implemented
 };
@@ -171,6 +171,26 @@ class SineParamsSegmentFeatures : public SegmentFeatures
     virtual int64_t getSeed(int32_t gnum, int64_t nextSeed);
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isSeedable(int64_t point);
+
+    /**
+     * @brief isGroupable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureArrays Reimplemented from @see SegmentFeatures class
+     */
+    virtual void resizeFeatureArrays(size_t numFeatures);
+
   private:
     IDataArray::Pointer m_InputData;
 
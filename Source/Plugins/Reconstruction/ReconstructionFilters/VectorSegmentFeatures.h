@@ -168,6 +168,26 @@ class VectorSegmentFeatures : public SegmentFeatures
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isSeedable(int64_t point);
+
+    /**
+     * @brief isGroupable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureArrays Reimplemented from @see SegmentFeatures class
+     */
+    virtual void resizeFeatureArrays(size_t numFeatures);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(float, Vectors)
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
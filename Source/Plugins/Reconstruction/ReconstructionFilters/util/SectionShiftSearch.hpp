@@ -0,0 +1,136 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _sectionshiftsearch_hpp_
+#define _sectionshiftsearch_hpp_
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <set>
+#include <utility>
+
+/**
+ * @brief The SectionShiftSearch class finds the in-plane shift that best registers one section onto the
+ * next. It runs the greedy 7x7 hill-climb used by the AlignSections filters on a pyramid of resolutions:
+ * each coarser level samples the sections twice as sparsely and moves in steps twice as large, and its
+ * result seeds the next finer level. The finest level samples every 4th voxel with unit steps, exactly
+ * like the single resolution search.
+ */
+class SectionShiftSearch
+{
+  public:
+    /**
+     * @brief NumberOfLevels Returns how many pyramid levels a section of the given size supports. A coarser
+     * level is only added while it still samples at least k_MinSamplesPerAxis voxels along each axis.
+     * @param dimX Section size along X
+     * @param dimY Section size along Y
+     * @return Number of levels, at least 1
+     */
+    static int32_t NumberOfLevels(int64_t dimX, int64_t dimY)
+    {
+      int32_t numLevels = 1;
+      while(numLevels < k_MaxLevels && dimX / (k_BaseSampleStep << numLevels) >= k_MinSamplesPerAxis && dimY / (k_BaseSampleStep << numLevels) >= k_MinSamplesPerAxis)
+      {
+        numLevels++;
+      }
+      return numLevels;
+    }
+
+    /**
+     * @brief FindShift Runs the search. The cost functor is called as cost(xShift, yShift, sampleStep) and
+     * must return a value to minimize; ties are broken towards the smaller shift.
+     * @param cost Cost functor
+     * @param dimX Section size along X
+     * @param dimY Section size along Y
+     * @param numLevels Number of pyramid levels, see NumberOfLevels()
+     * @param xShift [output] Best shift along X
+     * @param yShift [output] Best shift along Y
+     */
+    template <typename CostFunctor>
+    static void FindShift(CostFunctor& cost, int64_t dimX, int64_t dimY, int32_t numLevels, int64_t& xShift, int64_t& yShift)
+    {
+      const int64_t halfDimX = static_cast<int64_t>(dimX * 0.5f);
+      const int64_t halfDimY = static_cast<int64_t>(dimY * 0.5f);
+
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+      for(int32_t level = numLevels - 1; level >= 0; level--)
+      {
+        const int64_t step = static_cast<int64_t>(1) << level;
+        const int64_t sampleStep = k_BaseSampleStep << level;
+
+        std::set<std::pair<int64_t, int64_t>> visited;
+        float mincost = std::numeric_limits<float>::max();
+        int64_t oldxshift = newxshift - 1;
+        int64_t oldyshift = newyshift - 1;
+        while(newxshift != oldxshift || newyshift != oldyshift)
+        {
+          oldxshift = newxshift;
+          oldyshift = newyshift;
+          for(int32_t j = -3; j < 4; j++)
+          {
+            for(int32_t k = -3; k < 4; k++)
+            {
+              int64_t xs = oldxshift + k * step;
+              int64_t ys = oldyshift + j * step;
+              if(llabs(xs) >= halfDimX || llabs(ys) >= halfDimY || visited.insert(std::make_pair(xs, ys)).second == false)
+              {
+                continue;
+              }
+              float value = cost(xs, ys, sampleStep);
+              if(value < mincost || (value == mincost && (llabs(xs) < llabs(newxshift) || llabs(ys) < llabs(newyshift))))
+              {
+                newxshift = xs;
+                newyshift = ys;
+                mincost = value;
+              }
+            }
+          }
+        }
+      }
+      xShift = newxshift;
+      yShift = newyshift;
+    }
+
+    static const int64_t k_BaseSampleStep = 4;
+    static const int32_t k_MaxLevels = 4;
+    static const int64_t k_MinSamplesPerAxis = 16;
+
+  private:
+    SectionShiftSearch();
+};
+
+#endif /* _sectionshiftsearch_hpp_ */
@@ -0,0 +1,309 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "Reconstruction/ReconstructionFilters/EBSDSegmentFeatures.h"
+#include "Reconstruction/ReconstructionFilters/ScalarSegmentFeatures.h"
+
+#include "ReconstructionTestFileLocations.h"
+
+class SegmentFeaturesTest
+{
+public:
+  SegmentFeaturesTest()
+  {
+  }
+  virtual ~SegmentFeaturesTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(SegmentFeaturesTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames;
+    filtNames << "EBSDSegmentFeatures"
+              << "ScalarSegmentFeatures";
+    FilterManager* fm = FilterManager::Instance();
+    for(int32_t i = 0; i < filtNames.size(); i++)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtNames[i]);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The SegmentFeaturesTest Requires the use of the " << filtNames[i].toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a volume of Voronoi regions. Each region has its own phase, orientation and scalar value, with a
+  // little noise on the Cells so that neighbors are close but not equal, and some Cells are masked out.
+  // The same seed always gives the same volume.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataContainerArray(uint32_t seed)
+  {
+    const size_t dims[3] = {15, 11, 9};
+    const size_t numRegions = 14;
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+    std::normal_distribution<float> normalDistribution(0.0f, 1.0f);
+
+    std::vector<float> centers(3 * numRegions, 0.0f);
+    std::vector<float> orientations(4 * numRegions, 0.0f);
+    for(size_t r = 0; r < numRegions; r++)
+    {
+      float mag = 0.0f;
+      for(size_t d = 0; d < 3; d++)
+      {
+        centers[3 * r + d] = unitDistribution(generator) * static_cast<float>(dims[d]);
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        orientations[4 * r + c] = normalDistribution(generator);
+        mag += orientations[4 * r + c] * orientations[4 * r + c];
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        orientations[4 * r + c] /= sqrtf(mag);
+      }
+    }
+    // Two regions with the same orientation and phase, which have to merge where they touch
+    for(size_t c = 0; c < 4; c++)
+    {
+      orientations[4 * 2 + c] = orientations[4 * 0 + c];
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, totalPoints);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, QVector<size_t>(1, 4), SIMPL::CellData::Quats);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases);
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(totalPoints, "Scalars");
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, SIMPL::CellData::Mask);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t point = (z * dims[1] + y) * dims[0] + x;
+          size_t region = 0;
+          float best = -1.0f;
+          for(size_t r = 0; r < numRegions; r++)
+          {
+            float dx = static_cast<float>(x) - centers[3 * r];
+            float dy = static_cast<float>(y) - centers[3 * r + 1];
+            float dz = static_cast<float>(z) - centers[3 * r + 2];
+            float dist = dx * dx + dy * dy + dz * dz;
+            if(best < 0.0f || dist < best)
+            {
+              best = dist;
+              region = r;
+            }
+          }
+          float q[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+          float mag = 0.0f;
+          for(size_t c = 0; c < 4; c++)
+          {
+            q[c] = orientations[4 * region + c] + 0.004f * normalDistribution(generator);
+            mag += q[c] * q[c];
+          }
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(point, c, q[c] / sqrtf(mag));
+          }
+          phases->setValue(point, (region == 2) ? 1 : static_cast<int32_t>(region % 2) + 1);
+          scalars->setValue(point, 10 * static_cast<int32_t>((region == 2) ? 0 : region) + static_cast<int32_t>(generator() % 3));
+          mask->setValue(point, unitDistribution(generator) > 0.08f);
+        }
+      }
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::Quats, quats);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::Phases, phases);
+    cellAttrMat->addAttributeArray("Scalars", scalars);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::Mask, mask);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+
+    // Phase 1 is cubic and phase 2 hexagonal
+    QVector<size_t> eDims(1, 3);
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::AttributeMatrixType::CellEnsemble);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+    ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName, ensembleAttrMat);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs one of the segmentation filters on a fresh copy of the volume
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer segment(const QString& filtName, bool useParallelSegmentation)
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray(1234);
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter(filtName);
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(true);
+    DREAM3D_REQUIRE(filter->setProperty("UseGoodVoxels", var) == true)
+    var.setValue(useParallelSegmentation);
+    DREAM3D_REQUIRE(filter->setProperty("UseParallelSegmentation", var) == true)
+    // The Feature Ids are randomized from the clock by default, which is not a filter parameter, so it is
+    // turned off through the filter class itself to compare the numbering
+    if(filtName == "EBSDSegmentFeatures")
+    {
+      var.setValue(5.0f);
+      DREAM3D_REQUIRE(filter->setProperty("MisorientationTolerance", var) == true)
+      static_cast<EBSDSegmentFeatures*>(filter.get())->setRandomizeFeatureIds(false);
+    }
+    else
+    {
+      var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "Scalars"));
+      DREAM3D_REQUIRE(filter->setProperty("ScalarArrayPath", var) == true)
+      var.setValue(2.5f);
+      DREAM3D_REQUIRE(filter->setProperty("ScalarTolerance", var) == true)
+      static_cast<ScalarSegmentFeatures*>(filter.get())->setRandomizeFeatureIds(false);
+    }
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void compareSegmentations(const QString& filtName)
+  {
+    DataContainerArray::Pointer serial = segment(filtName, false);
+    DataContainerArray::Pointer parallel = segment(filtName, true);
+
+    DataContainer::Pointer serialDC = serial->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DataContainer::Pointer parallelDC = parallel->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    Int32ArrayType::Pointer serialIds = serialDC->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer parallelIds = parallelDC->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    BoolArrayType::Pointer serialActive = serialDC->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName)->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::Active);
+    BoolArrayType::Pointer parallelActive = parallelDC->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName)->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::Active);
+    DREAM3D_REQUIRE_VALID_POINTER(serialIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(parallelIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(serialActive.get())
+    DREAM3D_REQUIRE_VALID_POINTER(parallelActive.get())
+
+    size_t totalPoints = serialIds->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(parallelIds->getNumberOfTuples(), totalPoints)
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(parallelIds->getValue(i), serialIds->getValue(i))
+    }
+    size_t numFeatures = serialActive->getNumberOfTuples();
+    DREAM3D_REQUIRED(numFeatures, >, 2)
+    DREAM3D_REQUIRE_EQUAL(parallelActive->getNumberOfTuples(), numFeatures)
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(parallelActive->getValue(i), serialActive->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEBSDSegmentFeatures()
+  {
+    compareSegmentations("EBSDSegmentFeatures");
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestScalarSegmentFeatures()
+  {
+    compareSegmentations("ScalarSegmentFeatures");
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestEBSDSegmentFeatures())
+    DREAM3D_REGISTER_TEST(TestScalarSegmentFeatures())
+  }
+
+private:
+  SegmentFeaturesTest(const SegmentFeaturesTest&); // Copy Constructor Not Implemented
+  void operator=(const SegmentFeaturesTest&);      // Operator '=' Not Implemented
+};
@@ -47,6 +47,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 
+#include "OrientationLib/Utilities/TupleTransferMap.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -451,7 +453,7 @@ void CropImageGeometry::execute()
   int64_t colold = 0, rowold = 0, planeold = 0;
   int64_t index = 0;
   int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  TupleTransferMap transferMap(cellAttrMat->getNumberOfTuples());
   for(int64_t i = 0; i < ZP; i++)
   {
     QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
@@ -468,14 +470,11 @@ void CropImageGeometry::execute()
         col = k;
         index_old = planeold + rowold + colold;
         index = plane + row + col;
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-          p->copyTuple(index_old, index);
-        }
+        transferMap.addCopy(index_old, index);
       }
     }
   }
+  transferMap.apply(cellAttrMat);
   destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
   totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> tDims(3, 0);
@@ -37,6 +37,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -61,6 +62,7 @@ RegularGridSampleSurfaceMesh::RegularGridSampleSurfaceMesh()
 , m_XPoints(0)
 , m_YPoints(0)
 , m_ZPoints(0)
+, m_UseScanlineVoxelization(false)
 , m_FeatureIdsArrayName(SIMPL::CellData::FeatureIds)
 , m_FeatureIds(nullptr)
 {
@@ -94,6 +96,7 @@ void RegularGridSampleSurfaceMesh::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Resolution", Resolution, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Origin", Origin, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Scanline Voxelization", UseScanlineVoxelization, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, RegularGridSampleSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
@@ -114,6 +117,7 @@ void RegularGridSampleSurfaceMesh::readFilterParameters(AbstractFilterParameters
   setZPoints(reader->readValue("ZPoints", getZPoints()));
   setResolution(reader->readFloatVec3("Resolution", getResolution()));
   setOrigin(reader->readFloatVec3("Origin", getOrigin()));
+  setUseScanlineVoxelization(reader->readValue("UseScanlineVoxelization", getUseScanlineVoxelization()));
   setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
@@ -222,6 +226,28 @@ void RegularGridSampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RegularGridSampleSurfaceMesh::getSamplingGrid(int64_t dims[3], float res[3], float origin[3])
+{
+  if(m_UseScanlineVoxelization == false)
+  {
+    return false;
+  }
+
+  dims[0] = m_XPoints;
+  dims[1] = m_YPoints;
+  dims[2] = m_ZPoints;
+  res[0] = m_Resolution.x;
+  res[1] = m_Resolution.y;
+  res[2] = m_Resolution.z;
+  origin[0] = m_Origin.x;
+  origin[1] = m_Origin.y;
+  origin[2] = m_Origin.z;
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -79,6 +79,9 @@ class RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
     SIMPL_FILTER_PARAMETER(FloatVec3_t, Origin)
     Q_PROPERTY(FloatVec3_t Origin READ getOrigin WRITE setOrigin)
 
+    SIMPL_FILTER_PARAMETER(bool, UseScanlineVoxelization)
+    Q_PROPERTY(bool UseScanlineVoxelization READ getUseScanlineVoxelization WRITE setUseScanlineVoxelization)
+
     SIMPL_FILTER_PARAMETER(QString, FeatureIdsArrayName)
     Q_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
@@ -166,6 +169,11 @@ class RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
      */
     virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+    /**
+     * @brief getSamplingGrid Reimplemented from @see SampleSurfaceMesh class
+     */
+    virtual bool getSamplingGrid(int64_t dims[3], float res[3], float origin[3]);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
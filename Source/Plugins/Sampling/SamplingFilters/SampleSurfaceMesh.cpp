@@ -35,6 +35,11 @@
 
 #include "SampleSurfaceMesh.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -53,10 +58,13 @@
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/util/BoundingBoxTree.hpp"
 #include "Sampling/SamplingVersion.h"
 
 /**
  * @brief The SampleSurfaceMeshImpl class implements a threaded algorithm that samples a surface mesh based on points passed from subclassed Filters.
+ * Each point looks up the Features whose bounding boxes contain it in a bounding box tree and is assigned to the
+ * lowest numbered of those Features whose closed surface contains it.
  */
 class SampleSurfaceMeshImpl
 {
@@ -64,14 +72,19 @@ class SampleSurfaceMeshImpl
   Int32Int32DynamicListArray::Pointer m_FaceIds;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const BoundingBoxTree* m_FeatureBBTree;
+  const float* m_FeatureBBs;
   int32_t* m_PolyIds;
 
 public:
-  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, int32_t* polyIds)
+  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, const BoundingBoxTree* featureBBTree,
+                        const float* featureBBs, int32_t* polyIds)
   : m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_FeatureBBTree(featureBBTree)
+  , m_FeatureBBs(featureBBs)
   , m_PolyIds(polyIds)
   {
   }
@@ -83,31 +96,35 @@ public:
   {
     float radius = 0.0f;
     float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
-    FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower");
-    FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right");
-    float* ll = llPtr->getPointer(0);
-    float* ur = urPtr->getPointer(0);
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
     float* point = nullptr;
     char code = ' ';
+    std::vector<int32_t> candidates;
 
-    for(size_t iter = start; iter < end; iter++)
+    for(size_t i = start; i < end; i++)
     {
-      // find bounding box for current feature
-      GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), ll, ur);
-      GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
+      point = m_Points->getVertexPointer(i);
+
+      // find the features whose bounding boxes contain the point
+      candidates.clear();
+      m_FeatureBBTree->findBoxesContainingPoint(point, candidates);
+      std::sort(candidates.begin(), candidates.end());
 
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(int64_t i = 0; i < numPoints; i++)
+      for(size_t c = 0; c < candidates.size(); c++)
       {
-        point = m_Points->getVertexPointer(i);
-        if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, ll, ur) == true)
+        int32_t feature = candidates[c];
+        for(int32_t d = 0; d < 3; d++)
         {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, ll, ur, radius, distToBoundary);
-          if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-          {
-            m_PolyIds[i] = iter;
-          }
+          ll[d] = m_FeatureBBs[6 * feature + d];
+          ur[d] = m_FeatureBBs[6 * feature + 3 + d];
+        }
+        GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
+        code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(feature), m_FaceBBs.get(), point, ll, ur, radius, distToBoundary);
+        if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
+        {
+          m_PolyIds[i] = feature;
+          break;
         }
       }
     }
@@ -122,6 +139,271 @@ public:
 private:
 };
 
+/**
+ * @brief The VoxelRun_t struct is a run of cells [first, last] along X of one scanline that lie inside a Feature
+ */
+typedef struct
+{
+  int64_t line;
+  int64_t first;
+  int64_t last;
+  int32_t feature;
+} VoxelRun_t;
+
+/**
+ * @brief The VoxelizeSurfaceMeshImpl class implements a threaded algorithm that voxelizes the closed surface of
+ * each Feature onto a regular grid of cell centers. The centers of each row of cells along X inside the Feature's
+ * bounding box are treated as one scanline; every triangle of the Feature that the scanline passes through adds a
+ * crossing, and the cells between alternate pairs of sorted crossings are inside the Feature. Ties where a scanline
+ * passes exactly through an edge or vertex are broken by a symbolic perturbation of the scanline computed from the
+ * shared vertex ids, so neighboring triangles (and neighboring Features) always agree on which of them was crossed.
+ * Each Feature only records its runs of inside cells; FillVoxelRunsImpl writes them to the grid.
+ */
+class VoxelizeSurfaceMeshImpl
+{
+  TriangleGeom::Pointer m_Faces;
+  Int32Int32DynamicListArray::Pointer m_FaceIds;
+  const float* m_FeatureBBs;
+  int64_t m_Dims[3];
+  float m_Res[3];
+  float m_Origin[3];
+  std::vector<std::vector<VoxelRun_t> >& m_FeatureRuns;
+
+public:
+  VoxelizeSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, const float* featureBBs, int64_t dims[3], float res[3], float origin[3],
+                          std::vector<std::vector<VoxelRun_t> >& featureRuns)
+  : m_Faces(faces)
+  , m_FaceIds(faceIds)
+  , m_FeatureBBs(featureBBs)
+  , m_FeatureRuns(featureRuns)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+      m_Res[d] = res[d];
+      m_Origin[d] = origin[d];
+    }
+  }
+  virtual ~VoxelizeSurfaceMeshImpl()
+  {
+  }
+
+  /**
+   * @brief cellCenter Returns the coordinate of a cell center exactly as the sampling points are generated
+   */
+  float cellCenter(int32_t d, int64_t index) const
+  {
+    return (float(index) + 0.5f) * m_Res[d] + m_Origin[d];
+  }
+
+  /**
+   * @brief findCellRange Finds the range of cell indices along one axis whose centers lie in [minCoord, maxCoord]
+   * @return false if no cell center lies in the range
+   */
+  bool findCellRange(int32_t d, float minCoord, float maxCoord, int64_t& first, int64_t& last) const
+  {
+    first = static_cast<int64_t>(std::floor((minCoord - m_Origin[d]) / m_Res[d] - 0.5f)) - 1;
+    last = static_cast<int64_t>(std::ceil((maxCoord - m_Origin[d]) / m_Res[d] - 0.5f)) + 1;
+    first = std::max(first, static_cast<int64_t>(0));
+    last = std::min(last, m_Dims[d] - 1);
+    while(first <= last && cellCenter(d, first) < minCoord)
+    {
+      first++;
+    }
+    while(last >= first && cellCenter(d, last) > maxCoord)
+    {
+      last--;
+    }
+    return first <= last;
+  }
+
+  /**
+   * @brief edgeSide Returns the side of the directed edge a->b on which the (Y, Z) point lies. The edge is always
+   * evaluated from its lower vertex id so both triangles sharing it see exactly opposite values, and a point exactly
+   * on the edge line is moved off it by the perturbation (y + e, z + e^2).
+   */
+  double edgeSide(int64_t a, int64_t b, const float* verts, float py, float pz, double& value) const
+  {
+    int64_t lo = std::min(a, b);
+    int64_t hi = std::max(a, b);
+    double sign = (lo == a) ? 1.0 : -1.0;
+    double dy = double(verts[3 * hi + 1]) - double(verts[3 * lo + 1]);
+    double dz = double(verts[3 * hi + 2]) - double(verts[3 * lo + 2]);
+    value = sign * (dy * (double(pz) - double(verts[3 * lo + 2])) - dz * (double(py) - double(verts[3 * lo + 1])));
+    if(value != 0.0)
+    {
+      return (value > 0.0) ? 1.0 : -1.0;
+    }
+    if(dz != 0.0)
+    {
+      return (dz > 0.0) ? -sign : sign;
+    }
+    return (dy > 0.0) ? sign : -sign;
+  }
+
+  void voxelize(size_t start, size_t end) const
+  {
+    float* verts = m_Faces->getVertexPointer(0);
+    int64_t* tris = m_Faces->getTriPointer(0);
+    std::vector<std::pair<int64_t, float> > crossings;
+
+    for(size_t feature = start; feature < end; feature++)
+    {
+      Int32Int32DynamicListArray::ElementList& faceList = m_FaceIds->getElementList(feature);
+      if(faceList.ncells == 0)
+      {
+        continue;
+      }
+      const float* bb = m_FeatureBBs + 6 * feature;
+      int64_t xFirst = 0, xLast = 0, yFirst = 0, yLast = 0, zFirst = 0, zLast = 0;
+      if(!findCellRange(0, bb[0], bb[3], xFirst, xLast) || !findCellRange(1, bb[1], bb[4], yFirst, yLast) || !findCellRange(2, bb[2], bb[5], zFirst, zLast))
+      {
+        continue;
+      }
+
+      // Collect the (scanline, x) crossings of every triangle of the feature
+      crossings.clear();
+      for(int32_t t = 0; t < faceList.ncells; t++)
+      {
+        const int64_t* tri = tris + 3 * faceList.cells[t];
+        float triMin[3] = {verts[3 * tri[0]], verts[3 * tri[0] + 1], verts[3 * tri[0] + 2]};
+        float triMax[3] = {triMin[0], triMin[1], triMin[2]};
+        for(int32_t v = 1; v < 3; v++)
+        {
+          for(int32_t d = 1; d < 3; d++)
+          {
+            triMin[d] = std::min(triMin[d], verts[3 * tri[v] + d]);
+            triMax[d] = std::max(triMax[d], verts[3 * tri[v] + d]);
+          }
+        }
+        int64_t jFirst = 0, jLast = 0, kFirst = 0, kLast = 0;
+        if(!findCellRange(1, triMin[1], triMax[1], jFirst, jLast) || !findCellRange(2, triMin[2], triMax[2], kFirst, kLast))
+        {
+          continue;
+        }
+        for(int64_t k = kFirst; k <= kLast; k++)
+        {
+          float pz = cellCenter(2, k);
+          for(int64_t j = jFirst; j <= jLast; j++)
+          {
+            float py = cellCenter(1, j);
+            // The weight of each vertex is the side value of the opposite edge
+            double w0 = 0.0, w1 = 0.0, w2 = 0.0;
+            double s0 = edgeSide(tri[1], tri[2], verts, py, pz, w0);
+            double s1 = edgeSide(tri[2], tri[0], verts, py, pz, w1);
+            double s2 = edgeSide(tri[0], tri[1], verts, py, pz, w2);
+            if(s0 != s1 || s1 != s2)
+            {
+              continue;
+            }
+            double area = w0 + w1 + w2;
+            if(area == 0.0)
+            {
+              // The triangle is edge on to the scanlines, which the perturbed scanline never hits
+              continue;
+            }
+            double x = (w0 * verts[3 * tri[0]] + w1 * verts[3 * tri[1]] + w2 * verts[3 * tri[2]]) / area;
+            crossings.push_back(std::make_pair(k * m_Dims[1] + j, static_cast<float>(x)));
+          }
+        }
+      }
+      std::sort(crossings.begin(), crossings.end());
+
+      // Record the runs of cells whose centers lie in (c0, c1], (c2, c3], ... of each scanline
+      std::vector<VoxelRun_t>& runs = m_FeatureRuns[feature];
+      size_t c = 0;
+      while(c < crossings.size())
+      {
+        int64_t line = crossings[c].first;
+        size_t lineEnd = c;
+        while(lineEnd < crossings.size() && crossings[lineEnd].first == line)
+        {
+          lineEnd++;
+        }
+        int64_t i = xFirst;
+        for(size_t pair = c; pair + 1 < lineEnd; pair += 2)
+        {
+          float enter = crossings[pair].second;
+          float exit = crossings[pair + 1].second;
+          while(i <= xLast && cellCenter(0, i) <= enter)
+          {
+            i++;
+          }
+          VoxelRun_t run;
+          run.line = line;
+          run.first = i;
+          run.feature = static_cast<int32_t>(feature);
+          while(i <= xLast && cellCenter(0, i) <= exit)
+          {
+            i++;
+          }
+          run.last = i - 1;
+          if(run.last >= run.first)
+          {
+            runs.push_back(run);
+          }
+        }
+        c = lineEnd;
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    voxelize(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The FillVoxelRunsImpl class implements a threaded algorithm that writes the runs of each Z slice of the
+ * grid. The runs of a slice are in increasing Feature order and a cell keeps the first Feature written to it, so a
+ * cell inside several Features is owned by the lowest numbered one no matter how the slices are scheduled.
+ */
+class FillVoxelRunsImpl
+{
+  const std::vector<VoxelRun_t>& m_SliceRuns;
+  const std::vector<size_t>& m_SliceStarts;
+  int64_t m_XDim;
+  int32_t* m_PolyIds;
+
+public:
+  FillVoxelRunsImpl(const std::vector<VoxelRun_t>& sliceRuns, const std::vector<size_t>& sliceStarts, int64_t xDim, int32_t* polyIds)
+  : m_SliceRuns(sliceRuns)
+  , m_SliceStarts(sliceStarts)
+  , m_XDim(xDim)
+  , m_PolyIds(polyIds)
+  {
+  }
+  virtual ~FillVoxelRunsImpl()
+  {
+  }
+
+  void fill(size_t start, size_t end) const
+  {
+    for(size_t r = m_SliceStarts[start]; r < m_SliceStarts[end]; r++)
+    {
+      const VoxelRun_t& run = m_SliceRuns[r];
+      int32_t* row = m_PolyIds + run.line * m_XDim;
+      for(int64_t i = run.first; i <= run.last; i++)
+      {
+        if(row[i] == 0)
+        {
+          row[i] = run.feature;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    fill(r.begin(), r.end());
+  }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_SampleSurfaceMesh.cpp"
 
@@ -237,6 +519,14 @@ void SampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   return;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SampleSurfaceMesh::getSamplingGrid(int64_t dims[3], float res[3], float origin[3])
+{
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -334,6 +624,94 @@ void SampleSurfaceMesh::execute()
     faceBBs->setCoords(2 * i + 1, ur);
   }
 
+  // find bounding box for each feature
+  std::vector<float> featureBBs(6 * numFeatures, 0.0f);
+  std::vector<float> occupiedBBs;
+  std::vector<int32_t> occupiedFeatures;
+  for(int32_t i = 1; i < numFeatures; i++)
+  {
+    if(faceLists->getElementList(i).ncells == 0)
+    {
+      continue;
+    }
+    GeometryMath::FindBoundingBoxOfFaces(triangleGeom.get(), faceLists->getElementList(i), ll, ur);
+    for(int32_t d = 0; d < 3; d++)
+    {
+      featureBBs[6 * i + d] = ll[d];
+      featureBBs[6 * i + 3 + d] = ur[d];
+    }
+    occupiedBBs.insert(occupiedBBs.end(), featureBBs.begin() + 6 * i, featureBBs.begin() + 6 * i + 6);
+    occupiedFeatures.push_back(i);
+  }
+
+  // Subclasses that sample a regular grid of cell centers are voxelized directly, without generating the points
+  int64_t gridDims[3] = {0, 0, 0};
+  float gridRes[3] = {0.0f, 0.0f, 0.0f};
+  float gridOrigin[3] = {0.0f, 0.0f, 0.0f};
+  if(getSamplingGrid(gridDims, gridRes, gridOrigin) == true)
+  {
+    Int32ArrayType::Pointer iArray = Int32ArrayType::CreateArray(gridDims[0] * gridDims[1] * gridDims[2], "_INTERNAL_USE_ONLY_polyhedronIds");
+    iArray->initializeWithZeros();
+    int32_t* polyIds = iArray->getPointer(0);
+
+    std::vector<std::vector<VoxelRun_t> > featureRuns(numFeatures);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(1, numFeatures), VoxelizeSurfaceMeshImpl(triangleGeom, faceLists, featureBBs.data(), gridDims, gridRes, gridOrigin, featureRuns),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      VoxelizeSurfaceMeshImpl serial(triangleGeom, faceLists, featureBBs.data(), gridDims, gridRes, gridOrigin, featureRuns);
+      serial.voxelize(1, numFeatures);
+    }
+
+    // Sort the runs into Z slices, keeping increasing Feature order within each slice, and fill the slices
+    size_t numSlices = static_cast<size_t>(gridDims[2]);
+    std::vector<size_t> sliceStarts(numSlices + 1, 0);
+    for(int32_t i = 1; i < numFeatures; i++)
+    {
+      for(size_t r = 0; r < featureRuns[i].size(); r++)
+      {
+        sliceStarts[featureRuns[i][r].line / gridDims[1] + 1]++;
+      }
+    }
+    for(size_t k = 0; k < numSlices; k++)
+    {
+      sliceStarts[k + 1] += sliceStarts[k];
+    }
+    std::vector<VoxelRun_t> sliceRuns(sliceStarts[numSlices]);
+    std::vector<size_t> sliceNext(sliceStarts.begin(), sliceStarts.end() - 1);
+    for(int32_t i = 1; i < numFeatures; i++)
+    {
+      for(size_t r = 0; r < featureRuns[i].size(); r++)
+      {
+        const VoxelRun_t& run = featureRuns[i][r];
+        sliceRuns[sliceNext[run.line / gridDims[1]]++] = run;
+      }
+      std::vector<VoxelRun_t>().swap(featureRuns[i]);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlices), FillVoxelRunsImpl(sliceRuns, sliceStarts, gridDims[0], polyIds), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FillVoxelRunsImpl serial(sliceRuns, sliceStarts, gridDims[0], polyIds);
+      serial.fill(0, numSlices);
+    }
+
+    assign_points(iArray);
+
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   // generate the list of sampling points from subclass
   VertexGeom::Pointer points = generate_points();
   if(getErrorCondition() < 0 || nullptr == points.get())
@@ -348,16 +726,19 @@ void SampleSurfaceMesh::execute()
   iArray->initializeWithZeros();
   int32_t* polyIds = iArray->getPointer(0);
 
+  BoundingBoxTree featureBBTree(occupiedBBs, occupiedFeatures);
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), SampleSurfaceMeshImpl(triangleGeom, faceLists, faceBBs, points, &featureBBTree, featureBBs.data(), polyIds),
+                      tbb::auto_partitioner());
   }
   else
 #endif
   {
-    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, faceBBs, points, polyIds);
-    serial.checkPoints(0, numFeatures);
+    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, faceBBs, points, &featureBBTree, featureBBs.data(), polyIds);
+    serial.checkPoints(0, numPoints);
   }
 
   assign_points(iArray);
@@ -166,6 +166,17 @@ class SampleSurfaceMesh : public AbstractFilter
      */
     virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+    /**
+     * @brief getSamplingGrid Lets subclasses whose sampling points are the cell centers of a regular grid
+     * describe that grid, so the surface mesh is voxelized onto it with parity scanlines instead of locating
+     * each point separately. generate_points is not called in that case.
+     * @param dims Number of cells along each axis
+     * @param res Size of the cells along each axis
+     * @param origin Origin of the grid
+     * @return true if the grid should be voxelized; the default returns false
+     */
+    virtual bool getSamplingGrid(int64_t dims[3], float res[3], float origin[3]);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
 
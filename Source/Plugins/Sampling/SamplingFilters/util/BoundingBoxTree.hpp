@@ -0,0 +1,245 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _boundingboxtree_hpp_
+#define _boundingboxtree_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The BoundingBoxTree class is a bounding volume hierarchy over a set of axis aligned boxes,
+ * such as the bounding boxes of Features. Each node stores the box enclosing all the boxes below it and
+ * the boxes are split at the median of their centers along the longest axis, so a point query only
+ * descends into the nodes whose boxes contain the point. The tree is read-only after construction,
+ * so queries may be issued concurrently from several threads.
+ */
+class BoundingBoxTree
+{
+  public:
+    /**
+     * @brief BoundingBoxTree Builds the tree
+     * @param boxes The boxes stored as consecutive (minX, minY, minZ, maxX, maxY, maxZ) values
+     * @param ids The id reported for each box
+     */
+    BoundingBoxTree(const std::vector<float>& boxes, const std::vector<int32_t>& ids)
+    : m_Boxes(boxes)
+    , m_Ids(ids)
+    {
+      size_t numBoxes = m_Ids.size();
+      m_Order.resize(numBoxes);
+      for(size_t i = 0; i < numBoxes; i++)
+      {
+        m_Order[i] = i;
+      }
+      if(numBoxes == 0)
+      {
+        return;
+      }
+
+      Node root;
+      m_Nodes.push_back(root);
+      std::vector<BuildTask> tasks(1, BuildTask(0, 0, numBoxes));
+      while(!tasks.empty())
+      {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        Node& node = m_Nodes[task.node];
+        float centerMin[3] = {0.0f, 0.0f, 0.0f};
+        float centerMax[3] = {0.0f, 0.0f, 0.0f};
+        for(int32_t d = 0; d < 3; d++)
+        {
+          const float* box = boxPointer(m_Order[task.begin]);
+          node.ll[d] = box[d];
+          node.ur[d] = box[3 + d];
+          centerMin[d] = centerMax[d] = 0.5f * (box[d] + box[3 + d]);
+        }
+        for(size_t i = task.begin + 1; i < task.end; i++)
+        {
+          const float* box = boxPointer(m_Order[i]);
+          for(int32_t d = 0; d < 3; d++)
+          {
+            float center = 0.5f * (box[d] + box[3 + d]);
+            node.ll[d] = std::min(node.ll[d], box[d]);
+            node.ur[d] = std::max(node.ur[d], box[3 + d]);
+            centerMin[d] = std::min(centerMin[d], center);
+            centerMax[d] = std::max(centerMax[d], center);
+          }
+        }
+
+        if(task.end - task.begin <= k_MaxLeafSize)
+        {
+          node.first = task.begin;
+          node.count = task.end - task.begin;
+          continue;
+        }
+
+        int32_t axis = 0;
+        for(int32_t d = 1; d < 3; d++)
+        {
+          if(centerMax[d] - centerMin[d] > centerMax[axis] - centerMin[axis])
+          {
+            axis = d;
+          }
+        }
+        size_t middle = task.begin + (task.end - task.begin) / 2;
+        std::nth_element(m_Order.begin() + task.begin, m_Order.begin() + middle, m_Order.begin() + task.end, CenterLess(this, axis));
+
+        size_t left = m_Nodes.size();
+        node.first = left;
+        node.count = 0;
+        // The node reference is invalidated by these push_backs, so it is not used below
+        m_Nodes.push_back(Node());
+        m_Nodes.push_back(Node());
+        tasks.push_back(BuildTask(left, task.begin, middle));
+        tasks.push_back(BuildTask(left + 1, middle, task.end));
+      }
+    }
+
+    virtual ~BoundingBoxTree() {}
+
+    /**
+     * @brief findBoxesContainingPoint Appends to result the ids of all boxes that contain the point, boundary
+     * included. The ids are appended in no particular order.
+     */
+    void findBoxesContainingPoint(const float point[3], std::vector<int32_t>& result) const
+    {
+      if(m_Nodes.empty())
+      {
+        return;
+      }
+      size_t stack[k_MaxDepth];
+      int32_t top = 0;
+      stack[top++] = 0;
+      while(top > 0)
+      {
+        const Node& node = m_Nodes[stack[--top]];
+        if(!contains(node.ll, node.ur, point))
+        {
+          continue;
+        }
+        if(node.count > 0)
+        {
+          for(size_t i = node.first; i < node.first + node.count; i++)
+          {
+            const float* box = boxPointer(m_Order[i]);
+            if(contains(box, box + 3, point))
+            {
+              result.push_back(m_Ids[m_Order[i]]);
+            }
+          }
+        }
+        else
+        {
+          stack[top++] = node.first;
+          stack[top++] = node.first + 1;
+        }
+      }
+    }
+
+  private:
+    static const size_t k_MaxLeafSize = 4;
+    // Median splits keep the depth near log2 of the number of boxes
+    static const int32_t k_MaxDepth = 128;
+
+    struct Node
+    {
+      float ll[3];
+      float ur[3];
+      size_t first;
+      size_t count;
+      Node()
+      : first(0)
+      , count(0)
+      {
+        ll[0] = ll[1] = ll[2] = 0.0f;
+        ur[0] = ur[1] = ur[2] = 0.0f;
+      }
+    };
+
+    struct BuildTask
+    {
+      size_t node;
+      size_t begin;
+      size_t end;
+      BuildTask(size_t n, size_t b, size_t e)
+      : node(n)
+      , begin(b)
+      , end(e)
+      {
+      }
+    };
+
+    class CenterLess
+    {
+      const BoundingBoxTree* m_Tree;
+      int32_t m_Axis;
+
+    public:
+      CenterLess(const BoundingBoxTree* tree, int32_t axis)
+      : m_Tree(tree)
+      , m_Axis(axis)
+      {
+      }
+      bool operator()(size_t a, size_t b) const
+      {
+        const float* boxA = m_Tree->boxPointer(a);
+        const float* boxB = m_Tree->boxPointer(b);
+        return boxA[m_Axis] + boxA[3 + m_Axis] < boxB[m_Axis] + boxB[3 + m_Axis];
+      }
+    };
+
+    std::vector<float> m_Boxes;
+    std::vector<int32_t> m_Ids;
+    std::vector<size_t> m_Order;
+    std::vector<Node> m_Nodes;
+
+    const float* boxPointer(size_t box) const
+    {
+      return &(m_Boxes[6 * box]);
+    }
+
+    static bool contains(const float* ll, const float* ur, const float* point)
+    {
+      return point[0] >= ll[0] && point[0] <= ur[0] && point[1] >= ll[1] && point[1] <= ur[1] && point[2] >= ll[2] && point[2] <= ur[2];
+    }
+
+    BoundingBoxTree(const BoundingBoxTree&); // Copy Constructor Not Implemented
+    void operator=(const BoundingBoxTree&);  // Operator '=' Not Implemented
+};
+
+#endif /* _boundingboxtree_hpp_ */
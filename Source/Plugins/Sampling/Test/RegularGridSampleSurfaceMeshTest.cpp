@@ -0,0 +1,298 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Sampling/SamplingFilters/RegularGridSampleSurfaceMesh.h"
+
+#include "SamplingTestFileLocations.h"
+
+class RegularGridSampleSurfaceMeshTest
+{
+public:
+  RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  virtual ~RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(RegularGridSampleSurfaceMeshTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the RegularGridSampleSurfaceMesh Filter from the FilterManager
+    QString filtName = "RegularGridSampleSurfaceMesh";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The RegularGridSampleSurfaceMeshTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Sampling Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void AddQuad(std::vector<int64_t>& tris, std::vector<int32_t>& labels, int64_t v0, int64_t v1, int64_t v2, int64_t v3, int32_t label0, int32_t label1)
+  {
+    int64_t quadTris[6] = {v0, v1, v2, v0, v2, v3};
+    tris.insert(tris.end(), quadTris, quadTris + 6);
+    for(int32_t t = 0; t < 2; t++)
+    {
+      labels.push_back(label0);
+      labels.push_back(label1);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Adds the 6 faces of the box whose corners are the vertices first + ix + xStride * (iy + 2 * iz), ix in {x0, x1}
+  // and iy, iz in {0, 1}. The x0 and x1 faces get their own labels so two boxes can share a face.
+  // -----------------------------------------------------------------------------
+  void AddBox(std::vector<int64_t>& tris, std::vector<int32_t>& labels, int64_t first, int64_t xStride, int64_t x0, int64_t x1, int32_t feature, int32_t x0Neighbor, int32_t x1Neighbor)
+  {
+    int64_t v[2][2][2];
+    int64_t xs[2] = {x0, x1};
+    for(int32_t a = 0; a < 2; a++)
+    {
+      for(int32_t b = 0; b < 2; b++)
+      {
+        for(int32_t c = 0; c < 2; c++)
+        {
+          v[a][b][c] = first + xs[a] + xStride * (b + 2 * c);
+        }
+      }
+    }
+    AddQuad(tris, labels, v[0][0][0], v[0][1][0], v[0][1][1], v[0][0][1], feature, x0Neighbor);
+    AddQuad(tris, labels, v[1][0][0], v[1][1][0], v[1][1][1], v[1][0][1], feature, x1Neighbor);
+    AddQuad(tris, labels, v[0][0][0], v[1][0][0], v[1][0][1], v[0][0][1], feature, -1);
+    AddQuad(tris, labels, v[0][1][0], v[1][1][0], v[1][1][1], v[0][1][1], feature, -1);
+    AddQuad(tris, labels, v[0][0][0], v[1][0][0], v[1][1][0], v[0][1][0], feature, -1);
+    AddQuad(tris, labels, v[0][0][1], v[1][0][1], v[1][1][1], v[0][1][1], feature, -1);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Features 1 and 2 are boxes sharing the face x = 3.0. Feature 3 is a separate box that overlaps both of them
+  // and sticks out past Feature 2, so the cells in the overlaps must go to the lowest numbered Feature.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateSurfaceMesh()
+  {
+    float xs[3] = {0.2f, 3.0f, 6.1f};
+    float ys[2] = {0.2f, 4.1f};
+    float zs[2] = {0.3f, 3.7f};
+    float boxMin[3] = {2.2f, 1.1f, 1.2f};
+    float boxMax[3] = {7.4f, 2.9f, 2.6f};
+
+    std::vector<float> verts;
+    for(int32_t iz = 0; iz < 2; iz++)
+    {
+      for(int32_t iy = 0; iy < 2; iy++)
+      {
+        for(int32_t ix = 0; ix < 3; ix++)
+        {
+          verts.push_back(xs[ix]);
+          verts.push_back(ys[iy]);
+          verts.push_back(zs[iz]);
+        }
+      }
+    }
+    for(int32_t iz = 0; iz < 2; iz++)
+    {
+      for(int32_t iy = 0; iy < 2; iy++)
+      {
+        for(int32_t ix = 0; ix < 2; ix++)
+        {
+          verts.push_back(ix == 0 ? boxMin[0] : boxMax[0]);
+          verts.push_back(iy == 0 ? boxMin[1] : boxMax[1]);
+          verts.push_back(iz == 0 ? boxMin[2] : boxMax[2]);
+        }
+      }
+    }
+
+    std::vector<int64_t> tris;
+    std::vector<int32_t> labels;
+    AddBox(tris, labels, 0, 3, 0, 1, 1, -1, 2);
+    // The shared face was added with Feature 1, so Feature 2 only adds its other 5 faces
+    std::vector<int64_t> box2Tris;
+    std::vector<int32_t> box2Labels;
+    AddBox(box2Tris, box2Labels, 0, 3, 1, 2, 2, 1, -1);
+    tris.insert(tris.end(), box2Tris.begin() + 6, box2Tris.end());
+    labels.insert(labels.end(), box2Labels.begin() + 4, box2Labels.end());
+    AddBox(tris, labels, 12, 2, 0, 1, 3, -1, -1);
+
+    size_t numVerts = verts.size() / 3;
+    size_t numTris = tris.size() / 3;
+    SharedVertexList::Pointer triVerts = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), triVerts, SIMPL::Geometry::TriangleGeometry);
+    for(size_t v = 0; v < numVerts; v++)
+    {
+      triangleGeom->setCoords(v, verts.data() + 3 * v);
+    }
+    for(size_t t = 0; t < numTris; t++)
+    {
+      triangleGeom->setVertsAtTri(t, tris.data() + 3 * t);
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dc->setGeometry(triangleGeom);
+    dca->addDataContainer(dc);
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::AttributeMatrixType::Face);
+    dc->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      faceLabels->setValue(i, labels[i]);
+    }
+    faceAttrMat->addAttributeArray(faceLabels->getName(), faceLabels);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer SampleSurfaceMesh(bool useScanlineVoxelization)
+  {
+    DataContainerArray::Pointer dca = CreateSurfaceMesh();
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("RegularGridSampleSurfaceMesh");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    DREAM3D_REQUIRE(filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var) == true)
+    // No cell center lies on a face of the mesh, so both methods must agree on every cell
+    var.setValue(32);
+    DREAM3D_REQUIRE(filter->setProperty("XPoints", var) == true)
+    var.setValue(15);
+    DREAM3D_REQUIRE(filter->setProperty("YPoints", var) == true)
+    var.setValue(12);
+    DREAM3D_REQUIRE(filter->setProperty("ZPoints", var) == true)
+    FloatVec3_t resolution;
+    resolution.x = 0.25f;
+    resolution.y = 0.3f;
+    resolution.z = 0.35f;
+    var.setValue(resolution);
+    DREAM3D_REQUIRE(filter->setProperty("Resolution", var) == true)
+    FloatVec3_t origin;
+    origin.x = 0.0f;
+    origin.y = 0.0f;
+    origin.z = 0.0f;
+    var.setValue(origin);
+    DREAM3D_REQUIRE(filter->setProperty("Origin", var) == true)
+    var.setValue(useScanlineVoxelization);
+    DREAM3D_REQUIRE(filter->setProperty("UseScanlineVoxelization", var) == true)
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    QString dcName = filter->property("DataContainerName").toString();
+    QString cellAttrMatName = filter->property("CellAttributeMatrixName").toString();
+    QString featureIdsName = filter->property("FeatureIdsArrayName").toString();
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(dcName)->getAttributeMatrix(cellAttrMatName);
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(featureIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestScanlineVoxelization()
+  {
+    Int32ArrayType::Pointer pointInPolyhedron = SampleSurfaceMesh(false);
+    Int32ArrayType::Pointer scanline = SampleSurfaceMesh(true);
+
+    size_t numCells = pointInPolyhedron->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(scanline->getNumberOfTuples(), numCells)
+    for(size_t i = 0; i < numCells; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(scanline->getValue(i), pointInPolyhedron->getValue(i))
+    }
+
+    // Cells inside Feature 3 and one of the lower numbered boxes, inside Feature 3 only and outside every Feature
+    size_t j = 7;
+    size_t k = 6;
+    size_t row = (k * 15 + j) * 32;
+    DREAM3D_REQUIRE_EQUAL(scanline->getValue(row + 10), 1)
+    DREAM3D_REQUIRE_EQUAL(scanline->getValue(row + 20), 2)
+    DREAM3D_REQUIRE_EQUAL(scanline->getValue(row + 28), 3)
+    DREAM3D_REQUIRE_EQUAL(scanline->getValue(row + 31), 0)
+    DREAM3D_REQUIRE_EQUAL(scanline->getValue(0), 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestScanlineVoxelization())
+  }
+
+private:
+  RegularGridSampleSurfaceMeshTest(const RegularGridSampleSurfaceMeshTest&); // Copy Constructor Not Implemented
+  void operator=(const RegularGridSampleSurfaceMeshTest&);                   // Operator '=' Not Implemented
+};
@@ -42,6 +42,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -178,26 +180,25 @@ template <typename T> void findAverage(IDataArray::Pointer inDataPtr, FloatArray
   size_t numPoints = inputDataPtr->getNumberOfTuples();
   size_t numFeatures = averageArray->getNumberOfTuples();
 
-  std::vector<float> counts(numFeatures, 0.0f);
+  // The Cells are treated as a flat list, so this works for any geometry
+  size_t dims[3] = {numPoints, 1, 1};
+  FeatureReductionEngine reduction(fIds, dims, numFeatures, FeatureReductionEngine::Count | FeatureReductionEngine::ScalarSum);
+  reduction.execute<T>(cPtr);
 
-  int32_t feature = 0;
-  float value = 0.0f;
-  for(size_t i = 0; i < numPoints; i++)
+  if(numFeatures > 0)
   {
-    value = float(cPtr[i]);
-    feature = fIds[i];
-    aPtr[feature] += value;
-    counts[feature] += 1.0f;
+    aPtr[0] = static_cast<float>(reduction.getScalarSum(0));
   }
   for(size_t i = 1; i < numFeatures; i++)
   {
-    if(counts[i] == 0)
+    double count = reduction.getCount(i);
+    if(count == 0)
     {
       aPtr[i] = 0;
     }
     else
     {
-      aPtr[i] /= counts[i];
+      aPtr[i] = static_cast<float>(reduction.getScalarSum(i) / count);
     }
   }
 }
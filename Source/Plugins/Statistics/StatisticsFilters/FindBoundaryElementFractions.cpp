@@ -41,6 +41,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -172,25 +174,14 @@ void FindBoundaryElementFractions::find_surface_voxel_fractions()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_BoundaryCellFractionsPtr.lock()->getNumberOfTuples();
 
-  FloatArrayType::Pointer m_SurfVoxCounts = FloatArrayType::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_SurfVoxCounts");
-  m_SurfVoxCounts->initializeWithZeros();
-  float* surfvoxcounts = m_SurfVoxCounts->getPointer(0);
-  FloatArrayType::Pointer m_VoxCounts = FloatArrayType::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_VoxCounts");
-  m_VoxCounts->initializeWithZeros();
-  float* voxcounts = m_VoxCounts->getPointer(0);
+  size_t dims[3] = {totalPoints, 1, 1};
+  FeatureReductionEngine reduction(m_FeatureIds, dims, numfeatures, FeatureReductionEngine::Count | FeatureReductionEngine::BoundaryCount);
+  reduction.setBoundaryCells(m_BoundaryCells);
+  reduction.execute();
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    voxcounts[gnum]++;
-    if(m_BoundaryCells[j] > 0)
-    {
-      surfvoxcounts[gnum]++;
-    }
-  }
   for(size_t i = 1; i < numfeatures; i++)
   {
-    m_BoundaryCellFractions[i] = surfvoxcounts[i] / voxcounts[i];
+    m_BoundaryCellFractions[i] = static_cast<float>(reduction.getBoundaryCount(i)) / static_cast<float>(reduction.getCount(i));
   }
 }
 
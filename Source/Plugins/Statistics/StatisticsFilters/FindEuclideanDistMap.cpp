@@ -39,6 +39,7 @@
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_group.h>
 #include <tbb/task_scheduler_init.h>
 #include <tbb/tick_count.h>
@@ -270,6 +271,231 @@ public:
   }
 };
 
+/**
+ * @brief The FindExactEuclideanLines class computes one separable pass of an exact squared Euclidean
+ * distance transform along the X, Y or Z axis. Each line of the volume is independent; the lower envelope
+ * of parabolas is built for each line following Felzenszwalb & Huttenlocher, "Distance Transforms of
+ * Sampled Functions", Theory of Computing 8 (2012).
+ */
+class FindExactEuclideanLines
+{
+  double* m_Distances;
+  int64_t* m_Nearest;
+  int64_t m_Dims[3];
+  int32_t m_Axis;
+  double m_Weight;
+
+public:
+  FindExactEuclideanLines(double* dists, int64_t* nearest, int64_t dims[3], int32_t axis, double res)
+  : m_Distances(dists)
+  , m_Nearest(nearest)
+  , m_Axis(axis)
+  , m_Weight(res * res)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindExactEuclideanLines()
+  {
+  }
+
+  size_t getNumberOfLines() const
+  {
+    return static_cast<size_t>((m_Dims[0] * m_Dims[1] * m_Dims[2]) / m_Dims[m_Axis]);
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    int64_t length = m_Dims[m_Axis];
+    int64_t stride = 1;
+    for(int32_t d = 0; d < m_Axis; d++)
+    {
+      stride *= m_Dims[d];
+    }
+
+    std::vector<double> f(length, 0.0);
+    std::vector<int64_t> fNearest(length, -1);
+    std::vector<int64_t> v(length, 0);
+    std::vector<double> z(length + 1, 0.0);
+    double inf = std::numeric_limits<double>::infinity();
+
+    for(size_t line = start; line < end; line++)
+    {
+      // The line index enumerates the two axes that are not being transformed, fastest axis first
+      int64_t first = 0;
+      if(m_Axis == 0)
+      {
+        first = static_cast<int64_t>(line) * m_Dims[0];
+      }
+      else if(m_Axis == 1)
+      {
+        first = (static_cast<int64_t>(line) / m_Dims[0]) * m_Dims[0] * m_Dims[1] + (static_cast<int64_t>(line) % m_Dims[0]);
+      }
+      else
+      {
+        first = static_cast<int64_t>(line);
+      }
+
+      for(int64_t q = 0; q < length; q++)
+      {
+        f[q] = m_Distances[first + q * stride];
+        fNearest[q] = m_Nearest[first + q * stride];
+      }
+
+      int64_t k = -1;
+      for(int64_t q = 0; q < length; q++)
+      {
+        if(f[q] == inf)
+        {
+          continue;
+        }
+        double s = -inf;
+        while(k >= 0)
+        {
+          s = ((f[q] + m_Weight * double(q * q)) - (f[v[k]] + m_Weight * double(v[k] * v[k]))) / (2.0 * m_Weight * double(q - v[k]));
+          if(s > z[k])
+          {
+            break;
+          }
+          k--;
+        }
+        if(k < 0)
+        {
+          s = -inf;
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+      }
+      if(k < 0)
+      {
+        continue; // No sites on this line, so it stays at infinity
+      }
+      z[k + 1] = inf;
+
+      int64_t j = 0;
+      for(int64_t q = 0; q < length; q++)
+      {
+        while(z[j + 1] < double(q))
+        {
+          j++;
+        }
+        double delta = double(q - v[j]);
+        m_Distances[first + q * stride] = m_Weight * delta * delta + f[v[j]];
+        m_Nearest[first + q * stride] = fNearest[v[j]];
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The FindExactEuclideanMap class computes the exact Euclidean distance map for one of the boundary
+ * types using three separable 1D passes, along with the index of the nearest boundary Cell
+ */
+class FindExactEuclideanMap
+{
+  DataContainer::Pointer m;
+  int32_t* m_FeatureIds;
+  int32_t* m_NearestNeighbors;
+  float* m_GBEuclideanDistances;
+  float* m_TJEuclideanDistances;
+  float* m_QPEuclideanDistances;
+  int32_t mapType;
+  bool m_DoParallel;
+
+public:
+  FindExactEuclideanMap(DataContainer::Pointer datacontainer, int32_t* fIds, int32_t* nearNeighs, float* gbDists, float* tjDists, float* qpDists, int32_t type, bool doParallel)
+  : m(datacontainer)
+  , m_FeatureIds(fIds)
+  , m_NearestNeighbors(nearNeighs)
+  , m_GBEuclideanDistances(gbDists)
+  , m_TJEuclideanDistances(tjDists)
+  , m_QPEuclideanDistances(qpDists)
+  , mapType(type)
+  , m_DoParallel(doParallel)
+  {
+  }
+
+  virtual ~FindExactEuclideanMap()
+  {
+  }
+
+  void operator()() const
+  {
+    size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+    int64_t dims[3] = {static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints()), static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints()),
+                       static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints())};
+    double res[3] = {static_cast<double>(m->getGeometryAs<ImageGeom>()->getXRes()), static_cast<double>(m->getGeometryAs<ImageGeom>()->getYRes()),
+                     static_cast<double>(m->getGeometryAs<ImageGeom>()->getZRes())};
+
+    float* distances = m_GBEuclideanDistances;
+    if(mapType == 1)
+    {
+      distances = m_TJEuclideanDistances;
+    }
+    else if(mapType == 2)
+    {
+      distances = m_QPEuclideanDistances;
+    }
+
+    std::vector<double> voxEDist(totalPoints, std::numeric_limits<double>::infinity());
+    std::vector<int64_t> voxNN(totalPoints, -1);
+
+    // Only Cells already at distance 0 are sources; other Cells that carry a nearest neighbor
+    // (those outside any Feature) keep themselves as their nearest neighbor, as in the iterative map
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      if(distances[a] == 0.0f)
+      {
+        voxEDist[a] = 0.0;
+        voxNN[a] = static_cast<int64_t>(a);
+      }
+    }
+
+    for(int32_t axis = 0; axis < 3; axis++)
+    {
+      FindExactEuclideanLines lines(&(voxEDist.front()), &(voxNN.front()), dims, axis, res[axis]);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(m_DoParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, lines.getNumberOfLines()), lines, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        lines.generate(0, lines.getNumberOfLines());
+      }
+    }
+
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      if(m_NearestNeighbors[a * 3 + mapType] >= 0 && distances[a] != 0.0f)
+      {
+        m_NearestNeighbors[a * 3 + mapType] = static_cast<int32_t>(a);
+        distances[a] = 0.0f;
+      }
+      else if(m_FeatureIds[a] > 0 && voxNN[a] >= 0)
+      {
+        m_NearestNeighbors[a * 3 + mapType] = static_cast<int32_t>(voxNN[a]);
+        distances[a] = static_cast<float>(sqrt(voxEDist[a]));
+      }
+      else
+      {
+        m_NearestNeighbors[a * 3 + mapType] = -1;
+      }
+    }
+  }
+};
+
 // Include the MOC generated file for this class
 #include "moc_FindEuclideanDistMap.cpp"
 
@@ -288,6 +514,7 @@ FindEuclideanDistMap::FindEuclideanDistMap()
 , m_DoQuadPoints(false)
 , m_SaveNearestNeighbors(false)
 , m_CalcOnlyManhattanDist(false)
+, m_CalcExactEuclideanDist(false)
 , m_FeatureIds(nullptr)
 , m_NearestNeighbors(nullptr)
 , m_GBEuclideanDistances(nullptr)
@@ -311,6 +538,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance Only", CalcOnlyManhattanDist, FilterParameter::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Exact Euclidean Distance", CalcExactEuclideanDist, FilterParameter::Parameter, FindEuclideanDistMap));
   QStringList linkedProps("GBEuclideanDistancesArrayName");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Parameter, FindEuclideanDistMap, linkedProps));
   linkedProps.clear();
@@ -355,6 +583,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcOnlyManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcOnlyManhattanDist()));
+  setCalcExactEuclideanDist(reader->readValue("CalcExactEuclideanDist", getCalcExactEuclideanDist()));
   reader->closeFilterGroup();
 }
 
@@ -573,11 +802,48 @@ void FindEuclideanDistMap::find_euclideandistmap()
     }
   }
 
+  bool doParallel = false;
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
-  bool doParallel = true;
+  doParallel = true;
 #endif
 
+  if(m_CalcExactEuclideanDist == true && m_CalcOnlyManhattanDist == false)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::task_group* g = new tbb::task_group;
+      if(m_DoBoundaries == true)
+      {
+        g->run(FindExactEuclideanMap(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 0, doParallel));
+      }
+      if(m_DoTripleLines == true)
+      {
+        g->run(FindExactEuclideanMap(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 1, doParallel));
+      }
+      if(m_DoQuadPoints == true)
+      {
+        g->run(FindExactEuclideanMap(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 2, doParallel));
+      }
+      g->wait();
+      delete g;
+    }
+    else
+#endif
+    {
+      for(int32_t i = 0; i < 3; i++)
+      {
+        if((i == 0 && m_DoBoundaries == true) || (i == 1 && m_DoTripleLines == true) || (i == 2 && m_DoQuadPoints == true))
+        {
+          FindExactEuclideanMap f(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, i, doParallel);
+          f();
+        }
+      }
+    }
+    return;
+  }
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
@@ -84,6 +84,9 @@ class FindEuclideanDistMap : public AbstractFilter
     SIMPL_FILTER_PARAMETER(bool, CalcOnlyManhattanDist)
     Q_PROPERTY(bool CalcOnlyManhattanDist READ getCalcOnlyManhattanDist WRITE setCalcOnlyManhattanDist)
 
+    SIMPL_FILTER_PARAMETER(bool, CalcExactEuclideanDist)
+    Q_PROPERTY(bool CalcExactEuclideanDist READ getCalcExactEuclideanDist WRITE setCalcExactEuclideanDist)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
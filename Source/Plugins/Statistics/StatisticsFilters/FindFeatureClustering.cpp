@@ -35,12 +35,21 @@
 
 #include "FindFeatureClustering.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -51,6 +60,75 @@
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
+#include "Statistics/StatisticsFilters/util/PointGrid.hpp"
+
+/**
+ * @brief The FindFeatureClusteringImpl class finds, for a range of Features, the distances to all other
+ * Features of the same phase that lie within the search radius
+ */
+class FindFeatureClusteringImpl
+{
+public:
+  FindFeatureClusteringImpl(float* centroids, const PointGrid* grid, float radius, const std::vector<size_t>& features, std::vector<std::vector<float>>& clusteringList,
+                            std::vector<std::vector<size_t>>& clusteringIds)
+  : m_Centroids(centroids)
+  , m_Grid(grid)
+  , m_Radius(radius)
+  , m_Features(features)
+  , m_ClusteringList(clusteringList)
+  , m_ClusteringIds(clusteringIds)
+  {
+  }
+  virtual ~FindFeatureClusteringImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    std::vector<size_t> found;
+    for(size_t f = start; f < end; f++)
+    {
+      size_t i = m_Features[f];
+      found.clear();
+      m_Grid->findPointsWithinRadius(&(m_Centroids[3 * i]), m_Radius, found);
+      // Keep the same list order as the all pairs search, which visits Features by increasing Id
+      std::sort(found.begin(), found.end());
+      for(size_t n = 0; n < found.size(); n++)
+      {
+        size_t j = found[n];
+        if(j == i)
+        {
+          continue;
+        }
+        size_t a = (i < j) ? i : j;
+        size_t b = (i < j) ? j : i;
+        float x = m_Centroids[3 * a];
+        float y = m_Centroids[3 * a + 1];
+        float z = m_Centroids[3 * a + 2];
+        float xn = m_Centroids[3 * b];
+        float yn = m_Centroids[3 * b + 1];
+        float zn = m_Centroids[3 * b + 2];
+        float r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+        m_ClusteringList[i].push_back(r);
+        m_ClusteringIds[i].push_back(j);
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+private:
+  float* m_Centroids;
+  const PointGrid* m_Grid;
+  float m_Radius;
+  const std::vector<size_t>& m_Features;
+  std::vector<std::vector<float>>& m_ClusteringList;
+  std::vector<std::vector<size_t>>& m_ClusteringIds;
+};
 
 // Include the MOC generated file for this class
 #include "moc_FindFeatureClustering.cpp"
@@ -65,6 +143,8 @@ FindFeatureClustering::FindFeatureClustering()
 , m_PhaseNumber(1)
 , m_CellEnsembleAttributeMatrixName(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, "")
 , m_RemoveBiasedFeatures(false)
+, m_UseSearchRadius(false)
+, m_SearchRadius(1.0f)
 , m_EquivalentDiametersArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EquivalentDiameters)
 , m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases)
 , m_CentroidsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids)
@@ -98,6 +178,10 @@ void FindFeatureClustering::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Phase Index", PhaseNumber, FilterParameter::Parameter, FindFeatureClustering));
   QStringList linkedProps("BiasedFeaturesArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Remove Biased Features", RemoveBiasedFeatures, FilterParameter::Parameter, FindFeatureClustering, linkedProps));
+  linkedProps.clear();
+  linkedProps << "SearchRadius";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Limit Search Radius", UseSearchRadius, FilterParameter::Parameter, FindFeatureClustering, linkedProps));
+  parameters.push_back(SIMPL_NEW_DOUBLE_FP("Search Radius", SearchRadius, FilterParameter::Parameter, FindFeatureClustering));
   parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -150,6 +234,8 @@ void FindFeatureClustering::readFilterParameters(AbstractFilterParametersReader*
   setPhaseNumber(reader->readValue("PhaseNumber", getPhaseNumber()));
   setBiasedFeaturesArrayPath(reader->readDataArrayPath("BiasedFeaturesArrayPath", getBiasedFeaturesArrayPath()));
   setRemoveBiasedFeatures(reader->readValue("RemoveBiasedFeatures", getRemoveBiasedFeatures()));
+  setUseSearchRadius(reader->readValue("UseSearchRadius", getUseSearchRadius()));
+  setSearchRadius(reader->readValue("SearchRadius", getSearchRadius()));
   reader->closeFilterGroup();
 }
 
@@ -169,6 +255,13 @@ void FindFeatureClustering::dataCheck()
 {
   setErrorCondition(0);
   initialize();
+  if(m_UseSearchRadius == true && m_SearchRadius <= 0.0f)
+  {
+    setErrorCondition(-11000);
+    QString ss = QObject::tr("The search radius (%1) must be positive").arg(m_SearchRadius);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getEquivalentDiametersArrayPath().getDataContainerName());
 
   DataArrayPath tempPath;
@@ -308,36 +401,83 @@ void FindFeatureClustering::find_clustering()
 
   clusteringlist.resize(totalFeatures);
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  if(m_UseSearchRadius == true)
   {
-    if(m_FeaturePhases[i] == m_PhaseNumber)
+    std::vector<size_t> phaseFeatures;
+    phaseFeatures.reserve(totalPPTfeatures);
+    for(size_t i = 1; i < totalFeatures; i++)
     {
-      if(i % 1000 == 0)
+      if(m_FeaturePhases[i] == m_PhaseNumber)
       {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        phaseFeatures.push_back(i);
       }
+    }
+
+    PointGrid grid(m_Centroids, phaseFeatures, m_SearchRadius);
+    std::vector<std::vector<size_t>> clusteringIds(totalFeatures);
+    FindFeatureClusteringImpl serial(m_Centroids, &grid, m_SearchRadius, phaseFeatures, clusteringlist, clusteringIds);
 
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, phaseFeatures.size()), serial, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      serial.generate(0, phaseFeatures.size());
+    }
 
-      for(size_t j = i + 1; j < totalFeatures; j++)
+    for(size_t f = 0; f < phaseFeatures.size(); f++)
+    {
+      size_t i = phaseFeatures[f];
+      for(size_t j = 0; j < clusteringIds[i].size(); j++)
       {
-        if(m_FeaturePhases[i] == m_FeaturePhases[j])
+        if(writeErrorFile == true && clusteringIds[i][j] > i && m_FeaturePhases[clusteringIds[i][j]] == 2)
         {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
-
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+          outFile << clusteringlist[i][j] << "\n" << clusteringlist[i][j] << "\n";
+        }
+      }
+    }
+  }
+  else
+  {
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      if(m_FeaturePhases[i] == m_PhaseNumber)
+      {
+        if(i % 1000 == 0)
+        {
+          QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
+          notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        }
 
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
+        x = m_Centroids[3 * i];
+        y = m_Centroids[3 * i + 1];
+        z = m_Centroids[3 * i + 2];
 
-          if(writeErrorFile == true && m_FeaturePhases[j] == 2)
+        for(size_t j = i + 1; j < totalFeatures; j++)
+        {
+          if(m_FeaturePhases[i] == m_FeaturePhases[j])
           {
-            outFile << r << "\n" << r << "\n";
+            xn = m_Centroids[3 * j];
+            yn = m_Centroids[3 * j + 1];
+            zn = m_Centroids[3 * j + 2];
+
+            r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+
+            clusteringlist[i].push_back(r);
+            clusteringlist[j].push_back(r);
+
+            if(writeErrorFile == true && m_FeaturePhases[j] == 2)
+            {
+              outFile << r << "\n" << r << "\n";
+            }
           }
         }
       }
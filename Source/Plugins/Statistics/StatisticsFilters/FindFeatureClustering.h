@@ -69,6 +69,12 @@ class FindFeatureClustering : public AbstractFilter
     SIMPL_FILTER_PARAMETER(bool, RemoveBiasedFeatures)
     Q_PROPERTY(bool RemoveBiasedFeatures READ getRemoveBiasedFeatures WRITE setRemoveBiasedFeatures)
 
+    SIMPL_FILTER_PARAMETER(bool, UseSearchRadius)
+    Q_PROPERTY(bool UseSearchRadius READ getUseSearchRadius WRITE setUseSearchRadius)
+
+    SIMPL_FILTER_PARAMETER(float, SearchRadius)
+    Q_PROPERTY(float SearchRadius READ getSearchRadius WRITE setSearchRadius)
+
     SIMPL_FILTER_PARAMETER(DataArrayPath, BiasedFeaturesArrayPath)
     Q_PROPERTY(DataArrayPath BiasedFeaturesArrayPath READ getBiasedFeaturesArrayPath WRITE setBiasedFeaturesArrayPath)
 
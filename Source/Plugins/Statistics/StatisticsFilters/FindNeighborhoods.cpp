@@ -35,6 +35,15 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -46,6 +55,57 @@
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
+#include "Statistics/StatisticsFilters/util/PointGrid.hpp"
+
+/**
+ * @brief The FindNeighborhoodsImpl class finds, for a range of Features, all other Features whose centroid
+ * bin lies closer than the Feature's critical distance along each axis
+ */
+class FindNeighborhoodsImpl
+{
+public:
+  FindNeighborhoodsImpl(const float* binCoords, const PointGrid* grid, const std::vector<float>& criticalDistance, std::vector<std::vector<int32_t>>& neighborhoodlist)
+  : m_BinCoords(binCoords)
+  , m_Grid(grid)
+  , m_CriticalDistance(criticalDistance)
+  , m_NeighborhoodList(neighborhoodlist)
+  {
+  }
+  virtual ~FindNeighborhoodsImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    std::vector<size_t> found;
+    for(size_t i = start; i < end; i++)
+    {
+      found.clear();
+      m_Grid->findPointsWithinBox(&(m_BinCoords[3 * i]), m_CriticalDistance[i], found);
+      // Keep the same list order as the all pairs search, which visits Features by increasing Id
+      std::sort(found.begin(), found.end());
+      for(size_t n = 0; n < found.size(); n++)
+      {
+        if(found[n] != i)
+        {
+          m_NeighborhoodList[i].push_back(static_cast<int32_t>(found[n]));
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+private:
+  const float* m_BinCoords;
+  const PointGrid* m_Grid;
+  const std::vector<float>& m_CriticalDistance;
+  std::vector<std::vector<int32_t>>& m_NeighborhoodList;
+};
 
 // Include the MOC generated file for this class
 #include "moc_FindNeighborhoods.cpp"
@@ -255,50 +315,40 @@ void FindNeighborhoods::find_neighborhoods()
     bins[3 * i + 2] = zbin;
   }
 
-  int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-  float dBinX = 0, dBinY = 0, dBinZ = 0;
-  float criticalDistance1 = 0, criticalDistance2 = 0;
-
+  // Bucket the centroid bins into a grid so each Feature only visits the bins within its critical distance
+  // instead of testing every other Feature. Bin indices are small integers, so they are exact as floats.
+  std::vector<float> binCoords(3 * totalFeatures, 0.0f);
+  std::vector<size_t> features;
+  features.reserve(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    if(i % 1000 == 0)
-    {
+    binCoords[3 * i] = static_cast<float>(bins[3 * i]);
+    binCoords[3 * i + 1] = static_cast<float>(bins[3 * i + 1]);
+    binCoords[3 * i + 2] = static_cast<float>(bins[3 * i + 2]);
+    features.push_back(i);
+  }
+  PointGrid grid(binCoords.data(), features, std::max(m_MultiplesOfAverage, 1.0f));
+  FindNeighborhoodsImpl serial(binCoords.data(), &grid, criticalDistance, neighborhoodlist);
 
-      QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalFeatures);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    }
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    bin1x = bins[3 * i];
-    bin1y = bins[3 * i + 1];
-    bin1z = bins[3 * i + 2];
-    criticalDistance1 = criticalDistance[i];
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-    for(size_t j = i + 1; j < totalFeatures; j++)
-    {
-      bin2x = bins[3 * j];
-      bin2y = bins[3 * j + 1];
-      bin2z = bins[3 * j + 2];
-      criticalDistance2 = criticalDistance[j];
-      // Use the llabs version of the "C" abs function because we are using int64_t
-      // do NOT try to use the std::abs() function as this is C++11 ONLY
-      dBinX = llabs(bin2x - bin1x);
-      dBinY = llabs(bin2y - bin1y);
-      dBinZ = llabs(bin2z - bin1z);
-
-      if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.generate(1, totalFeatures);
+  }
 
-      if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
-    }
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    m_Neighborhoods[i] = static_cast<int32_t>(neighborhoodlist[i].size());
   }
   for(size_t i = 1; i < totalFeatures; i++)
   {
@@ -48,6 +48,7 @@
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
+#include "Statistics/StatisticsFilters/util/FeatureNeighborGraph.hpp"
 
 // Include the MOC generated file for this class
 #include "moc_FindNeighbors.cpp"
@@ -235,146 +236,64 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel() == true)
-    {
-      return;
-    }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(m_StoreSurfaceFeatures == true)
     {
       m_SurfaceFeatures[i] = false;
     }
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  if(m_StoreSurfaceFeatures == true)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel() == true)
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Determining Surface Features");
+    // Only voxels on the outside of the volume can mark a surface Feature. For a single slice the
+    // bottom and top planes are not considered part of the surface.
+    bool planeSurfaces = (udims[2] != 1);
+    for(size_t plane = 0; plane < udims[2]; plane++)
     {
-      return;
-    }
-
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
-    {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures == true)
+      bool surfacePlane = planeSurfaces && (plane == 0 || plane == udims[2] - 1);
+      for(size_t row = 0; row < udims[1]; row++)
       {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
+        size_t rowStart = (plane * udims[1] + row) * udims[0];
+        size_t columnStep = (surfacePlane || row == 0 || row == udims[1] - 1 || udims[0] < 2) ? 1 : udims[0] - 1;
+        for(size_t column = 0; column < udims[0]; column += columnStep)
         {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good == true && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
+          int32_t feature = m_FeatureIds[rowStart + column];
+          if(feature > 0)
+          {
+            m_SurfaceFeatures[feature] = true;
+          }
         }
       }
     }
-    if(m_StoreBoundaryCells == true)
-    {
-      m_BoundaryCells[j] = onsurf;
-    }
   }
 
+  if(getCancel() == true)
+  {
+    return;
+  }
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Determining Neighbor Lists");
+  int8_t* boundaryCells = (m_StoreBoundaryCells == true) ? m_BoundaryCells : nullptr;
+  FeatureNeighborGraph graph(m_FeatureIds, udims, totalFeatures, boundaryCells);
+
+  if(getCancel() == true)
+  {
+    return;
+  }
+
+  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
+  uint64_t currentMillis = millis;
+  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
+  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
+
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
@@ -391,42 +310,20 @@ void FindNeighbors::execute()
       return;
     }
 
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes();
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    int32_t numneighs = graph.getNumberOfNeighbors(i);
+    const int32_t* neighbors = graph.getNeighbors(i);
+    const int32_t* faceCounts = graph.getSharedFaceCounts(i);
+    m_NumNeighbors[i] = numneighs;
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighbors, neighbors + numneighs));
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(numneighs));
+    for(int32_t j = 0; j < numneighs; j++)
+    {
+      (*sharedSAL)[j] = float(faceCounts[j]) * xRes * yRes;
+    }
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 
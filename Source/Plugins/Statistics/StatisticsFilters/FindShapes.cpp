@@ -44,6 +44,7 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
@@ -241,7 +242,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -259,89 +259,43 @@ void FindShapes::find_moments()
   float modYRes = yRes * float(m_ScaleFactor);
   float modZRes = zRes * float(m_ScaleFactor);
 
-  for(size_t i = 0; i < numfeatures; i++)
+  size_t dims[3] = {xPoints, yPoints, zPoints};
+  FeatureReductionEngine reduction(m_FeatureIds, dims, numfeatures, FeatureReductionEngine::Count | FeatureReductionEngine::FirstMoments | FeatureReductionEngine::SecondMoments);
+  reduction.execute();
+
+  // Each Cell is sampled at the 8 points (x +/- modXRes / 4, y +/- modYRes / 4, z +/- modZRes / 4), so the
+  // mixed terms of the samples cancel and the moments follow from the raw moments of the Cell indices
+  double mod[3] = {modXRes, modYRes, modZRes};
+  double quarterSq[3] = {0.0, 0.0, 0.0};
+  for(size_t d = 0; d < 3; d++)
   {
-    featuremoments[6 * i + 0] = 0.0f;
-    featuremoments[6 * i + 1] = 0.0f;
-    featuremoments[6 * i + 2] = 0.0f;
-    featuremoments[6 * i + 3] = 0.0f;
-    featuremoments[6 * i + 4] = 0.0f;
-    featuremoments[6 * i + 5] = 0.0f;
+    quarterSq[d] = (mod[d] / 4.0) * (mod[d] / 4.0);
   }
-
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    double n = reduction.getCount(i);
+    const double* s1 = reduction.getFirstMoments(i);
+    const double* s2 = reduction.getSecondMoments(i);
+    double c[3] = {0.0, 0.0, 0.0};
+    for(size_t d = 0; d < 3; d++)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes);
-        y = float(j * modYRes);
-        z = float(i * modZRes);
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * m_ScaleFactor));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * m_ScaleFactor));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * m_ScaleFactor));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-        featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-        featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + zz;
-        featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + xy;
-        featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + yz;
-        featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + xz;
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
+      c[d] = m_Centroids[i * 3 + d] * m_ScaleFactor;
     }
+    // Central sums of the scaled Cell positions about the (scaled) centroid
+    double cxx = mod[0] * mod[0] * s2[0] - 2.0 * c[0] * mod[0] * s1[0] + n * c[0] * c[0];
+    double cyy = mod[1] * mod[1] * s2[1] - 2.0 * c[1] * mod[1] * s1[1] + n * c[1] * c[1];
+    double czz = mod[2] * mod[2] * s2[2] - 2.0 * c[2] * mod[2] * s1[2] + n * c[2] * c[2];
+    double cxy = mod[0] * mod[1] * s2[3] - c[0] * mod[1] * s1[1] - c[1] * mod[0] * s1[0] + n * c[0] * c[1];
+    double cyz = mod[1] * mod[2] * s2[4] - c[1] * mod[2] * s1[2] - c[2] * mod[1] * s1[1] + n * c[1] * c[2];
+    double cxz = mod[0] * mod[2] * s2[5] - c[0] * mod[2] * s1[2] - c[2] * mod[0] * s1[0] + n * c[0] * c[2];
+
+    featuremoments[i * 6 + 0] = 8.0 * (cyy + czz) + 8.0 * n * (quarterSq[1] + quarterSq[2]);
+    featuremoments[i * 6 + 1] = 8.0 * (cxx + czz) + 8.0 * n * (quarterSq[0] + quarterSq[2]);
+    featuremoments[i * 6 + 2] = 8.0 * (cxx + cyy) + 8.0 * n * (quarterSq[0] + quarterSq[1]);
+    featuremoments[i * 6 + 3] = 8.0 * cxy;
+    featuremoments[i * 6 + 4] = 8.0 * cyz;
+    featuremoments[i * 6 + 5] = 8.0 * cxz;
+    m_Volumes[i] = static_cast<float>(n);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
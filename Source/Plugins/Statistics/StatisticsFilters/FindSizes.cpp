@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -205,22 +207,16 @@ void FindSizes::preflight()
 // -----------------------------------------------------------------------------
 void FindSizes::findSizesImage(ImageGeom::Pointer image)
 {
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
+  size_t dims[3] = {image->getXPoints(), image->getYPoints(), image->getZPoints()};
 
-  DataArray<float>::Pointer m_FeatureCounts = DataArray<float>::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  m_FeatureCounts->initializeWithZeros();
-  float* featurecounts = m_FeatureCounts->getPointer(0);
+  FeatureReductionEngine reduction(m_FeatureIds, dims, numfeatures, FeatureReductionEngine::Count);
+  reduction.execute();
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
-
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
+  double featurecount = 0.0;
 
   if(image->getXPoints() == 1 || image->getYPoints() == 1 || image->getZPoints() == 1)
   {
@@ -238,8 +234,9 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
     }
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      m_Volumes[i] = (featurecounts[i] * res_scalar);
+      featurecount = reduction.getCount(i);
+      m_NumElements[i] = static_cast<int32_t>(featurecount);
+      m_Volumes[i] = static_cast<float>(featurecount * res_scalar);
       rad = m_Volumes[i] / SIMPLib::Constants::k_Pi;
       diameter = (2 * sqrtf(rad));
       m_EquivalentDiameters[i] = diameter;
@@ -251,8 +248,9 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
     float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      m_Volumes[i] = (featurecounts[i] * res_scalar);
+      featurecount = reduction.getCount(i);
+      m_NumElements[i] = static_cast<int32_t>(featurecount);
+      m_Volumes[i] = static_cast<float>(featurecount * res_scalar);
       rad = m_Volumes[i] / vol_term;
       diameter = 2.0f * powf(rad, 0.3333333333f);
       m_EquivalentDiameters[i] = diameter;
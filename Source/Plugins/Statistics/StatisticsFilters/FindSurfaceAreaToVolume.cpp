@@ -42,6 +42,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -172,28 +174,25 @@ void FindSurfaceAreaToVolume::execute()
     return;
   }
 
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_NumCellsArrayPath.getDataContainerName());
+  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
+  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
+  float zRes = m->getGeometryAs<ImageGeom>()->getZRes();
+
+  size_t dims[3] = {m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints()};
+
+  // The exposed faces and the largest Feature Id are gathered in the same pass; Feature Ids beyond the
+  // NumCells array are skipped by the reduction and reported below before any result is written
+  int32_t numFeatures = static_cast<int32_t>(m_NumCellsPtr.lock()->getNumberOfTuples());
+  FeatureReductionEngine reduction(m_FeatureIds, dims, static_cast<size_t>(numFeatures), FeatureReductionEngine::ExposedFaces);
+  reduction.execute();
+
   // Validate that the selected InArray has tuples equal to the largest
   // Feature Id; the filter would not crash otherwise, but the user should
   // be notified of unanticipated behavior ; this cannot be done in the dataCheck since
   // we don't have acces to the data yet
-  int32_t numFeatures = static_cast<int32_t>(m_NumCellsPtr.lock()->getNumberOfTuples());
-  bool mismatchedFeatures = false;
-  int32_t largestFeature = 0;
-  size_t numTuples = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-  for(size_t i = 0; i < numTuples; i++)
-  {
-    if(m_FeatureIds[i] > largestFeature)
-    {
-      largestFeature = m_FeatureIds[i];
-      if(largestFeature >= numFeatures)
-      {
-        mismatchedFeatures = true;
-        break;
-      }
-    }
-  }
-
-  if(mismatchedFeatures == true)
+  int32_t largestFeature = std::max(reduction.getLargestFeatureId(), 0);
+  if(largestFeature >= numFeatures)
   {
     QString ss = QObject::tr("The number of Features in the NumCells array (%1) is larger than the largest Feature Id in the FeatureIds array").arg(numFeatures);
     setErrorCondition(-5555);
@@ -209,97 +208,14 @@ void FindSurfaceAreaToVolume::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_NumCellsArrayPath.getDataContainerName());
-  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
-  float zRes = m->getGeometryAs<ImageGeom>()->getZRes();
-
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-  std::vector<float> featureSurfaceArea(numFeatures);
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  int32_t feature = 0;
-  float onsurf = 0.0f;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        onsurf = 0.0f;
-        feature = m_FeatureIds[zStride + yStride + k];
-        if(feature > 0)
-        {
-          for(int32_t l = 0; l < 6; l++)
-          {
-            good = true;
-            neighbor = zStride + yStride + k + neighpoints[l];
-            if(l == 0 && i == 0)
-            {
-              good = false;
-            }
-            if(l == 5 && i == (zPoints - 1))
-            {
-              good = false;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = false;
-            }
-            if(l == 4 && j == (yPoints - 1))
-            {
-              good = false;
-            }
-            if(l == 2 && k == 0)
-            {
-              good = false;
-            }
-            if(l == 3 && k == (xPoints - 1))
-            {
-              good = false;
-            }
-            if(good == true && m_FeatureIds[neighbor] != feature)
-            {
-              if(l == 0 || l == 5) // XY face shared
-              {
-                onsurf = onsurf + xRes * yRes;
-              }
-              if(l == 1 || l == 4) // YZ face shared
-              {
-                onsurf = onsurf + yRes * zRes;
-              }
-              if(l == 2 || l == 3) // XZ face shared
-              {
-                onsurf = onsurf + zRes * xRes;
-              }
-            }
-          }
-        }
-
-        featureSurfaceArea[m_FeatureIds[zStride + yStride + k]] = featureSurfaceArea[m_FeatureIds[zStride + yStride + k]] + onsurf;
-      }
-    }
-  }
-
+  float xyFace = xRes * yRes; // XY face shared with a z neighbor
+  float yzFace = yRes * zRes; // YZ face shared with a y neighbor
+  float xzFace = zRes * xRes; // XZ face shared with an x neighbor
   for(int32_t i = 1; i < numFeatures; i++)
   {
-    m_SurfaceAreaVolumeRatio[i] = featureSurfaceArea[i] / (m_NumCells[i] * xRes * yRes * zRes);
+    const double* faces = reduction.getExposedFaces(static_cast<size_t>(i));
+    float featureSurfaceArea = static_cast<float>(faces[2] * xyFace + faces[1] * yzFace + faces[0] * xzFace);
+    m_SurfaceAreaVolumeRatio[i] = featureSurfaceArea / (m_NumCells[i] * xRes * yRes * zRes);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
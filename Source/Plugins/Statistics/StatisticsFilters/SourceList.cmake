@@ -65,7 +65,10 @@ foreach(f ${_PrivateFilters} )
 endforeach()
 
 
-
+#-------------
+# These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_SIMPL_SUPPORT_HEADER_SUBDIR(${Statistics_SOURCE_DIR} ${_filterGroupName} FeatureNeighborGraph.hpp util)
+ADD_SIMPL_SUPPORT_HEADER_SUBDIR(${Statistics_SOURCE_DIR} ${_filterGroupName} PointGrid.hpp util)
 
 SIMPL_END_FILTER_GROUP(${Statistics_BINARY_DIR} "${_filterGroupName}" "Statistics Filters")
 
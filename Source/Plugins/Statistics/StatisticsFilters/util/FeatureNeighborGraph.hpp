@@ -0,0 +1,258 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _featureneighborgraph_hpp_
+#define _featureneighborgraph_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The FindFacePairsImpl class scans blocks of voxels of an image and emits one key per voxel face
+ * that separates two different Features, encoded as (feature << 32 | neighbor). Each block writes its own
+ * key list, so the scan can run on several threads without any locking.
+ */
+class FindFacePairsImpl
+{
+  public:
+    FindFacePairsImpl(const int32_t* featureIds, const int64_t dims[3], size_t blockSize, std::vector<std::vector<uint64_t> >& blockKeys, int8_t* boundaryCells)
+    : m_FeatureIds(featureIds)
+    , m_BlockSize(blockSize)
+    , m_BlockKeys(blockKeys)
+    , m_BoundaryCells(boundaryCells)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+
+    virtual ~FindFacePairsImpl() {}
+
+    void generate(size_t start, size_t end) const
+    {
+      int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+      int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+      for(size_t b = start; b < end; b++)
+      {
+        std::vector<uint64_t>& keys = m_BlockKeys[b];
+        int64_t first = static_cast<int64_t>(b * m_BlockSize);
+        int64_t last = std::min(first + static_cast<int64_t>(m_BlockSize), totalPoints);
+        for(int64_t j = first; j < last; j++)
+        {
+          int8_t onsurf = 0;
+          int32_t feature = m_FeatureIds[j];
+          if(feature > 0)
+          {
+            int64_t column = j % m_Dims[0];
+            int64_t row = (j / m_Dims[0]) % m_Dims[1];
+            int64_t plane = j / (m_Dims[0] * m_Dims[1]);
+            bool good[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+            for(int32_t k = 0; k < 6; k++)
+            {
+              if(good[k] == false)
+              {
+                continue;
+              }
+              int32_t neighborFeature = m_FeatureIds[j + neighpoints[k]];
+              if(neighborFeature != feature && neighborFeature > 0)
+              {
+                onsurf++;
+                keys.push_back((static_cast<uint64_t>(feature) << 32) | static_cast<uint64_t>(neighborFeature));
+              }
+            }
+          }
+          if(nullptr != m_BoundaryCells)
+          {
+            m_BoundaryCells[j] = onsurf;
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const int32_t* m_FeatureIds;
+    int64_t m_Dims[3];
+    size_t m_BlockSize;
+    std::vector<std::vector<uint64_t> >& m_BlockKeys;
+    int8_t* m_BoundaryCells;
+};
+
+/**
+ * @brief The FeatureNeighborGraph class holds the face-adjacency of the Features in an image as compressed
+ * sparse rows: the neighbors of Feature i are getNeighbors(i)[0 .. getNumberOfNeighbors(i) - 1], sorted by
+ * Feature Id, and getSharedFaceCounts(i) holds the number of voxel faces shared with each of them. Feature
+ * Ids of 0 or less are not neighbors of anything. The face pairs are collected per block of voxels, sorted
+ * and reduced, so no per-Feature lists are allocated while building.
+ */
+class FeatureNeighborGraph
+{
+  public:
+    /**
+     * @brief FeatureNeighborGraph Builds the graph
+     * @param featureIds Feature Ids of the image, X fastest
+     * @param dims Dimensions of the image
+     * @param numFeatures Number of Features, including Feature 0; larger Ids are ignored
+     * @param boundaryCells Optional output receiving, for each voxel, how many of its faces touch another Feature
+     */
+    FeatureNeighborGraph(const int32_t* featureIds, const size_t dims[3], size_t numFeatures, int8_t* boundaryCells = nullptr)
+    : m_Offsets(numFeatures + 1, 0)
+    {
+      int64_t idims[3] = {static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2])};
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      size_t numBlocks = (totalPoints + k_BlockSize - 1) / k_BlockSize;
+      std::vector<std::vector<uint64_t> > blockKeys(numBlocks);
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+      FindFacePairsImpl impl(featureIds, idims, k_BlockSize, blockKeys, boundaryCells);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.generate(0, numBlocks);
+      }
+
+      size_t numKeys = 0;
+      for(size_t b = 0; b < numBlocks; b++)
+      {
+        numKeys += blockKeys[b].size();
+      }
+      std::vector<uint64_t> keys;
+      keys.reserve(numKeys);
+      for(size_t b = 0; b < numBlocks; b++)
+      {
+        keys.insert(keys.end(), blockKeys[b].begin(), blockKeys[b].end());
+        std::vector<uint64_t>().swap(blockKeys[b]);
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_sort(keys.begin(), keys.end());
+      }
+      else
+#endif
+      {
+        std::sort(keys.begin(), keys.end());
+      }
+
+      // Reduce the runs of equal keys into one neighbor entry with its face count
+      for(size_t i = 0; i < keys.size();)
+      {
+        size_t runEnd = i + 1;
+        while(runEnd < keys.size() && keys[runEnd] == keys[i])
+        {
+          runEnd++;
+        }
+        size_t feature = static_cast<size_t>(keys[i] >> 32);
+        if(feature < numFeatures)
+        {
+          m_Neighbors.push_back(static_cast<int32_t>(keys[i] & 0xFFFFFFFFULL));
+          m_SharedFaceCounts.push_back(static_cast<int32_t>(runEnd - i));
+          m_Offsets[feature + 1]++;
+        }
+        i = runEnd;
+      }
+      for(size_t f = 0; f < numFeatures; f++)
+      {
+        m_Offsets[f + 1] += m_Offsets[f];
+      }
+    }
+
+    virtual ~FeatureNeighborGraph() {}
+
+    size_t getNumberOfFeatures() const
+    {
+      return m_Offsets.size() - 1;
+    }
+
+    int32_t getNumberOfNeighbors(size_t feature) const
+    {
+      return static_cast<int32_t>(m_Offsets[feature + 1] - m_Offsets[feature]);
+    }
+
+    const int32_t* getNeighbors(size_t feature) const
+    {
+      return m_Neighbors.data() + m_Offsets[feature];
+    }
+
+    const int32_t* getSharedFaceCounts(size_t feature) const
+    {
+      return m_SharedFaceCounts.data() + m_Offsets[feature];
+    }
+
+    const std::vector<size_t>& getOffsets() const
+    {
+      return m_Offsets;
+    }
+
+  private:
+    static const size_t k_BlockSize = 1 << 16;
+
+    std::vector<size_t> m_Offsets;
+    std::vector<int32_t> m_Neighbors;
+    std::vector<int32_t> m_SharedFaceCounts;
+
+    FeatureNeighborGraph(const FeatureNeighborGraph&); // Copy Constructor Not Implemented
+    void operator=(const FeatureNeighborGraph&); // Operator '=' Not Implemented
+};
+
+#endif /* _featureneighborgraph_hpp_ */
@@ -0,0 +1,244 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _pointgrid_hpp_
+#define _pointgrid_hpp_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The PointGrid class is a uniform grid (cell list) over a subset of 3D points, such as
+ * Feature centroids. Points are bucketed by a counting sort into cells whose edge is at least the
+ * search radius, so a fixed radius query only has to visit the 27 surrounding cells. The grid is
+ * read-only after construction, so queries may be issued concurrently from several threads.
+ */
+class PointGrid
+{
+  public:
+    /**
+     * @brief PointGrid Builds the grid
+     * @param coords Interleaved XYZ coordinates for all points
+     * @param indices The indices of the points to place in the grid
+     * @param cellSize Edge length of a grid cell; should be at least the largest query radius
+     */
+    PointGrid(const float* coords, const std::vector<size_t>& indices, float cellSize)
+    : m_Coords(coords)
+    , m_CellSize(cellSize)
+    {
+      m_Origin[0] = m_Origin[1] = m_Origin[2] = 0.0f;
+      m_Dims[0] = m_Dims[1] = m_Dims[2] = 1;
+      if(indices.empty())
+      {
+        m_CellStarts.assign(2, 0);
+        return;
+      }
+
+      float maxCoord[3] = {0.0f, 0.0f, 0.0f};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        m_Origin[d] = maxCoord[d] = coords[3 * indices[0] + d];
+      }
+      for(size_t i = 1; i < indices.size(); i++)
+      {
+        for(int32_t d = 0; d < 3; d++)
+        {
+          float c = coords[3 * indices[i] + d];
+          m_Origin[d] = (c < m_Origin[d]) ? c : m_Origin[d];
+          maxCoord[d] = (c > maxCoord[d]) ? c : maxCoord[d];
+        }
+      }
+
+      // Grow the cells if needed so the grid never has many more cells than points
+      float extent = 0.0f;
+      for(int32_t d = 0; d < 3; d++)
+      {
+        extent = (maxCoord[d] - m_Origin[d] > extent) ? maxCoord[d] - m_Origin[d] : extent;
+      }
+      if(m_CellSize <= 0.0f || extent / m_CellSize > static_cast<float>(k_MaxCellsPerDim))
+      {
+        m_CellSize = (extent > 0.0f) ? extent / static_cast<float>(k_MaxCellsPerDim) : 1.0f;
+      }
+      while(true)
+      {
+        for(int32_t d = 0; d < 3; d++)
+        {
+          m_Dims[d] = static_cast<int64_t>((maxCoord[d] - m_Origin[d]) / m_CellSize) + 1;
+        }
+        if(m_Dims[0] * m_Dims[1] * m_Dims[2] <= static_cast<int64_t>(2 * indices.size()) + 8)
+        {
+          break;
+        }
+        m_CellSize *= 1.5f;
+      }
+
+      // Counting sort of the points into the cells
+      size_t numCells = static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+      std::vector<size_t> pointCells(indices.size(), 0);
+      m_CellStarts.assign(numCells + 1, 0);
+      for(size_t i = 0; i < indices.size(); i++)
+      {
+        pointCells[i] = cellIndex(&(coords[3 * indices[i]]));
+        m_CellStarts[pointCells[i] + 1]++;
+      }
+      for(size_t c = 0; c < numCells; c++)
+      {
+        m_CellStarts[c + 1] += m_CellStarts[c];
+      }
+      std::vector<size_t> fill(m_CellStarts.begin(), m_CellStarts.end() - 1);
+      m_CellPoints.resize(indices.size());
+      for(size_t i = 0; i < indices.size(); i++)
+      {
+        m_CellPoints[fill[pointCells[i]]++] = indices[i];
+      }
+    }
+
+    virtual ~PointGrid() {}
+
+    /**
+     * @brief findPointsWithinRadius Appends to result the indices of all points in the grid whose distance
+     * to the given position is not greater than radius. Indices within one grid cell keep the order in which
+     * they were given to the constructor, but the overall order is by cell.
+     */
+    void findPointsWithinRadius(const float pos[3], float radius, std::vector<size_t>& result) const
+    {
+      if(m_CellPoints.empty())
+      {
+        return;
+      }
+      // Pad the searched range slightly so rounding can never drop a point that passes the distance test
+      float reach = radius + 0.001f * m_CellSize;
+      int64_t lo[3] = {0, 0, 0};
+      int64_t hi[3] = {0, 0, 0};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        lo[d] = static_cast<int64_t>(std::floor((pos[d] - reach - m_Origin[d]) / m_CellSize));
+        hi[d] = static_cast<int64_t>(std::floor((pos[d] + reach - m_Origin[d]) / m_CellSize));
+        lo[d] = (lo[d] < 0) ? 0 : lo[d];
+        hi[d] = (hi[d] > m_Dims[d] - 1) ? m_Dims[d] - 1 : hi[d];
+      }
+      for(int64_t z = lo[2]; z <= hi[2]; z++)
+      {
+        for(int64_t y = lo[1]; y <= hi[1]; y++)
+        {
+          for(int64_t x = lo[0]; x <= hi[0]; x++)
+          {
+            size_t cell = static_cast<size_t>((z * m_Dims[1] + y) * m_Dims[0] + x);
+            for(size_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+            {
+              size_t point = m_CellPoints[i];
+              const float* c = &(m_Coords[3 * point]);
+              float r = sqrtf((pos[0] - c[0]) * (pos[0] - c[0]) + (pos[1] - c[1]) * (pos[1] - c[1]) + (pos[2] - c[2]) * (pos[2] - c[2]));
+              if(r <= radius)
+              {
+                result.push_back(point);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief findPointsWithinBox Appends to result the indices of all points in the grid whose distance to the
+     * given position along each of the three axes is less than halfWidth. The order is the same as for
+     * findPointsWithinRadius.
+     */
+    void findPointsWithinBox(const float pos[3], float halfWidth, std::vector<size_t>& result) const
+    {
+      if(m_CellPoints.empty() || !(halfWidth > 0.0f))
+      {
+        return;
+      }
+      float reach = halfWidth + 0.001f * m_CellSize;
+      int64_t lo[3] = {0, 0, 0};
+      int64_t hi[3] = {0, 0, 0};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        // Clamp before converting so that very large boxes cannot overflow the cell index
+        float first = std::floor((pos[d] - reach - m_Origin[d]) / m_CellSize);
+        float last = std::floor((pos[d] + reach - m_Origin[d]) / m_CellSize);
+        lo[d] = (first < 0.0f) ? 0 : (first > static_cast<float>(m_Dims[d] - 1)) ? m_Dims[d] : static_cast<int64_t>(first);
+        hi[d] = (last > static_cast<float>(m_Dims[d] - 1)) ? m_Dims[d] - 1 : (last < 0.0f) ? -1 : static_cast<int64_t>(last);
+      }
+      for(int64_t z = lo[2]; z <= hi[2]; z++)
+      {
+        for(int64_t y = lo[1]; y <= hi[1]; y++)
+        {
+          for(int64_t x = lo[0]; x <= hi[0]; x++)
+          {
+            size_t cell = static_cast<size_t>((z * m_Dims[1] + y) * m_Dims[0] + x);
+            for(size_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+            {
+              size_t point = m_CellPoints[i];
+              const float* c = &(m_Coords[3 * point]);
+              if(std::fabs(pos[0] - c[0]) < halfWidth && std::fabs(pos[1] - c[1]) < halfWidth && std::fabs(pos[2] - c[2]) < halfWidth)
+              {
+                result.push_back(point);
+              }
+            }
+          }
+        }
+      }
+    }
+
+  private:
+    static const int64_t k_MaxCellsPerDim = 1 << 20;
+
+    const float* m_Coords;
+    float m_CellSize;
+    float m_Origin[3];
+    int64_t m_Dims[3];
+    std::vector<size_t> m_CellStarts;
+    std::vector<size_t> m_CellPoints;
+
+    size_t cellIndex(const float* pos) const
+    {
+      int64_t idx[3] = {0, 0, 0};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        idx[d] = static_cast<int64_t>((pos[d] - m_Origin[d]) / m_CellSize);
+        idx[d] = (idx[d] > m_Dims[d] - 1) ? m_Dims[d] - 1 : idx[d];
+        idx[d] = (idx[d] < 0) ? 0 : idx[d];
+      }
+      return static_cast<size_t>((idx[2] * m_Dims[1] + idx[1]) * m_Dims[0] + idx[0]);
+    }
+
+    PointGrid(const PointGrid&); // Copy Constructor Not Implemented
+    void operator=(const PointGrid&); // Operator '=' Not Implemented
+};
+
+#endif /* _pointgrid_hpp_ */
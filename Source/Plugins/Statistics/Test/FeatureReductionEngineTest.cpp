@@ -0,0 +1,422 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/Utilities/FeatureReductionEngine.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FeatureReductionEngineTest
+{
+public:
+  FeatureReductionEngineTest()
+  {
+  }
+  virtual ~FeatureReductionEngineTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FeatureReductionEngineTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindShapes Filter from the FilterManager
+    QString filtName = "FindShapes";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FeatureReductionEngineTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares every accumulator of the engine with a plain loop over the Cells
+  // -----------------------------------------------------------------------------
+  void checkReduction(const size_t dims[3], const std::vector<int32_t>& featureIds, size_t numFeatures, const std::vector<float>& scalars, const std::vector<int8_t>& boundaryCells,
+                      size_t numChunks)
+  {
+    int64_t xPoints = static_cast<int64_t>(dims[0]);
+    int64_t yPoints = static_cast<int64_t>(dims[1]);
+    int64_t zPoints = static_cast<int64_t>(dims[2]);
+    std::vector<double> counts(numFeatures, 0.0);
+    std::vector<double> firstMoments(numFeatures * 3, 0.0);
+    std::vector<double> secondMoments(numFeatures * 6, 0.0);
+    std::vector<double> scalarSums(numFeatures, 0.0);
+    std::vector<double> boundaryCounts(numFeatures, 0.0);
+    std::vector<double> exposedFaces(numFeatures * 3, 0.0);
+    int32_t largestFeatureId = -1;
+
+    for(int64_t z = 0; z < zPoints; z++)
+    {
+      for(int64_t y = 0; y < yPoints; y++)
+      {
+        for(int64_t x = 0; x < xPoints; x++)
+        {
+          int64_t point = (z * yPoints + y) * xPoints + x;
+          int32_t feature = featureIds[point];
+          largestFeatureId = std::max(largestFeatureId, feature);
+          if(feature < 0 || feature >= static_cast<int32_t>(numFeatures))
+          {
+            continue;
+          }
+          double pos[3] = {static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+          counts[feature] += 1.0;
+          for(size_t d = 0; d < 3; d++)
+          {
+            firstMoments[feature * 3 + d] += pos[d];
+            secondMoments[feature * 6 + d] += pos[d] * pos[d];
+          }
+          secondMoments[feature * 6 + 3] += pos[0] * pos[1];
+          secondMoments[feature * 6 + 4] += pos[1] * pos[2];
+          secondMoments[feature * 6 + 5] += pos[0] * pos[2];
+          scalarSums[feature] += static_cast<double>(scalars[point]);
+          if(boundaryCells[point] > 0)
+          {
+            boundaryCounts[feature] += 1.0;
+          }
+          if(feature == 0)
+          {
+            continue;
+          }
+          const int64_t neighbors[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+          for(size_t n = 0; n < 6; n++)
+          {
+            int64_t nx = x + neighbors[n][0];
+            int64_t ny = y + neighbors[n][1];
+            int64_t nz = z + neighbors[n][2];
+            if(nx < 0 || nx >= xPoints || ny < 0 || ny >= yPoints || nz < 0 || nz >= zPoints)
+            {
+              continue;
+            }
+            if(featureIds[(nz * yPoints + ny) * xPoints + nx] != feature)
+            {
+              exposedFaces[feature * 3 + n / 2] += 1.0;
+            }
+          }
+        }
+      }
+    }
+
+    uint32_t all = FeatureReductionEngine::Count | FeatureReductionEngine::FirstMoments | FeatureReductionEngine::SecondMoments | FeatureReductionEngine::ScalarSum |
+                   FeatureReductionEngine::BoundaryCount | FeatureReductionEngine::ExposedFaces;
+    FeatureReductionEngine reduction(featureIds.data(), dims, numFeatures, all);
+    reduction.setBoundaryCells(boundaryCells.data());
+    reduction.setNumberOfChunks(numChunks);
+    reduction.execute<float>(scalars.data());
+
+    // A subset of the accumulators, so the record layout has gaps
+    FeatureReductionEngine faces(featureIds.data(), dims, numFeatures, FeatureReductionEngine::Count | FeatureReductionEngine::ExposedFaces);
+    faces.setNumberOfChunks(numChunks);
+    faces.execute();
+
+    DREAM3D_REQUIRE_EQUAL(reduction.getLargestFeatureId(), largestFeatureId)
+    DREAM3D_REQUIRE_EQUAL(faces.getLargestFeatureId(), largestFeatureId)
+    // The scalars are small integers, so every sum is exact in any order
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(reduction.getCount(i), counts[i])
+      DREAM3D_REQUIRE_EQUAL(faces.getCount(i), counts[i])
+      for(size_t d = 0; d < 3; d++)
+      {
+        DREAM3D_REQUIRE_EQUAL(reduction.getFirstMoments(i)[d], firstMoments[i * 3 + d])
+        DREAM3D_REQUIRE_EQUAL(reduction.getExposedFaces(i)[d], exposedFaces[i * 3 + d])
+        DREAM3D_REQUIRE_EQUAL(faces.getExposedFaces(i)[d], exposedFaces[i * 3 + d])
+      }
+      for(size_t m = 0; m < 6; m++)
+      {
+        DREAM3D_REQUIRE_EQUAL(reduction.getSecondMoments(i)[m], secondMoments[i * 6 + m])
+      }
+      DREAM3D_REQUIRE_EQUAL(reduction.getScalarSum(i), scalarSums[i])
+      DREAM3D_REQUIRE_EQUAL(reduction.getBoundaryCount(i), boundaryCounts[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReduction()
+  {
+    std::mt19937 generator(1234);
+    // Feature Ids -1 and 6 are outside of the 6 Features and have to be skipped
+    std::uniform_int_distribution<int32_t> featureDistribution(-1, 6);
+    std::uniform_int_distribution<int32_t> scalarDistribution(-50, 50);
+    std::uniform_int_distribution<int32_t> boundaryDistribution(-1, 2);
+    const size_t numFeatures = 6;
+    const size_t allDims[4][3] = {{7, 5, 4}, {6, 1, 9}, {17, 1, 1}, {3, 4, 2}};
+
+    for(size_t i = 0; i < 4; i++)
+    {
+      const size_t* dims = allDims[i];
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+      std::vector<int32_t> featureIds(totalPoints, 0);
+      std::vector<float> scalars(totalPoints, 0.0f);
+      std::vector<int8_t> boundaryCells(totalPoints, 0);
+      for(size_t point = 0; point < totalPoints; point++)
+      {
+        // Mostly copy the previous Cell, so Features form runs that cross the chunk boundaries
+        featureIds[point] = (point > 0 && generator() % 3 != 0) ? featureIds[point - 1] : featureDistribution(generator);
+        scalars[point] = static_cast<float>(scalarDistribution(generator));
+        boundaryCells[point] = static_cast<int8_t>(boundaryDistribution(generator));
+      }
+
+      // Chunk boundaries in the middle of rows and planes, one Cell per chunk and more chunks than Cells
+      const size_t chunkCounts[7] = {0, 1, 2, 3, 5, totalPoints, totalPoints + 3};
+      for(size_t c = 0; c < 7; c++)
+      {
+        checkReduction(dims, featureIds, numFeatures, scalars, boundaryCells, chunkCounts[c]);
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The moments and Omega3 of the original FindShapes loop, which samples each Cell at 8 points
+  // -----------------------------------------------------------------------------
+  void bruteForceOmega3s(const size_t dims[3], const float res[3], const std::vector<int32_t>& featureIds, const std::vector<float>& centroids, std::vector<double>& omega3s,
+                         std::vector<double>& volumes)
+  {
+    size_t numFeatures = omega3s.size();
+    double scaleFactor = 1.0 / res[0];
+    if(res[1] > res[0] && res[1] > res[2])
+    {
+      scaleFactor = 1.0 / res[1];
+    }
+    if(res[2] > res[0] && res[2] > res[1])
+    {
+      scaleFactor = 1.0 / res[2];
+    }
+    double modRes[3] = {res[0] * scaleFactor, res[1] * scaleFactor, res[2] * scaleFactor};
+
+    std::vector<double> moments(numFeatures * 6, 0.0);
+    std::vector<double> counts(numFeatures, 0.0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          int32_t feature = featureIds[(z * dims[1] + y) * dims[0] + x];
+          double pos[3] = {x * modRes[0], y * modRes[1], z * modRes[2]};
+          for(int32_t sample = 0; sample < 8; sample++)
+          {
+            double dist[3] = {0.0, 0.0, 0.0};
+            for(int32_t d = 0; d < 3; d++)
+            {
+              double quarter = ((sample >> d) & 1) ? modRes[d] / 4.0 : -modRes[d] / 4.0;
+              dist[d] = pos[d] + quarter - centroids[feature * 3 + d] * scaleFactor;
+            }
+            moments[feature * 6 + 0] += dist[1] * dist[1] + dist[2] * dist[2];
+            moments[feature * 6 + 1] += dist[0] * dist[0] + dist[2] * dist[2];
+            moments[feature * 6 + 2] += dist[0] * dist[0] + dist[1] * dist[1];
+            moments[feature * 6 + 3] += dist[0] * dist[1];
+            moments[feature * 6 + 4] += dist[1] * dist[2];
+            moments[feature * 6 + 5] += dist[0] * dist[2];
+          }
+          counts[feature] += 1.0;
+        }
+      }
+    }
+
+    double sphere = (2000.0 * M_PI * M_PI) / 9.0;
+    double konst1 = (modRes[0] / 2.0) * (modRes[1] / 2.0) * (modRes[2] / 2.0);
+    double konst3 = modRes[0] * modRes[1] * modRes[2];
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      double* m = moments.data() + i * 6;
+      double u200 = (m[1] + m[2] - m[0]) * konst1 / 2.0;
+      double u020 = (m[0] + m[2] - m[1]) * konst1 / 2.0;
+      double u002 = (m[0] + m[1] - m[2]) * konst1 / 2.0;
+      double u110 = m[3] * konst1;
+      double u011 = m[4] * konst1;
+      double u101 = m[5] * konst1;
+      double o3 = (u200 * u020 * u002) + (2.0 * u110 * u101 * u011) - (u200 * u011 * u011) - (u020 * u101 * u101) - (u002 * u110 * u110);
+      double vol5 = pow(counts[i] * konst3, 5.0);
+      omega3s[i] = std::min(vol5 / o3 / sphere, 1.0);
+      volumes[i] = counts[i] * res[0] * res[1] * res[2];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindShapesMoments()
+  {
+    const size_t dims[3] = {6, 5, 4};
+    const float res[3] = {0.5f, 0.75f, 1.25f};
+    const size_t numFeatures = 5;
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    // Four blocks with a few Cells moved between them, so the Features are not aligned with the axes
+    std::mt19937 generator(5489u);
+    std::vector<int32_t> ids(totalPoints, 0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          ids[(z * dims[1] + y) * dims[0] + x] = 1 + static_cast<int32_t>(x / 3) + 2 * static_cast<int32_t>(z / 2);
+        }
+      }
+    }
+    for(size_t i = 0; i < 12; i++)
+    {
+      ids[generator() % totalPoints] = static_cast<int32_t>(generator() % numFeatures);
+    }
+
+    // Centroids as FindFeatureCentroids computes them
+    std::vector<float> centroids(numFeatures * 3, 0.0f);
+    std::vector<double> counts(numFeatures, 0.0);
+    std::vector<double> sums(numFeatures * 3, 0.0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          int32_t feature = ids[(z * dims[1] + y) * dims[0] + x];
+          size_t pos[3] = {x, y, z};
+          counts[feature] += 1.0;
+          for(size_t d = 0; d < 3; d++)
+          {
+            sums[feature * 3 + d] += (static_cast<double>(pos[d]) + 0.5) * res[d];
+          }
+        }
+      }
+    }
+    for(size_t i = 0; i < numFeatures * 3; i++)
+    {
+      centroids[i] = (counts[i / 3] > 0.0) ? static_cast<float>(sums[i] / counts[i / 3]) : 0.0f;
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    image->setResolution(res[0], res[1], res[2]);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, totalPoints);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, ids[i]);
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+
+    tDims[0] = numFeatures;
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+    FloatArrayType::Pointer centroidsArray = FloatArrayType::CreateArray(numFeatures, QVector<size_t>(1, 3), SIMPL::FeatureData::Centroids);
+    for(size_t i = 0; i < numFeatures * 3; i++)
+    {
+      centroidsArray->setValue(i, centroids[i]);
+    }
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::Centroids, centroidsArray);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featureAttrMat);
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("FindShapes");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE(filter->setProperty("CellFeatureAttributeMatrixName", var) == true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE(filter->setProperty("FeatureIdsArrayPath", var) == true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids));
+    DREAM3D_REQUIRE(filter->setProperty("CentroidsArrayPath", var) == true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    std::vector<double> expectedOmega3s(numFeatures, 0.0);
+    std::vector<double> expectedVolumes(numFeatures, 0.0);
+    bruteForceOmega3s(dims, res, ids, centroids, expectedOmega3s, expectedVolumes);
+
+    FloatArrayType::Pointer omega3s = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Omega3s);
+    FloatArrayType::Pointer volumes = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    DREAM3D_REQUIRE_VALID_POINTER(omega3s.get())
+    DREAM3D_REQUIRE_VALID_POINTER(volumes.get())
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      DREAM3D_REQUIRED(expectedOmega3s[i], <, 1.0)
+      DREAM3D_REQUIRED(fabs(omega3s->getValue(i) - expectedOmega3s[i]), <=, 1.0E-4 * expectedOmega3s[i])
+      DREAM3D_REQUIRED(fabs(volumes->getValue(i) - expectedVolumes[i]), <=, 1.0E-5 * expectedVolumes[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestReduction())
+    DREAM3D_REGISTER_TEST(TestFindShapesMoments())
+  }
+
+private:
+  FeatureReductionEngineTest(const FeatureReductionEngineTest&); // Copy Constructor Not Implemented
+  void operator=(const FeatureReductionEngineTest&);             // Operator '=' Not Implemented
+};
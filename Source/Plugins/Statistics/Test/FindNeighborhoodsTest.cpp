@@ -0,0 +1,259 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindNeighborhoodsTest
+{
+public:
+  FindNeighborhoodsTest()
+  {
+  }
+  virtual ~FindNeighborhoodsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FindNeighborhoodsTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighborhoods Filter from the FilterManager
+    QString filtName = "FindNeighborhoods";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborhoodsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The all pairs search FindNeighborhoods used before the centroid bins were put into a grid
+  // -----------------------------------------------------------------------------
+  void allPairsNeighborhoods(const float origin[3], const std::vector<float>& centroids, const std::vector<float>& equivalentDiameters, float multiplesOfAverage,
+                             std::vector<int32_t>& neighborhoods, std::vector<std::vector<int32_t>>& neighborhoodList)
+  {
+    size_t totalFeatures = equivalentDiameters.size();
+    neighborhoods.assign(totalFeatures, 0);
+    neighborhoodList.assign(totalFeatures, std::vector<int32_t>());
+    std::vector<float> criticalDistance(totalFeatures, 0.0f);
+
+    float aveDiam = 0.0f;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      aveDiam += equivalentDiameters[i];
+      criticalDistance[i] = equivalentDiameters[i] * multiplesOfAverage;
+    }
+    aveDiam /= totalFeatures;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      criticalDistance[i] /= aveDiam;
+    }
+
+    std::vector<int64_t> bins(3 * totalFeatures, 0);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        bins[3 * i + d] = static_cast<int64_t>(int32_t((centroids[3 * i + d] - origin[d]) / aveDiam));
+      }
+    }
+
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(size_t j = i + 1; j < totalFeatures; j++)
+      {
+        float dBinX = static_cast<float>(llabs(bins[3 * j] - bins[3 * i]));
+        float dBinY = static_cast<float>(llabs(bins[3 * j + 1] - bins[3 * i + 1]));
+        float dBinZ = static_cast<float>(llabs(bins[3 * j + 2] - bins[3 * i + 2]));
+        if(dBinX < criticalDistance[i] && dBinY < criticalDistance[i] && dBinZ < criticalDistance[i])
+        {
+          neighborhoods[i]++;
+          neighborhoodList[i].push_back(static_cast<int32_t>(j));
+        }
+        if(dBinX < criticalDistance[j] && dBinY < criticalDistance[j] && dBinZ < criticalDistance[j])
+        {
+          neighborhoods[j]++;
+          neighborhoodList[j].push_back(static_cast<int32_t>(i));
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs FindNeighborhoods on random Features and compares its output with the all pairs search
+  // -----------------------------------------------------------------------------
+  void checkNeighborhoods(std::mt19937& generator, size_t totalFeatures, float multiplesOfAverage)
+  {
+    const size_t dims[3] = {20, 16, 12};
+    const float res[3] = {0.5f, 0.5f, 0.75f};
+    const float origin[3] = {2.0f, -3.0f, 1.0f};
+
+    // Some centroids lie in front of the origin and some past the end of the volume, so their bins are
+    // negative or out of range
+    std::uniform_real_distribution<float> centroidDistribution(-6.0f, 14.0f);
+    std::uniform_real_distribution<float> diameterDistribution(0.2f, 3.0f);
+    std::vector<float> centroids(3 * totalFeatures, 0.0f);
+    std::vector<float> equivalentDiameters(totalFeatures, 0.0f);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroids[3 * i + d] = centroidDistribution(generator);
+      }
+      equivalentDiameters[i] = diameterDistribution(generator);
+    }
+    // A few very large Features whose critical distance spans many grid cells
+    for(size_t i = 5; i < totalFeatures; i += 17)
+    {
+      equivalentDiameters[i] = 25.0f;
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    image->setResolution(res[0], res[1], res[2]);
+    image->setOrigin(origin[0], origin[1], origin[2]);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, totalFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+    FloatArrayType::Pointer centroidsArray = FloatArrayType::CreateArray(totalFeatures, QVector<size_t>(1, 3), SIMPL::FeatureData::Centroids);
+    FloatArrayType::Pointer diametersArray = FloatArrayType::CreateArray(totalFeatures, SIMPL::FeatureData::EquivalentDiameters);
+    Int32ArrayType::Pointer phasesArray = Int32ArrayType::CreateArray(totalFeatures, SIMPL::FeatureData::Phases);
+    for(size_t i = 0; i < totalFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroidsArray->setComponent(i, d, centroids[3 * i + d]);
+      }
+      diametersArray->setValue(i, equivalentDiameters[i]);
+      phasesArray->setValue(i, (i == 0) ? 0 : 1);
+    }
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::Centroids, centroidsArray);
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::EquivalentDiameters, diametersArray);
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::Phases, phasesArray);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featureAttrMat);
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("FindNeighborhoods");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(multiplesOfAverage);
+    DREAM3D_REQUIRE(filter->setProperty("MultiplesOfAverage", var) == true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    std::vector<int32_t> expectedNeighborhoods;
+    std::vector<std::vector<int32_t>> expectedList;
+    allPairsNeighborhoods(origin, centroids, equivalentDiameters, multiplesOfAverage, expectedNeighborhoods, expectedList);
+
+    Int32ArrayType::Pointer neighborhoods = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Neighborhoods);
+    NeighborList<int32_t>::Pointer neighborhoodList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborhoodList);
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoods.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoodList.get())
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(neighborhoods->getValue(i), expectedNeighborhoods[i])
+      std::vector<int32_t>& list = neighborhoodList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(list.size(), expectedList[i].size())
+      for(size_t n = 0; n < list.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(list[n], expectedList[i][n])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNeighborhoods()
+  {
+    std::mt19937 generator(1234);
+    // Below 1 the grid cell is clamped to one bin, above 1 it follows the multiple
+    const float multiples[4] = {0.5f, 1.0f, 2.5f, 6.0f};
+    const size_t featureCounts[3] = {8, 40, 250};
+    for(size_t m = 0; m < 4; m++)
+    {
+      for(size_t f = 0; f < 3; f++)
+      {
+        checkNeighborhoods(generator, featureCounts[f], multiples[m]);
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestNeighborhoods())
+  }
+
+private:
+  FindNeighborhoodsTest(const FindNeighborhoodsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborhoodsTest&);        // Operator '=' Not Implemented
+};
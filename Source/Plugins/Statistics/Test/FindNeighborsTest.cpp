@@ -0,0 +1,349 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindNeighborsTest
+{
+public:
+  FindNeighborsTest()
+  {
+  }
+  virtual ~FindNeighborsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FindNeighborsTest)
+
+  /**
+   * @brief The expected output of FindNeighbors for one image
+   */
+  struct NeighborData
+  {
+    std::vector<int32_t> numNeighbors;
+    std::vector<std::vector<int32_t>> neighborList;
+    std::vector<std::vector<float>> sharedSurfaceAreaList;
+    std::vector<int8_t> boundaryCells;
+    std::vector<bool> surfaceFeatures;
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighbors Filter from the FilterManager
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The per voxel scan FindNeighbors used before the face pairs were collected into a FeatureNeighborGraph
+  // -----------------------------------------------------------------------------
+  void voxelScanNeighbors(const std::vector<int32_t>& featureIds, const size_t dims[3], const float res[3], size_t totalFeatures, NeighborData& data)
+  {
+    int64_t xPoints = static_cast<int64_t>(dims[0]);
+    int64_t yPoints = static_cast<int64_t>(dims[1]);
+    int64_t zPoints = static_cast<int64_t>(dims[2]);
+    int64_t neighpoints[6] = {-xPoints * yPoints, -xPoints, -1, 1, xPoints, xPoints * yPoints};
+
+    std::vector<std::map<int32_t, int32_t>> neighToCount(totalFeatures);
+    data.boundaryCells.assign(featureIds.size(), 0);
+    data.surfaceFeatures.assign(totalFeatures, false);
+    for(int64_t j = 0; j < static_cast<int64_t>(featureIds.size()); j++)
+    {
+      int8_t onsurf = 0;
+      int32_t feature = featureIds[j];
+      if(feature > 0)
+      {
+        int64_t column = j % xPoints;
+        int64_t row = (j / xPoints) % yPoints;
+        int64_t plane = j / (xPoints * yPoints);
+        if((column == 0 || column == xPoints - 1 || row == 0 || row == yPoints - 1 || plane == 0 || plane == zPoints - 1) && zPoints != 1)
+        {
+          data.surfaceFeatures[feature] = true;
+        }
+        if((column == 0 || column == xPoints - 1 || row == 0 || row == yPoints - 1) && zPoints == 1)
+        {
+          data.surfaceFeatures[feature] = true;
+        }
+        bool good[6] = {plane != 0, row != 0, column != 0, column != xPoints - 1, row != yPoints - 1, plane != zPoints - 1};
+        for(int32_t k = 0; k < 6; k++)
+        {
+          int64_t neighbor = j + neighpoints[k];
+          if(good[k] == true && featureIds[neighbor] != feature && featureIds[neighbor] > 0)
+          {
+            onsurf++;
+            neighToCount[feature][featureIds[neighbor]]++;
+          }
+        }
+      }
+      data.boundaryCells[j] = onsurf;
+    }
+
+    data.numNeighbors.assign(totalFeatures, 0);
+    data.neighborList.assign(totalFeatures, std::vector<int32_t>());
+    data.sharedSurfaceAreaList.assign(totalFeatures, std::vector<float>());
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(std::map<int32_t, int32_t>::iterator iter = neighToCount[i].begin(); iter != neighToCount[i].end(); ++iter)
+      {
+        data.neighborList[i].push_back(iter->first);
+        data.sharedSurfaceAreaList[i].push_back(float(iter->second) * res[0] * res[1]);
+      }
+      data.numNeighbors[i] = static_cast<int32_t>(data.neighborList[i].size());
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs FindNeighbors on the given Feature Ids and compares every output array with the expected data
+  // -----------------------------------------------------------------------------
+  void checkNeighbors(const std::vector<int32_t>& featureIds, const size_t dims[3], const float res[3], size_t totalFeatures, const NeighborData& expected)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    image->setResolution(res[0], res[1], res[2]);
+    dc->setGeometry(image);
+
+    size_t totalPoints = featureIds.size();
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+    Int32ArrayType::Pointer featureIdsArray = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIdsArray->setValue(i, featureIds[i]);
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIdsArray);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+
+    QVector<size_t> fDims(1, totalFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::AttributeMatrixType::CellFeature);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featureAttrMat);
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("FindNeighbors");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(true);
+    DREAM3D_REQUIRE(filter->setProperty("StoreBoundaryCells", var) == true)
+    DREAM3D_REQUIRE(filter->setProperty("StoreSurfaceFeatures", var) == true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    Int8ArrayType::Pointer boundaryCells = cellAttrMat->getAttributeArrayAs<Int8ArrayType>(SIMPL::CellData::BoundaryCells);
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCells.get())
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(boundaryCells->getValue(i), expected.boundaryCells[i])
+    }
+
+    Int32ArrayType::Pointer numNeighbors = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumNeighbors);
+    BoolArrayType::Pointer surfaceFeatures = featureAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+    NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get())
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeatures.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaList.get())
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(i), expected.numNeighbors[i])
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(i), expected.surfaceFeatures[i])
+      std::vector<int32_t>& list = neighborList->getListReference(static_cast<int32_t>(i));
+      std::vector<float>& areas = sharedSurfaceAreaList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(list.size(), expected.neighborList[i].size())
+      DREAM3D_REQUIRE_EQUAL(areas.size(), expected.sharedSurfaceAreaList[i].size())
+      for(size_t n = 0; n < list.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(list[n], expected.neighborList[i][n])
+        DREAM3D_REQUIRE_EQUAL(areas[n], expected.sharedSurfaceAreaList[i][n])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // A 3 x 2 x 2 volume worked out by hand. Every voxel lies on the outside of the volume and the
+  // voxel at (1, 1, 0) belongs to no Feature. Feature 4 has no voxels at all.
+  // -----------------------------------------------------------------------------
+  int TestSmallVolume()
+  {
+    const size_t dims[3] = {3, 2, 2};
+    const float res[3] = {0.5f, 4.0f, 3.0f};
+    const int32_t featureIds[12] = {
+        1, 1, 2, // plane 0, row 0
+        1, 0, 2, // plane 0, row 1
+        3, 3, 2, // plane 1, row 0
+        1, 3, 3  // plane 1, row 1
+    };
+    const int8_t boundaryCells[12] = {1, 2, 1, 0, 0, 1, 2, 2, 2, 2, 1, 2};
+
+    // Every shared face counts X Res * Y Res, whatever its direction
+    NeighborData expected;
+    expected.numNeighbors = {0, 2, 2, 2, 0};
+    expected.neighborList = {{}, {2, 3}, {1, 3}, {1, 2}, {}};
+    expected.sharedSurfaceAreaList = {{}, {2.0f, 8.0f}, {2.0f, 6.0f}, {8.0f, 6.0f}, {}};
+    expected.boundaryCells.assign(boundaryCells, boundaryCells + 12);
+    expected.surfaceFeatures = {false, true, true, true, false};
+
+    checkNeighbors(std::vector<int32_t>(featureIds, featureIds + 12), dims, res, 5, expected);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A single 4 x 3 slice worked out by hand. The first and last planes are not part of the surface of
+  // a slice, so Features 3 and 4 in the middle row are not surface Features.
+  // -----------------------------------------------------------------------------
+  int TestSmallSlice()
+  {
+    const size_t dims[3] = {4, 3, 1};
+    const float res[3] = {0.25f, 2.0f, 1.0f};
+    const int32_t featureIds[12] = {
+        1, 1, 2, 2, // row 0
+        1, 3, 4, 2, // row 1
+        1, 1, 2, 0  // row 2
+    };
+    const int8_t boundaryCells[12] = {0, 2, 2, 0, 1, 4, 4, 1, 0, 2, 2, 0};
+
+    NeighborData expected;
+    expected.numNeighbors = {0, 2, 2, 2, 2, 0};
+    expected.neighborList = {{}, {2, 3}, {1, 4}, {1, 4}, {2, 3}, {}};
+    expected.sharedSurfaceAreaList = {{}, {1.0f, 1.5f}, {1.0f, 1.5f}, {1.5f, 0.5f}, {1.5f, 0.5f}, {}};
+    expected.boundaryCells.assign(boundaryCells, boundaryCells + 12);
+    expected.surfaceFeatures = {false, true, true, false, false, false};
+
+    checkNeighbors(std::vector<int32_t>(featureIds, featureIds + 12), dims, res, 6, expected);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random blocky Features on images larger than one block of the FeatureNeighborGraph scan,
+  // compared with the per voxel scan
+  // -----------------------------------------------------------------------------
+  int TestRandomVolumes()
+  {
+    std::mt19937 generator(4321);
+    const size_t volumeDims[2][3] = {{48, 40, 36}, {300, 250, 1}};
+    const float res[3] = {0.5f, 0.75f, 1.25f};
+    const size_t totalFeatures = 120;
+    for(size_t v = 0; v < 2; v++)
+    {
+      const size_t* dims = volumeDims[v];
+      size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+      // Give each 3 x 3 x 3 block of voxels one Feature, then scatter single voxels of other Features
+      // and of no Feature through the blocks
+      std::uniform_int_distribution<int32_t> featureDistribution(0, static_cast<int32_t>(totalFeatures) - 1);
+      std::uniform_int_distribution<int32_t> scatterDistribution(0, 9);
+      size_t blocks[3] = {dims[0] / 3 + 1, dims[1] / 3 + 1, dims[2] / 3 + 1};
+      std::vector<int32_t> blockFeatures(blocks[0] * blocks[1] * blocks[2]);
+      for(size_t b = 0; b < blockFeatures.size(); b++)
+      {
+        blockFeatures[b] = featureDistribution(generator);
+      }
+      std::vector<int32_t> featureIds(totalPoints, 0);
+      for(size_t z = 0; z < dims[2]; z++)
+      {
+        for(size_t y = 0; y < dims[1]; y++)
+        {
+          for(size_t x = 0; x < dims[0]; x++)
+          {
+            size_t index = (z * dims[1] + y) * dims[0] + x;
+            featureIds[index] = blockFeatures[((z / 3) * blocks[1] + y / 3) * blocks[0] + x / 3];
+            if(scatterDistribution(generator) == 0)
+            {
+              featureIds[index] = featureDistribution(generator);
+            }
+          }
+        }
+      }
+
+      NeighborData expected;
+      voxelScanNeighbors(featureIds, dims, res, totalFeatures, expected);
+      checkNeighbors(featureIds, dims, res, totalFeatures, expected);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSmallVolume())
+    DREAM3D_REGISTER_TEST(TestSmallSlice())
+    DREAM3D_REGISTER_TEST(TestRandomVolumes())
+  }
+
+private:
+  FindNeighborsTest(const FindNeighborsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborsTest&);    // Operator '=' Not Implemented
+};
@@ -0,0 +1,202 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Statistics/StatisticsFilters/util/PointGrid.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class PointGridTest
+{
+public:
+  PointGridTest()
+  {
+  }
+  virtual ~PointGridTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(PointGridTest)
+
+  // -----------------------------------------------------------------------------
+  // Compares findPointsWithinBox for every point of the grid with a test of every point against the box
+  // -----------------------------------------------------------------------------
+  void compareBoxQueries(const std::vector<float>& coords, const std::vector<size_t>& indices, const std::vector<float>& halfWidths, float cellSize)
+  {
+    PointGrid grid(coords.data(), indices, cellSize);
+
+    std::vector<size_t> found;
+    for(size_t q = 0; q < indices.size(); q++)
+    {
+      const float* pos = &(coords[3 * indices[q]]);
+      float halfWidth = halfWidths[q];
+      std::vector<size_t> expected;
+      for(size_t p = 0; p < indices.size(); p++)
+      {
+        const float* c = &(coords[3 * indices[p]]);
+        if(std::fabs(pos[0] - c[0]) < halfWidth && std::fabs(pos[1] - c[1]) < halfWidth && std::fabs(pos[2] - c[2]) < halfWidth)
+        {
+          expected.push_back(indices[p]);
+        }
+      }
+
+      found.clear();
+      grid.findPointsWithinBox(pos, halfWidth, found);
+      std::sort(found.begin(), found.end());
+      std::sort(expected.begin(), expected.end());
+      DREAM3D_REQUIRE_EQUAL(found.size(), expected.size())
+      for(size_t n = 0; n < found.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(found[n], expected[n])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRandomPoints()
+  {
+    std::mt19937 generator(1234);
+    const float cellSizes[3] = {1.0f, 2.5f, 0.5f};
+    for(size_t trial = 0; trial < 12; trial++)
+    {
+      size_t numPoints = 2 + 40 * trial;
+      float cellSize = cellSizes[trial % 3];
+      // Whole numbers, as the centroid bins of FindNeighborhoods are, on both sides of zero
+      std::uniform_int_distribution<int32_t> coordDistribution(-25, 60);
+      // Half widths up to many times the grid cell, with some below one unit
+      std::uniform_real_distribution<float> widthDistribution(0.0f, (trial % 4 == 3) ? 80.0f : 8.0f);
+
+      std::vector<float> coords(3 * numPoints, 0.0f);
+      std::vector<size_t> indices;
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        for(size_t d = 0; d < 3; d++)
+        {
+          coords[3 * i + d] = static_cast<float>(coordDistribution(generator));
+        }
+        // Leave a few points out of the grid
+        if(i % 5 != 4)
+        {
+          indices.push_back(i);
+        }
+      }
+      std::vector<float> halfWidths(indices.size(), 0.0f);
+      for(size_t q = 0; q < indices.size(); q++)
+      {
+        halfWidths[q] = widthDistribution(generator);
+        // Half widths that are a whole number must not find the points at exactly that distance
+        if(q % 7 == 0)
+        {
+          halfWidths[q] = std::floor(halfWidths[q]);
+        }
+      }
+      compareBoxQueries(coords, indices, halfWidths, cellSize);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSpreadPoints()
+  {
+    // A few points very far apart, so the grid has to grow its cells, and half widths larger than the whole spread
+    std::mt19937 generator(5489u);
+    std::uniform_int_distribution<int32_t> coordDistribution(-2000000, 2000000);
+    const size_t numPoints = 30;
+    std::vector<float> coords(3 * numPoints, 0.0f);
+    std::vector<size_t> indices;
+    std::vector<float> halfWidths;
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        coords[3 * i + d] = static_cast<float>(coordDistribution(generator));
+      }
+      indices.push_back(i);
+      halfWidths.push_back((i % 3 == 0) ? 1.0E9f : static_cast<float>(i * 100000));
+    }
+    // Two points at the same position
+    for(size_t d = 0; d < 3; d++)
+    {
+      coords[3 * 2 + d] = coords[3 * 1 + d];
+    }
+    compareBoxQueries(coords, indices, halfWidths, 1.0f);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEmptyQueries()
+  {
+    const float coords[6] = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+    std::vector<size_t> indices(1, 0);
+    indices.push_back(1);
+    PointGrid grid(coords, indices, 1.0f);
+    std::vector<size_t> found;
+    grid.findPointsWithinBox(coords, 0.0f, found);
+    grid.findPointsWithinBox(coords, -1.0f, found);
+    DREAM3D_REQUIRE_EQUAL(found.size(), 0)
+
+    PointGrid emptyGrid(coords, std::vector<size_t>(), 1.0f);
+    emptyGrid.findPointsWithinBox(coords, 10.0f, found);
+    DREAM3D_REQUIRE_EQUAL(found.size(), 0)
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestRandomPoints())
+    DREAM3D_REGISTER_TEST(TestSpreadPoints())
+    DREAM3D_REGISTER_TEST(TestEmptyQueries())
+  }
+
+private:
+  PointGridTest(const PointGridTest&); // Copy Constructor Not Implemented
+  void operator=(const PointGridTest&); // Operator '=' Not Implemented
+};
@@ -45,6 +45,8 @@
 
 #include "FindGBCDMetricBased.h"
 
+#include <algorithm>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -61,6 +63,8 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/UnitSphereBinGrid.h"
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include "tbb/concurrent_vector.h"
 #include <tbb/blocked_range.h>
@@ -321,10 +325,11 @@ class ProbeDistrib
   QVector<float> samplPtsY;
   QVector<float> samplPtsZ;
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>* selectedTris;
 #endif
+  const UnitSphereBinGrid* normalsGrid;
   float planeResolSq;
   double totalFaceArea;
   int numDistinctGBs;
@@ -334,17 +339,18 @@ class ProbeDistrib
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>* __selectedTris,
 #endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
+               const UnitSphereBinGrid* __normalsGrid, float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalsGrid(__normalsGrid)
   , planeResolSq(__planeResolSq)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -359,31 +365,41 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<size_t> candidates;
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
       float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
       MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      // A triangle can only be within the plane resolution if its first normal is within sqrt(2) times the
+      // plane resolution of the sampling point (or of its inverse), so only those triangles are visited.
+      // They are visited in increasing order so the areas are summed exactly as a full loop would.
+      float invertedNormal1[3] = {-fixedNormal1[0], -fixedNormal1[1], -fixedNormal1[2]};
+      candidates.clear();
+      normalsGrid->findCandidates(fixedNormal1, candidates);
+      normalsGrid->findCandidates(invertedNormal1, candidates);
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      for(size_t c = 0; c < candidates.size(); c++)
       {
+        const TriAreaAndNormals& tri = (*selectedTris)[candidates[c]];
         for(int inversion = 0; inversion <= 1; inversion++)
         {
           float sign = 1.0f;
           if(inversion == 1)
             sign = -1.0f;
 
-          float theta1 = acosf(sign * (selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] + selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                       selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+          float theta1 = acosf(sign * (tri.normal_grain1_x * fixedNormal1[0] + tri.normal_grain1_y * fixedNormal1[1] + tri.normal_grain1_z * fixedNormal1[2]));
 
-          float theta2 = acosf(-sign * (selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] + selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                        selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+          float theta2 = acosf(-sign * (tri.normal_grain2_x * fixedNormal2[0] + tri.normal_grain2_y * fixedNormal2[1] + tri.normal_grain2_z * fixedNormal2[2]));
 
           float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
 
           if(distSq < planeResolSq)
           {
-            (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
+            (*distribValues)[ptIdx] += tri.area;
           }
         }
       }
@@ -1018,6 +1034,19 @@ void FindGBCDMetricBased::execute()
     totalFaceArea += m_FaceAreas[triIdx] * double(triIncluded.at(triIdx));
   }
 
+  // Bin the first normals of the selected triangles so each sampling point only visits nearby triangles
+  UnitSphereBinGrid normalsGrid;
+  {
+    std::vector<float> normals(3 * selectedTris.size());
+    for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+    {
+      normals[3 * triRepresIdx] = selectedTris[triRepresIdx].normal_grain1_x;
+      normals[3 * triRepresIdx + 1] = selectedTris[triRepresIdx].normal_grain1_y;
+      normals[3 * triRepresIdx + 2] = selectedTris[triRepresIdx].normal_grain1_z;
+    }
+    normalsGrid.initialize(normals, SIMPLib::Constants::k_Sqrt2 * m_planeResol);
+  }
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1044,13 +1073,13 @@ void FindGBCDMetricBased::execute()
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
+                        ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, &selectedTris, &normalsGrid, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
+      ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, &selectedTris, &normalsGrid, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
       serial.probe(i, i + pointsChunkSize);
     }
   }
@@ -45,6 +45,8 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <algorithm>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -61,6 +63,8 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/UnitSphereBinGrid.h"
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include "tbb/concurrent_vector.h"
 #include <tbb/blocked_range.h>
@@ -250,10 +254,11 @@ class ProbeDistrib
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>* selectedTris;
 #endif
+  const UnitSphereBinGrid* normalsGrid;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
@@ -265,17 +270,18 @@ class ProbeDistrib
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>* __selectedTris,
 #endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
+               const UnitSphereBinGrid* __normalsGrid, float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalsGrid(__normalsGrid)
   , limitDist(__limitDist)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -292,17 +298,45 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<size_t> candidates;
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       double __c = 0.0;
 
       float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      // A symmetric normal S.n is within the limiting distance of the probe exactly when n is within that
+      // distance of S^T.probe, so only the triangles with a normal near one of the (inverted) symmetric
+      // copies of the probe are visited. They are visited in increasing order so the summation matches a full loop.
+      candidates.clear();
+      for(int j = 0; j < nsym; j++)
+      {
+        float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+        m_OrientationOps[cryst]->getMatSymOp(j, sym);
+        float symProbe[3] = {0.0f, 0.0f, 0.0f};
+        for(int k = 0; k < 3; k++)
+        {
+          symProbe[k] = sym[0][k] * probeNormal[0] + sym[1][k] * probeNormal[1] + sym[2][k] * probeNormal[2];
+        }
+        float invertedSymProbe[3] = {-symProbe[0], -symProbe[1], -symProbe[2]};
+        normalsGrid->findCandidates(symProbe, candidates);
+        normalsGrid->findCandidates(invertedSymProbe, candidates);
+      }
+      // The grid holds both normals of every triangle
+      for(size_t c = 0; c < candidates.size(); c++)
+      {
+        candidates[c] /= 2;
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      for(size_t c = 0; c < candidates.size(); c++)
       {
-        float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
+        const TriAreaAndNormals& tri = (*selectedTris)[candidates[c]];
 
-        float normal2[3] = {selectedTris[triRepresIdx].normal_grain2_x, selectedTris[triRepresIdx].normal_grain2_y, selectedTris[triRepresIdx].normal_grain2_z};
+        float normal1[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+
+        float normal2[3] = {tri.normal_grain2_x, tri.normal_grain2_y, tri.normal_grain2_z};
 
         float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 
@@ -329,7 +363,7 @@ public:
             if(gamma1 < limitDist)
             {
               // Kahan summation algorithm
-              double __y = selectedTris[triRepresIdx].area - __c;
+              double __y = tri.area - __c;
               double __t = (*distribValues)[ptIdx] + __y;
               __c = (__t - (*distribValues)[ptIdx]);
               __c -= __y;
@@ -337,7 +371,7 @@ public:
             }
             if(gamma2 < limitDist)
             {
-              double __y = selectedTris[triRepresIdx].area - __c;
+              double __y = tri.area - __c;
               double __t = (*distribValues)[ptIdx] + __y;
               __c = (__t - (*distribValues)[ptIdx]);
               __c -= __y;
@@ -1095,6 +1129,22 @@ void FindGBPDMetricBased::execute()
     totalFaceArea += selectedTris.at(i).area;
   }
 
+  // Bin both normals of the selected triangles so each sampling point only visits nearby triangles
+  UnitSphereBinGrid normalsGrid;
+  {
+    std::vector<float> normals(6 * selectedTris.size());
+    for(size_t triRepresIdx = 0; triRepresIdx < selectedTris.size(); triRepresIdx++)
+    {
+      normals[6 * triRepresIdx] = selectedTris[triRepresIdx].normal_grain1_x;
+      normals[6 * triRepresIdx + 1] = selectedTris[triRepresIdx].normal_grain1_y;
+      normals[6 * triRepresIdx + 2] = selectedTris[triRepresIdx].normal_grain1_z;
+      normals[6 * triRepresIdx + 3] = selectedTris[triRepresIdx].normal_grain2_x;
+      normals[6 * triRepresIdx + 4] = selectedTris[triRepresIdx].normal_grain2_y;
+      normals[6 * triRepresIdx + 5] = selectedTris[triRepresIdx].normal_grain2_z;
+    }
+    normalsGrid.initialize(normals, m_LimitDist);
+  }
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1121,13 +1171,13 @@ void FindGBPDMetricBased::execute()
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
+                        ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsGrid, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
+      ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, &selectedTris, &normalsGrid, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
       serial.probe(i, i + pointsChunkSize);
     }
   }
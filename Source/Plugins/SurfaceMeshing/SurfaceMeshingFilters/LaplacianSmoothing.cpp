@@ -37,6 +37,7 @@
 
 #include <sstream>
 #include <stdio.h>
+#include <vector>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -47,9 +48,123 @@
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/SIMPLib.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+/**
+ * @brief The ComputeLaplacianDeltasImpl class implements a threaded algorithm that computes the averaged
+ * Laplacian displacement of each vertex by gathering over the vertex's row of a compressed (CSR) vertex
+ * neighbor list. Each vertex only writes its own delta, so no synchronization is needed. The neighbors of
+ * each row are stored in edge list order, so the sums are accumulated in the same order as the edge scatter.
+ */
+class ComputeLaplacianDeltasImpl
+{
+  float* m_Verts;
+  int64_t* m_RowOffsets;
+  int64_t* m_Neighbors;
+  double* m_Delta;
+
+public:
+  ComputeLaplacianDeltasImpl(float* verts, int64_t* rowOffsets, int64_t* neighbors, double* delta)
+  : m_Verts(verts)
+  , m_RowOffsets(rowOffsets)
+  , m_Neighbors(neighbors)
+  , m_Delta(delta)
+  {
+  }
+  virtual ~ComputeLaplacianDeltasImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      double dx = 0.0;
+      double dy = 0.0;
+      double dz = 0.0;
+      float x = m_Verts[3 * i];
+      float y = m_Verts[3 * i + 1];
+      float z = m_Verts[3 * i + 2];
+      for(int64_t k = m_RowOffsets[i]; k < m_RowOffsets[i + 1]; k++)
+      {
+        int64_t nbr = m_Neighbors[k];
+        dx += m_Verts[3 * nbr] - x;
+        dy += m_Verts[3 * nbr + 1] - y;
+        dz += m_Verts[3 * nbr + 2] - z;
+      }
+      int32_t ncon = static_cast<int32_t>(m_RowOffsets[i + 1] - m_RowOffsets[i]);
+      m_Delta[3 * i] = dx / ncon;
+      m_Delta[3 * i + 1] = dy / ncon;
+      m_Delta[3 * i + 2] = dz / ncon;
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  /**
+   * @brief operator () This is called from the TBB stye of code
+   * @param r The range to compute the values
+   */
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The ApplyLaplacianDeltasImpl class implements a threaded algorithm that moves each vertex by its
+ * delta scaled by the vertex's lambda value and a common factor
+ */
+class ApplyLaplacianDeltasImpl
+{
+  float* m_Verts;
+  double* m_Delta;
+  float* m_Lambda;
+  float m_Factor;
+
+public:
+  ApplyLaplacianDeltasImpl(float* verts, double* delta, float* lambda, float factor)
+  : m_Verts(verts)
+  , m_Delta(delta)
+  , m_Lambda(lambda)
+  , m_Factor(factor)
+  {
+  }
+  virtual ~ApplyLaplacianDeltasImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      float ll = m_Lambda[i] * m_Factor;
+      m_Verts[3 * i] += ll * m_Delta[3 * i];
+      m_Verts[3 * i + 1] += ll * m_Delta[3 * i + 1];
+      m_Verts[3 * i + 2] += ll * m_Delta[3 * i + 2];
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  /**
+   * @brief operator () This is called from the TBB stye of code
+   * @param r The range to compute the values
+   */
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_LaplacianSmoothing.cpp"
 
@@ -309,102 +424,77 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   int64_t* uedges = surfaceMesh->getEdgePointer(0);
   int64_t nedges = surfaceMesh->getNumberOfEdges();
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array");
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
-
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
+  // Build a compressed (CSR) vertex neighbor list from the edges. Each edge is listed in the rows of both of
+  // its vertices, in edge order, so every vertex can gather its neighbors without write conflicts.
+  DataArray<int64_t>::Pointer rowOffsetsArray = DataArray<int64_t>::CreateArray(nvert + 1, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_RowOffsets_Array");
+  rowOffsetsArray->initializeWithZeros();
+  int64_t* rowOffsets = rowOffsetsArray->getPointer(0);
+  for(int64_t i = 0; i < nedges; i++)
+  {
+    rowOffsets[uedges[2 * i] + 1]++;
+    rowOffsets[uedges[2 * i + 1] + 1]++;
+  }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    rowOffsets[i + 1] += rowOffsets[i];
+  }
 
-  double dlta = 0.0;
-  for(int32_t q = 0; q < m_IterationSteps; q++)
+  DataArray<int64_t>::Pointer neighborsArray = DataArray<int64_t>::CreateArray(2 * nedges, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Neighbors_Array");
+  int64_t* neighbors = neighborsArray->getPointer(0);
   {
-    if(getCancel() == true)
-    {
-      return -1;
-    }
-    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    // Compute the Deltas for each point
+    std::vector<int64_t> fill(rowOffsets, rowOffsets + nvert);
     for(int64_t i = 0; i < nedges; i++)
     {
       int64_t in1 = uedges[2 * i];     // row of the first vertex
       int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(int32_t j = 0; j < 3; j++)
-      {
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-        dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
-      }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
+      Q_ASSERT(in1 < nvert && in2 < nvert);
+      neighbors[fill[in1]++] = in2;
+      neighbors[fill[in2]++] = in1;
     }
+  }
 
-    // Move each point
-    float ll = 0.0f;
-    for(int64_t i = 0; i < nvert; i++)
-    {
-      for(int32_t j = 0; j < 3; j++)
-      {
-        int64_t in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
+  QVector<size_t> cDims(1, 3);
+  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
+  deltaArray->initializeWithZeros();
+  double* delta = deltaArray->getPointer(0);
 
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
-      }
-      ncon[i] = 0; // reset for next iteration
-    }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-    // Now optionally apply a negative lambda based on the mu Factor value.
-    // This is from Taubin's paper on smoothing without shrinkage. This effectively
-    // runs a low pass filter on the data
-    if(m_UseTaubinSmoothing)
-    {
+  // The Taubin pass applies a negative lambda based on the mu Factor value.
+  // This is from Taubin's paper on smoothing without shrinkage. This effectively
+  // runs a low pass filter on the data
+  int32_t numPasses = m_UseTaubinSmoothing ? 2 : 1;
 
+  for(int32_t q = 0; q < m_IterationSteps; q++)
+  {
+    for(int32_t pass = 0; pass < numPasses; pass++)
+    {
       if(getCancel() == true)
       {
         return -1;
       }
       QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      // Compute the Delta's
-      for(int64_t i = 0; i < nedges; i++)
-      {
-        int64_t in1 = uedges[2 * i];     // row of the first vertex
-        int64_t in2 = uedges[2 * i + 1]; // row the second vertex
 
-        for(int32_t j = 0; j < 3; j++)
-        {
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          delta[3 * in1 + j] += dlta;
-          delta[3 * in2 + j] += -1.0 * dlta;
-        }
-        ncon[in1] += 1;
-        ncon[in2] += 1;
-      }
+      float factor = (pass == 0) ? 1.0f : m_MuFactor;
 
-      // MOve the points
-      float ll = 0.0f;
-      for(int64_t i = 0; i < nvert; i++)
+      // Compute the Deltas for each point from the current positions, then move each point
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
       {
-        for(int32_t j = 0; j < 3; j++)
-        {
-          int64_t in0 = 3 * i + j;
-          dlta = delta[in0] / ncon[i];
-
-          ll = lambda[i] * m_MuFactor;
-          verts[3 * i + j] += ll * dlta;
-          delta[in0] = 0.0; // reset for next iteration
-        }
-        ncon[i] = 0; // reset for next iteration
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nvert), ComputeLaplacianDeltasImpl(verts, rowOffsets, neighbors, delta), tbb::auto_partitioner());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nvert), ApplyLaplacianDeltasImpl(verts, delta, lambda, factor), tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        ComputeLaplacianDeltasImpl computeSerial(verts, rowOffsets, neighbors, delta);
+        computeSerial.generate(0, nvert);
+        ApplyLaplacianDeltasImpl applySerial(verts, delta, lambda, factor);
+        applySerial.generate(0, nvert);
       }
     }
   }
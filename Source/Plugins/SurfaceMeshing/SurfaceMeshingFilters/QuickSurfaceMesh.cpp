@@ -35,6 +35,16 @@
 
 #include "QuickSurfaceMesh.h"
 
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -151,25 +161,421 @@ void QuickSurfaceMesh::updateFaceInstancePointers()
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void copyCellArraysToFaceArrays(size_t faceIndex, size_t firstCellIndex, size_t secondCellIndex, IDataArray::Pointer cellArray, IDataArray::Pointer faceArray, bool forceSecondToZero = false)
+void copyCellArraysToFaceArrays(const std::vector<int64_t>& faceCells, IDataArray::Pointer cellArray, IDataArray::Pointer faceArray)
 {
   typename DataArray<T>::Pointer cellPtr = std::dynamic_pointer_cast<DataArray<T>>(cellArray);
   typename DataArray<T>::Pointer facePtr = std::dynamic_pointer_cast<DataArray<T>>(faceArray);
 
-  int32_t numComps = cellPtr->getNumberOfComponents();
-  QVector<size_t> cDims = facePtr->getComponentDimensions();
+  size_t numComps = static_cast<size_t>(cellPtr->getNumberOfComponents());
+  size_t numFaces = faceCells.size() / 2;
 
-  T* faceTuplePtr = facePtr->getTuplePointer(faceIndex);
-  T* firstCellTuplePtr = cellPtr->getTuplePointer(firstCellIndex);
-  T* secondCellTuplePtr = cellPtr->getTuplePointer(secondCellIndex);
+  T* cellData = cellPtr->getPointer(0);
+  T* faceData = facePtr->getPointer(0);
 
-  ::memcpy(faceTuplePtr, firstCellTuplePtr, sizeof(T) * numComps);
-  if(!forceSecondToZero)
+  for(size_t f = 0; f < numFaces; f++)
+  {
+    T* faceTuplePtr = faceData + (f * 2 * numComps);
+    ::memcpy(faceTuplePtr, cellData + (faceCells[f * 2] * numComps), sizeof(T) * numComps);
+    if(faceCells[f * 2 + 1] >= 0)
+    {
+      ::memcpy(faceTuplePtr + numComps, cellData + (faceCells[f * 2 + 1] * numComps), sizeof(T) * numComps);
+    }
+    else
+    {
+      std::fill(faceTuplePtr + numComps, faceTuplePtr + 2 * numComps, static_cast<T>(0));
+    }
+  }
+}
+
+/**
+ * @brief The kinds of voxel face the mesher can emit, listed in the order they are visited for a single voxel.
+ */
+enum QuickSurfaceMeshFaceKind
+{
+  XMinBoundaryFace = 0,
+  YMinBoundaryFace,
+  ZMinBoundaryFace,
+  XMaxBoundaryFace,
+  XInteriorFace,
+  YMaxBoundaryFace,
+  YInteriorFace,
+  ZMaxBoundaryFace,
+  ZInteriorFace
+};
+
+/**
+ * @brief Describes one voxel face: the offsets of its four nodes from the voxel's minimum corner, the
+ * node order of the two triangles that tile it and the axis of the neighboring voxel (0 for a boundary face).
+ */
+typedef struct
+{
+  int8_t nodes[4][3];
+  int8_t triangles[2][3];
+  int8_t neighborAxis;
+} QuickSurfaceMeshFace_t;
+
+// Number of slabs the volume is split into when meshing, and the largest dense node table a single slab may use
+static const int64_t k_TargetSlabCount = 64;
+static const int64_t k_MaxSlabNodes = 4 * 1024 * 1024;
+
+static const QuickSurfaceMeshFace_t k_QuickSurfaceMeshFaces[9] = {
+    {{{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}, {{0, 1, 2}, {1, 3, 2}}, 0}, // XMinBoundaryFace
+    {{{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}, {{0, 2, 1}, {1, 2, 3}}, 0}, // YMinBoundaryFace
+    {{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}, {{0, 1, 2}, {1, 3, 2}}, 0}, // ZMinBoundaryFace
+    {{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}, {{2, 1, 0}, {2, 3, 1}}, 0}, // XMaxBoundaryFace
+    {{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}, {{0, 1, 2}, {1, 3, 2}}, 1}, // XInteriorFace
+    {{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}, {{2, 1, 0}, {2, 3, 1}}, 0}, // YMaxBoundaryFace
+    {{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}, {{0, 1, 2}, {1, 3, 2}}, 2}, // YInteriorFace
+    {{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}, {{1, 2, 0}, {3, 2, 1}}, 0}, // ZMaxBoundaryFace
+    {{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}, {{0, 2, 1}, {1, 2, 3}}, 3}  // ZInteriorFace
+};
+
+/**
+ * @brief Finds the faces emitted by a single voxel, in the order the serial mesher has always produced them
+ * @return The number of faces written into faces
+ */
+static inline int32_t findVoxelFaces(const int32_t* featureIds, const int64_t dims[3], int64_t i, int64_t j, int64_t k, int32_t faces[6])
+{
+  int64_t xP = dims[0];
+  int64_t yP = dims[1];
+  int64_t zP = dims[2];
+  int64_t point = (k * xP * yP) + (j * xP) + i;
+  int32_t numFaces = 0;
+
+  if(i == 0)
+  {
+    faces[numFaces++] = XMinBoundaryFace;
+  }
+  if(j == 0)
+  {
+    faces[numFaces++] = YMinBoundaryFace;
+  }
+  if(k == 0)
+  {
+    faces[numFaces++] = ZMinBoundaryFace;
+  }
+  if(i == (xP - 1))
+  {
+    faces[numFaces++] = XMaxBoundaryFace;
+  }
+  else if(featureIds[point] != featureIds[point + 1])
+  {
+    faces[numFaces++] = XInteriorFace;
+  }
+  if(j == (yP - 1))
+  {
+    faces[numFaces++] = YMaxBoundaryFace;
+  }
+  else if(featureIds[point] != featureIds[point + xP])
+  {
+    faces[numFaces++] = YInteriorFace;
+  }
+  if(k == (zP - 1))
   {
-    ::memcpy(faceTuplePtr + numComps, secondCellTuplePtr, sizeof(T) * numComps);
+    faces[numFaces++] = ZMaxBoundaryFace;
   }
+  else if(featureIds[point] != featureIds[point + (xP * yP)])
+  {
+    faces[numFaces++] = ZInteriorFace;
+  }
+  return numFaces;
 }
 
+/**
+ * @brief Accumulates the distinct Feature Ids that own a node. Only the first four distinct owners are kept,
+ * since the node type saturates at four; whether the node touches the outside (-1) is tracked separately.
+ */
+class QuickSurfaceMeshNodeOwners
+{
+public:
+  QuickSurfaceMeshNodeOwners()
+  : m_Count(0)
+  , m_Boundary(false)
+  {
+  }
+
+  void insert(int32_t id)
+  {
+    if(id == -1)
+    {
+      m_Boundary = true;
+    }
+    for(int8_t n = 0; n < m_Count; n++)
+    {
+      if(m_Ids[n] == id)
+      {
+        return;
+      }
+    }
+    if(m_Count < 4)
+    {
+      m_Ids[m_Count++] = id;
+    }
+  }
+
+  void merge(const QuickSurfaceMeshNodeOwners& other)
+  {
+    for(int8_t n = 0; n < other.m_Count; n++)
+    {
+      insert(other.m_Ids[n]);
+    }
+    m_Boundary = m_Boundary || other.m_Boundary;
+  }
+
+  int8_t getNodeType() const
+  {
+    return m_Boundary ? m_Count + 10 : m_Count;
+  }
+
+private:
+  int32_t m_Ids[4];
+  int8_t m_Count;
+  bool m_Boundary;
+};
+
+/**
+ * @brief A run of whole z layers that is meshed independently of the others. Nodes are numbered locally in
+ * first-encounter order and mapped onto the global numbering once all slabs have been counted.
+ */
+typedef struct
+{
+  int64_t zStart;
+  int64_t zEnd;
+  std::vector<int64_t> nodes;
+  std::vector<QuickSurfaceMeshNodeOwners> owners;
+  std::vector<int32_t> faceNodes;
+  std::unordered_map<int64_t, int32_t> topNodes;
+  std::vector<int64_t> finalIds;
+  std::vector<uint8_t> shared;
+  int64_t triangleOffset;
+} QuickSurfaceMeshSlab_t;
+
+/**
+ * @brief The QuickSurfaceMeshCountImpl class finds the faces of each slab, numbers the slab's nodes and
+ * gathers their owners. Only the slab's own layers are held in a dense node table while it is counted; the
+ * nodes on the slab's top plane are kept in a small hash so the next slab can be stitched onto them.
+ */
+class QuickSurfaceMeshCountImpl
+{
+public:
+  QuickSurfaceMeshCountImpl(int32_t* featureIds, int64_t dims[3], QuickSurfaceMeshSlab_t* slabs)
+  : m_FeatureIds(featureIds)
+  , m_Slabs(slabs)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~QuickSurfaceMeshCountImpl()
+  {
+  }
+
+  void countSlab(QuickSurfaceMeshSlab_t& slab) const
+  {
+    int64_t xP = m_Dims[0];
+    int64_t yP = m_Dims[1];
+    int64_t planeNodes = (xP + 1) * (yP + 1);
+    int64_t neighborOffsets[4] = {0, 1, xP, xP * yP};
+
+    std::vector<int32_t> localIds((slab.zEnd - slab.zStart + 1) * planeNodes, -1);
+    int32_t faces[6] = {0, 0, 0, 0, 0, 0};
+
+    for(int64_t k = slab.zStart; k < slab.zEnd; k++)
+    {
+      for(int64_t j = 0; j < yP; j++)
+      {
+        for(int64_t i = 0; i < xP; i++)
+        {
+          int64_t point = (k * xP * yP) + (j * xP) + i;
+          int32_t numFaces = findVoxelFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+          for(int32_t f = 0; f < numFaces; f++)
+          {
+            const QuickSurfaceMeshFace_t& face = k_QuickSurfaceMeshFaces[faces[f]];
+            int32_t neighborFeature = (face.neighborAxis == 0) ? -1 : m_FeatureIds[point + neighborOffsets[face.neighborAxis]];
+            for(int32_t n = 0; n < 4; n++)
+            {
+              int64_t ii = i + face.nodes[n][0];
+              int64_t jj = j + face.nodes[n][1];
+              int64_t kk = k + face.nodes[n][2];
+              int64_t planeIndex = (jj * (xP + 1)) + ii;
+              int32_t& localId = localIds[(kk - slab.zStart) * planeNodes + planeIndex];
+              if(localId == -1)
+              {
+                localId = static_cast<int32_t>(slab.nodes.size());
+                slab.nodes.push_back(kk * planeNodes + planeIndex);
+                slab.owners.push_back(QuickSurfaceMeshNodeOwners());
+              }
+              slab.faceNodes.push_back(localId);
+              slab.owners[localId].insert(m_FeatureIds[point]);
+              slab.owners[localId].insert(neighborFeature);
+            }
+          }
+        }
+      }
+    }
+
+    int32_t* topPlane = localIds.data() + (slab.zEnd - slab.zStart) * planeNodes;
+    for(int64_t n = 0; n < planeNodes; n++)
+    {
+      if(topPlane[n] != -1)
+      {
+        slab.topNodes[slab.zEnd * planeNodes + n] = topPlane[n];
+      }
+    }
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      countSlab(m_Slabs[s]);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  int64_t m_Dims[3];
+  QuickSurfaceMeshSlab_t* m_Slabs;
+};
+
+/**
+ * @brief The QuickSurfaceMeshGenerateImpl class writes the vertices, node types, triangles and face labels
+ * of each slab into the final Triangle Geometry, starting at the slab's triangle offset. When Cell arrays are
+ * transferred it also records the pair of Cells each triangle was created from.
+ */
+class QuickSurfaceMeshGenerateImpl
+{
+public:
+  QuickSurfaceMeshGenerateImpl(IGeometryGrid* grid, int32_t* featureIds, int64_t dims[3], QuickSurfaceMeshSlab_t* slabs, float* vertices, int8_t* nodeTypes, int64_t* triangles,
+                               int32_t* faceLabels, int64_t* faceCells)
+  : m_Grid(grid)
+  , m_FeatureIds(featureIds)
+  , m_Slabs(slabs)
+  , m_Vertices(vertices)
+  , m_NodeTypes(nodeTypes)
+  , m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_FaceCells(faceCells)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~QuickSurfaceMeshGenerateImpl()
+  {
+  }
+
+  void generateSlab(QuickSurfaceMeshSlab_t& slab) const
+  {
+    int64_t xP = m_Dims[0];
+    int64_t yP = m_Dims[1];
+    int64_t planeNodes = (xP + 1) * (yP + 1);
+    int64_t neighborOffsets[4] = {0, 1, xP, xP * yP};
+
+    // Nodes shared with the previous slab are written by that slab
+    for(size_t n = 0; n < slab.nodes.size(); n++)
+    {
+      if(slab.shared[n] != 0)
+      {
+        continue;
+      }
+      int64_t node = slab.nodes[n];
+      size_t ii = static_cast<size_t>(node % (xP + 1));
+      size_t jj = static_cast<size_t>((node / (xP + 1)) % (yP + 1));
+      size_t kk = static_cast<size_t>(node / planeNodes);
+      float coords[3] = {0.0f, 0.0f, 0.0f};
+      m_Grid->getPlaneCoords(ii, jj, kk, coords);
+      float* vertex = m_Vertices + (slab.finalIds[n] * 3);
+      vertex[0] = coords[0];
+      vertex[1] = coords[1];
+      vertex[2] = coords[2];
+      m_NodeTypes[slab.finalIds[n]] = slab.owners[n].getNodeType();
+    }
+
+    const int32_t* faceNodes = slab.faceNodes.data();
+    int64_t triangleIndex = slab.triangleOffset;
+    int32_t faces[6] = {0, 0, 0, 0, 0, 0};
+
+    for(int64_t k = slab.zStart; k < slab.zEnd; k++)
+    {
+      for(int64_t j = 0; j < yP; j++)
+      {
+        for(int64_t i = 0; i < xP; i++)
+        {
+          int64_t point = (k * xP * yP) + (j * xP) + i;
+          int32_t numFaces = findVoxelFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+          for(int32_t f = 0; f < numFaces; f++)
+          {
+            const QuickSurfaceMeshFace_t& face = k_QuickSurfaceMeshFaces[faces[f]];
+
+            int64_t nodeIds[4] = {slab.finalIds[faceNodes[0]], slab.finalIds[faceNodes[1]], slab.finalIds[faceNodes[2]], slab.finalIds[faceNodes[3]]};
+            faceNodes += 4;
+
+            // Boundary faces carry the voxel's own label first; interior faces list the neighbor first
+            int64_t firstCell = point;
+            int64_t secondCell = -1;
+            if(face.neighborAxis != 0)
+            {
+              firstCell = point + neighborOffsets[face.neighborAxis];
+              secondCell = point;
+            }
+            int32_t firstLabel = m_FeatureIds[firstCell];
+            int32_t secondLabel = (secondCell == -1) ? -1 : m_FeatureIds[secondCell];
+
+            for(int32_t t = 0; t < 2; t++)
+            {
+              m_Triangles[triangleIndex * 3 + 0] = nodeIds[face.triangles[t][0]];
+              m_Triangles[triangleIndex * 3 + 1] = nodeIds[face.triangles[t][1]];
+              m_Triangles[triangleIndex * 3 + 2] = nodeIds[face.triangles[t][2]];
+              m_FaceLabels[triangleIndex * 2] = firstLabel;
+              m_FaceLabels[triangleIndex * 2 + 1] = secondLabel;
+              if(nullptr != m_FaceCells)
+              {
+                m_FaceCells[triangleIndex * 2] = firstCell;
+                m_FaceCells[triangleIndex * 2 + 1] = secondCell;
+              }
+              triangleIndex++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      generateSlab(m_Slabs[s]);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  IGeometryGrid* m_Grid;
+  int32_t* m_FeatureIds;
+  int64_t m_Dims[3];
+  QuickSurfaceMeshSlab_t* m_Slabs;
+  float* m_Vertices;
+  int8_t* m_NodeTypes;
+  int64_t* m_Triangles;
+  int32_t* m_FaceLabels;
+  int64_t* m_FaceCells;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -306,18 +712,6 @@ void QuickSurfaceMesh::preflight()
   setInPreflight(false);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void QuickSurfaceMesh::getGridCoordinates(IGeometryGrid::Pointer grid, size_t x, size_t y, size_t z, float *coords)
-{
-  float tmpCoords[3] = {0.0f, 0.0f, 0.0f};
-  grid->getPlaneCoords(x, y, z, tmpCoords);
-  coords[0] = tmpCoords[0];
-  coords[1] = tmpCoords[1];
-  coords[2] = tmpCoords[2];
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -346,297 +740,90 @@ void QuickSurfaceMesh::execute()
   int64_t yP = dims[1];
   int64_t zP = dims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  int64_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<int64_t> m_NodeIds(possibleNumNodes, -1);
-
-  int64_t nodeCount = 0;
-  int64_t triangleCount = 0;
-
-  int64_t point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Split the volume into slabs of whole z layers. Each slab only needs a dense node table covering its
+  // own layers, so keep the slabs thin enough that this table stays small, and numerous enough to spread
+  // across the available threads
+  int64_t planeNodes = (xP + 1) * (yP + 1);
+  int64_t slabLayers = (zP + k_TargetSlabCount - 1) / k_TargetSlabCount;
+  int64_t maxSlabLayers = k_MaxSlabNodes / planeNodes - 1;
+  if(slabLayers > maxSlabLayers)
+  {
+    slabLayers = maxSlabLayers;
+  }
+  if(slabLayers < 1)
+  {
+    slabLayers = 1;
+  }
 
-  int64_t nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+  std::vector<QuickSurfaceMeshSlab_t> slabs((zP + slabLayers - 1) / slabLayers);
+  for(size_t s = 0; s < slabs.size(); s++)
+  {
+    slabs[s].zStart = static_cast<int64_t>(s) * slabLayers;
+    slabs[s].zEnd = std::min(slabs[s].zStart + slabLayers, zP);
+    slabs[s].triangleOffset = 0;
+  }
 
   // first determining which nodes are actually boundary nodes and
   // count number of nodes and triangles that will be created
-  for(int64_t k = 0; k < zP; k++)
+  QuickSurfaceMeshCountImpl countImpl(m_FeatureIds, dims, slabs.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    for(int64_t j = 0; j < yP; j++)
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slabs.size()), countImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    countImpl.generate(0, slabs.size());
+  }
+
+  if(getCancel() == true)
+  {
+    return;
+  }
+
+  // Stitch the slabs together in order. A node on a slab's bottom plane that the previous slab already
+  // created takes that slab's number and hands over its owners; every other node is numbered in the order
+  // the slabs encountered it, which reproduces the numbering of a single pass over the whole volume
+  int64_t nodeCount = 0;
+  int64_t triangleCount = 0;
+  for(size_t s = 0; s < slabs.size(); s++)
+  {
+    QuickSurfaceMeshSlab_t& slab = slabs[s];
+    slab.triangleOffset = triangleCount;
+    triangleCount += static_cast<int64_t>(slab.faceNodes.size() / 2);
+
+    slab.finalIds.resize(slab.nodes.size());
+    slab.shared.assign(slab.nodes.size(), 0);
+    int64_t bottomPlaneEnd = (slab.zStart + 1) * planeNodes;
+    for(size_t n = 0; n < slab.nodes.size(); n++)
     {
-      for(int64_t i = 0; i < xP; i++)
+      if(s > 0 && slab.nodes[n] < bottomPlaneEnd)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
+        QuickSurfaceMeshSlab_t& prevSlab = slabs[s - 1];
+        std::unordered_map<int64_t, int32_t>::const_iterator iter = prevSlab.topNodes.find(slab.nodes[n]);
+        if(iter != prevSlab.topNodes.end())
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          slab.finalIds[n] = prevSlab.finalIds[iter->second];
+          slab.shared[n] = 1;
+          prevSlab.owners[iter->second].merge(slab.owners[n]);
+          continue;
         }
       }
+      slab.finalIds[n] = nodeCount;
+      nodeCount++;
+    }
+    if(s > 0)
+    {
+      std::unordered_map<int64_t, int32_t>().swap(slabs[s - 1].topNodes);
     }
   }
 
-  // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triangleCount);
   triangleGeom->resizeVertexList(nodeCount);
@@ -652,495 +839,31 @@ void QuickSurfaceMesh::execute()
   updateVertexInstancePointers();
   updateFaceInstancePointers();
 
-  ownerLists.resize(nodeCount);
+  // The Cell pair of each triangle is only needed when Cell arrays are transferred
+  std::vector<int64_t> faceCells;
+  if(m_SelectedWeakPtrVector.size() > 0)
+  {
+    faceCells.resize(triangleCount * 2);
+  }
 
   // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  int64_t triangleIndex = 0;
-  for(int64_t k = 0; k < zP; k++)
+  QuickSurfaceMeshGenerateImpl generateImpl(grid.get(), m_FeatureIds, dims, slabs.data(), vertex, m_NodeTypes, triangle, m_FaceLabels, faceCells.empty() ? nullptr : faceCells.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    for(int64_t j = 0; j < yP; j++)
-    {
-      for(int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slabs.size()), generateImpl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    generateImpl.generate(0, slabs.size());
   }
 
-  for(int64_t i = 0; i < nodeCount; i++)
+  slabs.clear();
+
+  for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
   {
-    m_NodeTypes[i] = ownerLists[i].size();
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
+    EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), faceCells, m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock())
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
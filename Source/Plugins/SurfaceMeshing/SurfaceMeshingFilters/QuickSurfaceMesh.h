@@ -180,16 +180,6 @@ class QuickSurfaceMesh : public AbstractFilter
     std::vector<IDataArray::WeakPointer> m_SelectedWeakPtrVector;
     std::vector<IDataArray::WeakPointer> m_CreatedWeakPtrVector;
 
-    /**
-     * @brief getGridCoordinates
-     * @param grid
-     * @param x
-     * @param y
-     * @param z
-     * @param coords
-     */
-    void getGridCoordinates(IGeometryGrid::Pointer grid, size_t x, size_t y, size_t z, float* coords);
-
     /**
      * @brief updateFaceInstancePointers Updates raw Face pointers
      */
@@ -0,0 +1,143 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "UnitSphereBinGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/Common/Constants.h"
+
+namespace
+{
+// Covers float round off in the vectors and in the exact angle test done by callers
+const float k_AngleTolerance = 0.01f;
+const int32_t k_MaxDim = 128;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+UnitSphereBinGrid::UnitSphereBinGrid()
+: m_Dim(1)
+, m_SearchChord(2.0f)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+UnitSphereBinGrid::~UnitSphereBinGrid()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void UnitSphereBinGrid::initialize(const std::vector<float>& vectors, float maxAngle)
+{
+  size_t numVectors = vectors.size() / 3;
+
+  // Two unit vectors an angle a apart are a chord of 2 * sin(a / 2) apart
+  float angle = maxAngle + k_AngleTolerance;
+  m_SearchChord = (angle < SIMPLib::Constants::k_Pi) ? 2.0f * sinf(0.5f * angle) + k_AngleTolerance : 2.0f;
+  m_Dim = static_cast<int32_t>(2.0f / m_SearchChord);
+  m_Dim = std::max(1, std::min(m_Dim, k_MaxDim));
+
+  size_t numCells = static_cast<size_t>(m_Dim) * m_Dim * m_Dim;
+  std::vector<int32_t> cellIds(numVectors, 0);
+  m_CellOffsets.assign(numCells + 1, 0);
+  for(size_t i = 0; i < numVectors; i++)
+  {
+    int32_t cell = (getCellCoord(vectors[3 * i + 2]) * m_Dim + getCellCoord(vectors[3 * i + 1])) * m_Dim + getCellCoord(vectors[3 * i]);
+    cellIds[i] = cell;
+    m_CellOffsets[cell + 1]++;
+  }
+  for(size_t c = 0; c < numCells; c++)
+  {
+    m_CellOffsets[c + 1] += m_CellOffsets[c];
+  }
+
+  // Counting sort keeps the vectors of each cell in increasing index order
+  std::vector<size_t> fill(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+  m_VectorIds.resize(numVectors);
+  for(size_t i = 0; i < numVectors; i++)
+  {
+    m_VectorIds[fill[cellIds[i]]] = i;
+    fill[cellIds[i]]++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void UnitSphereBinGrid::findCandidates(const float direction[3], std::vector<size_t>& candidates) const
+{
+  int32_t lo[3] = {0, 0, 0};
+  int32_t hi[3] = {0, 0, 0};
+  for(int32_t d = 0; d < 3; d++)
+  {
+    lo[d] = getCellCoord(direction[d] - m_SearchChord);
+    hi[d] = getCellCoord(direction[d] + m_SearchChord);
+  }
+  for(int32_t z = lo[2]; z <= hi[2]; z++)
+  {
+    for(int32_t y = lo[1]; y <= hi[1]; y++)
+    {
+      for(int32_t x = lo[0]; x <= hi[0]; x++)
+      {
+        size_t cell = (static_cast<size_t>(z) * m_Dim + y) * m_Dim + x;
+        candidates.insert(candidates.end(), m_VectorIds.begin() + m_CellOffsets[cell], m_VectorIds.begin() + m_CellOffsets[cell + 1]);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t UnitSphereBinGrid::getNumberOfVectors() const
+{
+  return m_VectorIds.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t UnitSphereBinGrid::getCellCoord(float value) const
+{
+  int32_t coord = static_cast<int32_t>(floorf((value + 1.0f) * 0.5f * m_Dim));
+  return std::max(0, std::min(coord, m_Dim - 1));
+}
@@ -0,0 +1,87 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _unitspherebingrid_h_
+#define _unitspherebingrid_h_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The UnitSphereBinGrid class bins a set of unit vectors into a regular grid of cells that covers
+ * the cube [-1, 1]^3. The cells are at least as wide as the chord of the search angle, so every vector within
+ * that angle of a query direction lies in the few cells around the direction. Queries return a superset of
+ * the vectors within the angle; callers still apply their own exact test to each returned vector.
+ */
+class UnitSphereBinGrid
+{
+  public:
+    UnitSphereBinGrid();
+    virtual ~UnitSphereBinGrid();
+
+    /**
+     * @brief initialize Bins the vectors
+     * @param vectors The vectors stored as consecutive (x, y, z) triplets
+     * @param maxAngle The largest angle in radians that will be searched around a direction
+     */
+    void initialize(const std::vector<float>& vectors, float maxAngle);
+
+    /**
+     * @brief findCandidates Appends the indices of all vectors that may be within the search angle of a direction.
+     * Indices within a single call are not sorted and the same index is never appended twice by one call.
+     * @param direction The unit direction to search around
+     * @param candidates The vector the indices are appended to
+     */
+    void findCandidates(const float direction[3], std::vector<size_t>& candidates) const;
+
+    /**
+     * @brief getNumberOfVectors Returns the number of binned vectors
+     */
+    size_t getNumberOfVectors() const;
+
+  private:
+    int32_t m_Dim;
+    float m_SearchChord;
+    std::vector<size_t> m_CellOffsets;
+    std::vector<size_t> m_VectorIds;
+
+    int32_t getCellCoord(float value) const;
+
+    UnitSphereBinGrid(const UnitSphereBinGrid&); // Copy Constructor Not Implemented
+    void operator=(const UnitSphereBinGrid&); // Operator '=' Not Implemented
+};
+
+#endif /* _unitspherebingrid_h_ */
@@ -0,0 +1,321 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class LaplacianSmoothingTest
+{
+public:
+  LaplacianSmoothingTest()
+  {
+  }
+  virtual ~LaplacianSmoothingTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(LaplacianSmoothingTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the LaplacianSmoothing Filter from the FilterManager
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The LaplacianSmoothingTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Meshes a small Voronoi volume with QuickSurfaceMesh, so the mesh has surface, triple line and quad
+  // point nodes
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createSurfaceMesh()
+  {
+    const size_t dims[3] = {14, 12, 10};
+    const size_t numSeeds = 7;
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    std::mt19937 generator(2468);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> seeds(3 * numSeeds);
+    for(size_t s = 0; s < numSeeds; s++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        seeds[3 * s + d] = distribution(generator) * dims[d];
+      }
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    image->setResolution(0.5f, 0.75f, 1.0f);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::AttributeMatrixType::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          float best = std::numeric_limits<float>::max();
+          int32_t feature = 0;
+          for(size_t s = 0; s < numSeeds; s++)
+          {
+            float dx = x + 0.5f - seeds[3 * s];
+            float dy = y + 0.5f - seeds[3 * s + 1];
+            float dz = z + 0.5f - seeds[3 * s + 2];
+            float dist = dx * dx + dy * dy + dz * dz;
+            if(dist < best)
+            {
+              best = dist;
+              feature = static_cast<int32_t>(s + 1);
+            }
+          }
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, feature);
+        }
+      }
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("QuickSurfaceMesh");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial edge loop LaplacianSmoothing used before the deltas were gathered over a CSR neighbor list
+  // -----------------------------------------------------------------------------
+  void edgeLoopSmoothing(std::vector<float>& verts, const int64_t* uedges, int64_t nedges, const std::vector<float>& lambda, int32_t iterationSteps, bool useTaubinSmoothing,
+                         float muFactor)
+  {
+    int64_t nvert = static_cast<int64_t>(lambda.size());
+    std::vector<double> delta(3 * nvert, 0.0);
+    std::vector<int32_t> ncon(nvert, 0);
+    int32_t numPasses = useTaubinSmoothing ? 2 : 1;
+    for(int32_t q = 0; q < iterationSteps; q++)
+    {
+      for(int32_t pass = 0; pass < numPasses; pass++)
+      {
+        double dlta = 0.0;
+        for(int64_t i = 0; i < nedges; i++)
+        {
+          int64_t in1 = uedges[2 * i];
+          int64_t in2 = uedges[2 * i + 1];
+          for(int32_t j = 0; j < 3; j++)
+          {
+            dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
+            delta[3 * in1 + j] += dlta;
+            delta[3 * in2 + j] += -1.0 * dlta;
+          }
+          ncon[in1] += 1;
+          ncon[in2] += 1;
+        }
+
+        float ll = 0.0f;
+        for(int64_t i = 0; i < nvert; i++)
+        {
+          for(int32_t j = 0; j < 3; j++)
+          {
+            int64_t in0 = 3 * i + j;
+            dlta = delta[in0] / ncon[i];
+            ll = (pass == 0) ? lambda[i] : lambda[i] * muFactor;
+            verts[3 * i + j] += ll * dlta;
+            delta[in0] = 0.0;
+          }
+          ncon[i] = 0;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Smooths the mesh with the filter and with the edge loop, and requires the same vertex positions bit for bit
+  // -----------------------------------------------------------------------------
+  void checkSmoothing(int32_t iterationSteps, bool useTaubinSmoothing)
+  {
+    DataContainerArray::Pointer dca = createSurfaceMesh();
+    DataContainer::Pointer sm = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    DREAM3D_REQUIRE_VALID_POINTER(sm.get())
+    TriangleGeom::Pointer triangles = sm->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(triangles.get())
+    // The filter keeps an existing edge list, so both smoothings walk the same edges
+    DREAM3D_REQUIRED(triangles->findEdges(), >=, 0);
+
+    int64_t nvert = triangles->getNumberOfVertices();
+    float* verts = triangles->getVertexPointer(0);
+    std::vector<float> original(verts, verts + 3 * nvert);
+    std::vector<float> expected(original);
+
+    // A different lambda for each node type, so every kind of node moves
+    const float lambdas[6] = {0.2f, 0.15f, 0.1f, 0.05f, 0.12f, 0.08f};
+    Int8ArrayType::Pointer nodeTypes = sm->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    DREAM3D_REQUIRE_VALID_POINTER(nodeTypes.get())
+    std::vector<float> lambda(nvert, 0.0f);
+    for(int64_t i = 0; i < nvert; i++)
+    {
+      switch(nodeTypes->getValue(i))
+      {
+      case SIMPL::SurfaceMesh::NodeType::Default:
+        lambda[i] = lambdas[0];
+        break;
+      case SIMPL::SurfaceMesh::NodeType::TriplePoint:
+        lambda[i] = lambdas[1];
+        break;
+      case SIMPL::SurfaceMesh::NodeType::QuadPoint:
+        lambda[i] = lambdas[2];
+        break;
+      case SIMPL::SurfaceMesh::NodeType::SurfaceDefault:
+        lambda[i] = lambdas[3];
+        break;
+      case SIMPL::SurfaceMesh::NodeType::SurfaceTriplePoint:
+        lambda[i] = lambdas[4];
+        break;
+      case SIMPL::SurfaceMesh::NodeType::SurfaceQuadPoint:
+        lambda[i] = lambdas[5];
+        break;
+      default:
+        break;
+      }
+    }
+
+    IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("LaplacianSmoothing");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(iterationSteps);
+    DREAM3D_REQUIRE(filter->setProperty("IterationSteps", var) == true)
+    var.setValue(lambdas[0]);
+    DREAM3D_REQUIRE(filter->setProperty("Lambda", var) == true)
+    var.setValue(lambdas[1]);
+    DREAM3D_REQUIRE(filter->setProperty("TripleLineLambda", var) == true)
+    var.setValue(lambdas[2]);
+    DREAM3D_REQUIRE(filter->setProperty("QuadPointLambda", var) == true)
+    var.setValue(lambdas[3]);
+    DREAM3D_REQUIRE(filter->setProperty("SurfacePointLambda", var) == true)
+    var.setValue(lambdas[4]);
+    DREAM3D_REQUIRE(filter->setProperty("SurfaceTripleLineLambda", var) == true)
+    var.setValue(lambdas[5]);
+    DREAM3D_REQUIRE(filter->setProperty("SurfaceQuadPointLambda", var) == true)
+    var.setValue(useTaubinSmoothing);
+    DREAM3D_REQUIRE(filter->setProperty("UseTaubinSmoothing", var) == true)
+    float muFactor = -1.03f;
+    var.setValue(muFactor);
+    DREAM3D_REQUIRE(filter->setProperty("MuFactor", var) == true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    edgeLoopSmoothing(expected, triangles->getEdgePointer(0), triangles->getNumberOfEdges(), lambda, iterationSteps, useTaubinSmoothing, muFactor);
+
+    verts = triangles->getVertexPointer(0);
+    bool moved = false;
+    for(int64_t i = 0; i < 3 * nvert; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(verts[i], expected[i])
+      if(verts[i] != original[i])
+      {
+        moved = true;
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(moved, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSmoothing()
+  {
+    checkSmoothing(1, false);
+    checkSmoothing(5, false);
+    checkSmoothing(4, true);
+    return EXIT_SUCCESS;
+  }
+
+  /**
+* @brief
+*/
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSmoothing())
+  }
+
+private:
+  LaplacianSmoothingTest(const LaplacianSmoothingTest&); // Copy Constructor Not Implemented
+  void operator=(const LaplacianSmoothingTest&);         // Operator '=' Not Implemented
+};
@@ -35,9 +35,12 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
 #include <fstream>
+#include <unordered_map>
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
@@ -227,6 +230,241 @@ public:
 private:
 };
 
+/**
+ * @brief The PackingMove_t struct holds one speculative move of a Feature for the parallel packing mode
+ */
+typedef struct
+{
+  size_t feature;
+  float centroid[3];
+  int64_t shift[3];
+  int64_t bounds[6];
+  int64_t fillingChange;
+} PackingMove_t;
+
+namespace
+{
+const int32_t k_PackingBatchSize = 64;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool packingRangesOverlap(int64_t aMin, int64_t aMax, int64_t bMin, int64_t bMax, int64_t dim, bool periodic)
+{
+  if(periodic == false)
+  {
+    return (aMin <= bMax && bMin <= aMax);
+  }
+  if(aMax - aMin + 1 >= dim || bMax - bMin + 1 >= dim)
+  {
+    return true;
+  }
+  for(int64_t k = -2; k <= 2; k++)
+  {
+    if(aMin <= bMax + k * dim && bMin + k * dim <= aMax)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool packingBoundsOverlap(const int64_t a[6], const int64_t b[6], const int64_t packingPoints[3], bool periodic)
+{
+  for(size_t i = 0; i < 3; i++)
+  {
+    if(packingRangesOverlap(a[2 * i], a[2 * i + 1], b[2 * i], b[2 * i + 1], packingPoints[i], periodic) == false)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+/**
+ * @brief The EvaluatePackingMovesImpl class computes, without modifying the packing grid, the change in the
+ * number of unassigned or multiple assigned packing points that each move in a batch would cause, along with
+ * the packing region the move touches
+ */
+class EvaluatePackingMovesImpl
+{
+  const std::vector<std::vector<int64_t> >& m_ColumnList;
+  const std::vector<std::vector<int64_t> >& m_RowList;
+  const std::vector<std::vector<int64_t> >& m_PlaneList;
+  const int32_t* m_FeatureOwners;
+  int64_t m_PackingPoints[3];
+  bool m_PeriodicBoundaries;
+  PackingMove_t* m_Moves;
+
+public:
+  EvaluatePackingMovesImpl(const std::vector<std::vector<int64_t> >& columnList, const std::vector<std::vector<int64_t> >& rowList, const std::vector<std::vector<int64_t> >& planeList,
+                           const int32_t* featureOwners, const int64_t packingPoints[3], bool periodicBoundaries, PackingMove_t* moves)
+  : m_ColumnList(columnList)
+  , m_RowList(rowList)
+  , m_PlaneList(planeList)
+  , m_FeatureOwners(featureOwners)
+  , m_PeriodicBoundaries(periodicBoundaries)
+  , m_Moves(moves)
+  {
+    m_PackingPoints[0] = packingPoints[0];
+    m_PackingPoints[1] = packingPoints[1];
+    m_PackingPoints[2] = packingPoints[2];
+  }
+
+  virtual ~EvaluatePackingMovesImpl()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  bool packingIndex(int64_t col, int64_t row, int64_t plane, int64_t& featureOwnersIdx) const
+  {
+    if(m_PeriodicBoundaries == true)
+    {
+      if(col < 0)
+      {
+        col = col + m_PackingPoints[0];
+      }
+      if(col > m_PackingPoints[0] - 1)
+      {
+        col = col - m_PackingPoints[0];
+      }
+      if(row < 0)
+      {
+        row = row + m_PackingPoints[1];
+      }
+      if(row > m_PackingPoints[1] - 1)
+      {
+        row = row - m_PackingPoints[1];
+      }
+      if(plane < 0)
+      {
+        plane = plane + m_PackingPoints[2];
+      }
+      if(plane > m_PackingPoints[2] - 1)
+      {
+        plane = plane - m_PackingPoints[2];
+      }
+    }
+    else if(col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1] || plane < 0 || plane >= m_PackingPoints[2])
+    {
+      return false;
+    }
+    featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void evaluate(PackingMove_t& move) const
+  {
+    const std::vector<int64_t>& cl = m_ColumnList[move.feature];
+    const std::vector<int64_t>& rl = m_RowList[move.feature];
+    const std::vector<int64_t>& pl = m_PlaneList[move.feature];
+    size_t size = cl.size();
+
+    int64_t oldBounds[6] = {0, -1, 0, -1, 0, -1};
+    int64_t newBounds[6] = {0, -1, 0, -1, 0, -1};
+    if(size > 0)
+    {
+      oldBounds[0] = oldBounds[1] = cl[0];
+      oldBounds[2] = oldBounds[3] = rl[0];
+      oldBounds[4] = oldBounds[5] = pl[0];
+    }
+    for(size_t i = 1; i < size; i++)
+    {
+      oldBounds[0] = std::min(oldBounds[0], cl[i]);
+      oldBounds[1] = std::max(oldBounds[1], cl[i]);
+      oldBounds[2] = std::min(oldBounds[2], rl[i]);
+      oldBounds[3] = std::max(oldBounds[3], rl[i]);
+      oldBounds[4] = std::min(oldBounds[4], pl[i]);
+      oldBounds[5] = std::max(oldBounds[5], pl[i]);
+    }
+    for(size_t i = 0; i < 3; i++)
+    {
+      newBounds[2 * i] = oldBounds[2 * i] + move.shift[i];
+      newBounds[2 * i + 1] = oldBounds[2 * i + 1] + move.shift[i];
+      move.bounds[2 * i] = std::min(oldBounds[2 * i], newBounds[2 * i]);
+      move.bounds[2 * i + 1] = std::max(oldBounds[2 * i + 1], newBounds[2 * i + 1]);
+    }
+
+    // The removal and the insertion only see each other's changes where the old and new footprints can share
+    // packing points (or where a wrapped footprint covers a point twice), which is the only case where the
+    // owners have to be tracked point by point
+    bool trackOwners = packingBoundsOverlap(oldBounds, newBounds, m_PackingPoints, m_PeriodicBoundaries);
+    for(size_t i = 0; i < 3; i++)
+    {
+      if(m_PeriodicBoundaries == true && oldBounds[2 * i + 1] - oldBounds[2 * i] + 1 > m_PackingPoints[i])
+      {
+        trackOwners = true;
+      }
+    }
+    std::unordered_map<int64_t, int32_t> ownerChanges;
+
+    // Same filling error terms as check_fillingerror: removing a Feature from a point with currentFeatureOwner
+    // owners changes the error by (-2 * currentFeatureOwner + 3) and adding one changes it by (2 * currentFeatureOwner - 1)
+    int64_t change = 0;
+    int64_t featureOwnersIdx = 0;
+    for(size_t i = 0; i < size; i++)
+    {
+      if(packingIndex(cl[i], rl[i], pl[i], featureOwnersIdx) == false)
+      {
+        continue;
+      }
+      int64_t currentFeatureOwner = m_FeatureOwners[featureOwnersIdx];
+      if(trackOwners == true)
+      {
+        int32_t& ownerChange = ownerChanges[featureOwnersIdx];
+        currentFeatureOwner += ownerChange;
+        ownerChange--;
+      }
+      change += -2 * currentFeatureOwner + 3;
+    }
+    for(size_t i = 0; i < size; i++)
+    {
+      if(packingIndex(cl[i] + move.shift[0], rl[i] + move.shift[1], pl[i] + move.shift[2], featureOwnersIdx) == false)
+      {
+        continue;
+      }
+      int64_t currentFeatureOwner = m_FeatureOwners[featureOwnersIdx];
+      if(trackOwners == true)
+      {
+        int32_t& ownerChange = ownerChanges[featureOwnersIdx];
+        currentFeatureOwner += ownerChange;
+        ownerChange++;
+      }
+      change += 2 * currentFeatureOwner - 1;
+    }
+    move.fillingChange = change;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      evaluate(m_Moves[i]);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+};
+
 // Include the MOC generated file for this class
 #include "moc_PackPrimaryPhases.cpp"
 
@@ -252,6 +490,7 @@ PackPrimaryPhases::PackPrimaryPhases()
 , m_FeatureInputFile("")
 , m_CsvOutputFile("")
 , m_PeriodicBoundaries(false)
+, m_ParallelPacking(false)
 , m_WriteGoalAttributes(false)
 , m_NeighborhoodsArrayName(SIMPL::FeatureData::Neighborhoods)
 , m_CentroidsArrayName(SIMPL::FeatureData::Centroids)
@@ -342,6 +581,17 @@ void PackPrimaryPhases::initialize()
   m_PrimaryPhases.clear();
   m_PrimaryPhaseFractions.clear();
 
+  m_OneOverNeighborGridRes = 1.0f;
+  m_NeighborGridDims[0] = m_NeighborGridDims[1] = m_NeighborGridDims[2] = 1;
+  m_NeighborGridCells.clear();
+  m_NeighborGridCell.clear();
+  m_NeighborGridSlot.clear();
+
+  m_NeighborPhaseIndex.clear();
+  m_NeighborDiaBin.clear();
+  m_NeighborHistogram.clear();
+  m_NeighborDiaBinCounts.clear();
+
   m_AvailablePointsCount = 1;
   m_FillingError = m_OldFillingError = 0.0f;
   m_CurrentNeighborhoodError = m_OldNeighborhoodError = 0.0f;
@@ -355,6 +605,7 @@ void PackPrimaryPhases::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Parameter, PackPrimaryPhases));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Evaluate Packing Moves in Parallel", ParallelPacking, FilterParameter::Parameter, PackPrimaryPhases));
   QStringList linkedProps("MaskArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Parameter, PackPrimaryPhases, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -448,6 +699,7 @@ void PackPrimaryPhases::readFilterParameters(AbstractFilterParametersReader* rea
   setFeaturePhasesArrayName(reader->readString("FeaturePhasesArrayName", getFeaturePhasesArrayName()));
   setNumFeaturesArrayName(reader->readString("NumFeaturesArrayName", getNumFeaturesArrayName()));
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", false));
+  setParallelPacking(reader->readValue("ParallelPacking", getParallelPacking()));
   setWriteGoalAttributes(reader->readValue("WriteGoalAttributes", false));
   setUseMask(reader->readValue("UseMask", getUseMask()));
   setHaveFeatures(reader->readValue("HaveFeatures", getHaveFeatures()));
@@ -1099,9 +1351,11 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrimaryFeatures::exclusions_owners");
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // This is the set that we are going to keep updated with the points that are not in an exclusion zone. availablePoints
+  // holds the slot of each packing point (-1 if the point is not available) and the first m_AvailablePointsCount slots of
+  // availablePointsInv hold the available points, so a point is added or removed by swapping it with the last slot
+  std::vector<int64_t> availablePoints(m_TotalPackingPoints, -1);
+  std::vector<int64_t> availablePointsInv(m_TotalPackingPoints, 0);
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1411,6 +1665,9 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
 
+  // bin the placed Features so each neighborhood update only visits the surrounding grid cells
+  initialize_neighborgrid(totalFeatures);
+
   // determine neighborhoods and initial neighbor distribution errors
   for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
   {
@@ -1434,6 +1691,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
 
   // determine initial set of available points
   m_AvailablePointsCount = 0;
+  std::fill(availablePoints.begin(), availablePoints.end(), -1);
   for(int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
@@ -1448,6 +1706,11 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  // keeps the scheduler alive across the batches of the parallel packing mode
+  tbb::task_scheduler_init init;
+#endif
+
   millis = QDateTime::currentMSecsSinceEpoch();
   startMillis = millis;
   bool good = false;
@@ -1482,6 +1745,15 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
       outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
     }
 
+    // PARALLEL - this option evaluates a batch of jumps and nudges at once and keeps the non-conflicting improvements
+    if(m_ParallelPacking == true)
+    {
+      int32_t batchSize = std::min(k_PackingBatchSize, totalAdjustments - iteration);
+      acceptedmoves += swap_features_parallel(iteration, batchSize, featureOwnersPtr, exclusionOwnersPtr, availablePoints, availablePointsInv);
+      iteration += batchSize - 1;
+      continue;
+    }
+
     // JUMP - this option moves one feature to a random spot in the volume
     if(option == 0)
     {
@@ -1513,7 +1785,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
       }
       m_Seed++;
 
-      if(availablePoints.size() > 0)
+      if(m_AvailablePointsCount > 0)
       {
         key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
         featureOwnersIdx = availablePointsInv[key];
@@ -1541,7 +1813,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
       if(m_FillingError <= m_OldFillingError)
       {
         m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        update_availablepoints(availablePoints, availablePointsInv);
+        update_availablepoints(availablePoints, availablePointsInv, exclusionOwners);
         acceptedmoves++;
       }
       else if(m_FillingError > m_OldFillingError)
@@ -1624,7 +1896,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
       if(m_FillingError <= m_OldFillingError)
       {
         m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        update_availablepoints(availablePoints, availablePointsInv);
+        update_availablepoints(availablePoints, availablePointsInv, exclusionOwners);
         acceptedmoves++;
       }
       //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
@@ -1652,6 +1924,145 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t PackPrimaryPhases::swap_features_parallel(int32_t firstIteration, int32_t batchSize, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr,
+                                                  std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv)
+{
+  // Every batch draws its moves from its own seed, so the packing does not depend on the number of threads
+  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed + static_cast<uint64_t>(firstIteration));
+
+  int32_t* featureOwners = featureOwnersPtr->getPointer(0);
+  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
+  size_t totalFeatures = m_ColumnList.size();
+
+  int64_t column = 0, row = 0, plane = 0;
+  int64_t featureOwnersIdx = 0;
+  float xc = 0.0f, yc = 0.0f, zc = 0.0f;
+  float oldxc = 0.0f, oldyc = 0.0f, oldzc = 0.0f;
+  std::vector<PackingMove_t> moves(batchSize);
+  for(int32_t b = 0; b < batchSize; b++)
+  {
+    size_t randomfeature = m_FirstPrimaryFeature + size_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
+    bool good = false;
+    size_t count = 0;
+    while(good == false && count < (totalFeatures - m_FirstPrimaryFeature))
+    {
+      xc = m_Centroids[3 * randomfeature];
+      yc = m_Centroids[3 * randomfeature + 1];
+      zc = m_Centroids[3 * randomfeature + 2];
+      column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+      row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+      plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+      featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+      if(featureOwners[featureOwnersIdx] > 1)
+      {
+        good = true;
+      }
+      else
+      {
+        randomfeature++;
+      }
+      if(randomfeature >= totalFeatures)
+      {
+        randomfeature = m_FirstPrimaryFeature;
+      }
+      count++;
+    }
+    oldxc = m_Centroids[3 * randomfeature];
+    oldyc = m_Centroids[3 * randomfeature + 1];
+    oldzc = m_Centroids[3 * randomfeature + 2];
+
+    if((firstIteration + b) % 2 == 0)
+    {
+      // JUMP to a random available point
+      if(m_AvailablePointsCount > 0)
+      {
+        size_t key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
+        featureOwnersIdx = availablePointsInv[key];
+      }
+      else
+      {
+        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
+      }
+      column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
+      row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
+      plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
+      xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
+      yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
+      zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
+    }
+    else
+    {
+      // NUDGE to a spot close to the current centroid
+      float xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
+      float yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
+      float zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
+      xc = ((oldxc + xshift) < m_SizeX && (oldxc + xshift) > 0) ? oldxc + xshift : oldxc;
+      yc = ((oldyc + yshift) < m_SizeY && (oldyc + yshift) > 0) ? oldyc + yshift : oldyc;
+      zc = ((oldzc + zshift) < m_SizeZ && (oldzc + zshift) > 0) ? oldzc + zshift : oldzc;
+    }
+
+    PackingMove_t& move = moves[b];
+    move.feature = randomfeature;
+    move.centroid[0] = xc;
+    move.centroid[1] = yc;
+    move.centroid[2] = zc;
+    move.shift[0] = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]) - static_cast<int64_t>((oldxc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+    move.shift[1] = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]) - static_cast<int64_t>((oldyc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+    move.shift[2] = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]) - static_cast<int64_t>((oldzc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+    move.fillingChange = 0;
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+
+  EvaluatePackingMovesImpl impl(m_ColumnList, m_RowList, m_PlaneList, featureOwners, m_PackingPoints, m_PeriodicBoundaries, moves.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, moves.size()), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.generate(0, moves.size());
+  }
+
+  // Every move was evaluated against the same packing grid, so a move is only committed if it does not increase the
+  // filling error and touches none of the packing points changed by a move committed earlier in the batch
+  int32_t acceptedMoves = 0;
+  std::vector<size_t> committed;
+  for(size_t b = 0; b < moves.size(); b++)
+  {
+    PackingMove_t& move = moves[b];
+    if(move.fillingChange > 0)
+    {
+      continue;
+    }
+    bool conflict = false;
+    for(size_t c = 0; c < committed.size() && conflict == false; c++)
+    {
+      conflict = packingBoundsOverlap(moves[committed[c]].bounds, move.bounds, m_PackingPoints, m_PeriodicBoundaries);
+    }
+    if(conflict == true)
+    {
+      continue;
+    }
+    int32_t gnum = static_cast<int32_t>(move.feature);
+    m_FillingError = check_fillingerror(-1000, gnum, featureOwnersPtr, exclusionOwnersPtr);
+    move_feature(move.feature, move.centroid[0], move.centroid[1], move.centroid[2]);
+    m_FillingError = check_fillingerror(gnum, -1000, featureOwnersPtr, exclusionOwnersPtr);
+    m_OldNeighborhoodError = check_neighborhooderror(-1000, gnum);
+    update_availablepoints(availablePoints, availablePointsInv, exclusionOwners);
+    committed.push_back(b);
+    acceptedMoves++;
+  }
+  return acceptedMoves;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1862,15 +2273,195 @@ void PackPrimaryPhases::move_feature(size_t gnum, float xc, float yc, float zc)
     int64_t& pl = m_PlaneList[gnum][i];
     pl += shiftplane;
   }
+  if(m_NeighborGridCells.empty() == false)
+  {
+    update_neighborgrid(gnum);
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
+void PackPrimaryPhases::initialize_neighborgrid(size_t totalFeatures)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
+
+  // Two Features can only count each other as neighbors if their centroids are closer than the larger of their
+  // equivalent diameters along every axis, so with cells at least that wide all candidates are in the adjacent cells.
+  // The cells are never made smaller than the volume per Feature to keep the grid from outgrowing the Feature count
+  float maxDia = 0.0f;
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    if(m_EquivalentDiameters[i] > maxDia)
+    {
+      maxDia = m_EquivalentDiameters[i];
+    }
+  }
+  float gridRes = maxDia * 1.01f;
+  float minGridRes = powf(m_TotalVol / static_cast<float>(totalFeatures), 1.0f / 3.0f);
+  if(gridRes < minGridRes)
+  {
+    gridRes = minGridRes;
+  }
+  if(gridRes <= 0.0f)
+  {
+    gridRes = 1.0f;
+  }
+  m_OneOverNeighborGridRes = 1.0f / gridRes;
+  float sizes[3] = {m_SizeX, m_SizeY, m_SizeZ};
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_NeighborGridDims[i] = static_cast<int64_t>(sizes[i] * m_OneOverNeighborGridRes);
+    if(m_NeighborGridDims[i] < 1)
+    {
+      m_NeighborGridDims[i] = 1;
+    }
+  }
+
+  m_NeighborGridCells.clear();
+  m_NeighborGridCells.resize(m_NeighborGridDims[0] * m_NeighborGridDims[1] * m_NeighborGridDims[2]);
+  m_NeighborGridCell.assign(totalFeatures, -1);
+  m_NeighborGridSlot.assign(totalFeatures, 0);
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    int64_t column = neighborgrid_coordinate(m_Centroids[3 * i], 0);
+    int64_t row = neighborgrid_coordinate(m_Centroids[3 * i + 1], 1);
+    int64_t plane = neighborgrid_coordinate(m_Centroids[3 * i + 2], 2);
+    int64_t cell = (m_NeighborGridDims[0] * m_NeighborGridDims[1] * plane) + (m_NeighborGridDims[0] * row) + column;
+    m_NeighborGridCell[i] = cell;
+    m_NeighborGridSlot[i] = m_NeighborGridCells[cell].size();
+    m_NeighborGridCells[cell].push_back(i);
+  }
 
+  // The size bin of each Feature never changes while packing, so the neighbor distribution of each phase is kept as
+  // integer counts per (size bin, neighborhood bin) that are updated whenever a neighborhood count changes
+  size_t numPhases = m_SimNeighborDist.size();
+  m_NeighborPhaseIndex.assign(totalFeatures, -1);
+  m_NeighborDiaBin.assign(totalFeatures, 0);
+  m_NeighborHistogram.resize(numPhases);
+  m_NeighborDiaBinCounts.resize(numPhases);
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    m_NeighborHistogram[iter].assign(m_SimNeighborDist[iter].size(), std::vector<int32_t>(40, 0));
+    m_NeighborDiaBinCounts[iter].assign(m_SimNeighborDist[iter].size(), 0);
+  }
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    for(size_t iter = 0; iter < numPhases; ++iter)
+    {
+      if(m_FeaturePhases[i] != m_PrimaryPhases[iter] || m_NeighborHistogram[iter].empty() == true)
+      {
+        continue;
+      }
+      PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[m_PrimaryPhases[iter]].get());
+      float maxFeatureDia = pp->getMaxFeatureDiameter();
+      float minFeatureDia = pp->getMinFeatureDiameter();
+      float oneOverBinStepSize = 1.0f / pp->getBinStepSize();
+      float dia = m_EquivalentDiameters[i];
+      if(dia > maxFeatureDia)
+      {
+        dia = maxFeatureDia;
+      }
+      if(dia < minFeatureDia)
+      {
+        dia = minFeatureDia;
+      }
+      size_t diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
+      if(diabin >= m_NeighborHistogram[iter].size())
+      {
+        diabin = m_NeighborHistogram[iter].size() - 1;
+      }
+      m_NeighborPhaseIndex[i] = static_cast<int32_t>(iter);
+      m_NeighborDiaBin[i] = diabin;
+      m_NeighborHistogram[iter][diabin][neighborhood_bin(iter, m_Neighborhoods[i])]++;
+      m_NeighborDiaBinCounts[iter][diabin]++;
+      break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PackPrimaryPhases::neighborgrid_coordinate(float value, size_t axis)
+{
+  int64_t coord = static_cast<int64_t>(floorf(value * m_OneOverNeighborGridRes));
+  if(coord < 0)
+  {
+    coord = 0;
+  }
+  if(coord > m_NeighborGridDims[axis] - 1)
+  {
+    coord = m_NeighborGridDims[axis] - 1;
+  }
+  return coord;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::update_neighborgrid(size_t gnum)
+{
+  int64_t column = neighborgrid_coordinate(m_Centroids[3 * gnum], 0);
+  int64_t row = neighborgrid_coordinate(m_Centroids[3 * gnum + 1], 1);
+  int64_t plane = neighborgrid_coordinate(m_Centroids[3 * gnum + 2], 2);
+  int64_t cell = (m_NeighborGridDims[0] * m_NeighborGridDims[1] * plane) + (m_NeighborGridDims[0] * row) + column;
+  int64_t oldCell = m_NeighborGridCell[gnum];
+  if(cell == oldCell)
+  {
+    return;
+  }
+  std::vector<size_t>& oldFeatures = m_NeighborGridCells[oldCell];
+  size_t slot = m_NeighborGridSlot[gnum];
+  size_t last = oldFeatures.back();
+  oldFeatures[slot] = last;
+  m_NeighborGridSlot[last] = slot;
+  oldFeatures.pop_back();
+  m_NeighborGridCell[gnum] = cell;
+  m_NeighborGridSlot[gnum] = m_NeighborGridCells[cell].size();
+  m_NeighborGridCells[cell].push_back(gnum);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PackPrimaryPhases::neighborhood_bin(size_t phaseIndex, int32_t nnum)
+{
+  float oneOverNeighborDistStep = 1.0f / m_NeighborDistStep[phaseIndex];
+  size_t nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
+  if(nnumbin >= 40)
+  {
+    nnumbin = 39;
+  }
+  return nnumbin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::adjust_neighborhood(size_t gnum, int32_t delta)
+{
+  if(delta == 0)
+  {
+    return;
+  }
+  int32_t phaseIndex = m_NeighborPhaseIndex[gnum];
+  if(phaseIndex < 0)
+  {
+    m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + delta;
+    return;
+  }
+  std::vector<int32_t>& histogram = m_NeighborHistogram[phaseIndex][m_NeighborDiaBin[gnum]];
+  histogram[neighborhood_bin(phaseIndex, m_Neighborhoods[gnum])]--;
+  m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + delta;
+  histogram[neighborhood_bin(phaseIndex, m_Neighborhoods[gnum])]++;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
+{
   float x = 0.0f, y = 0.0f, z = 0.0f;
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float dia = 0.0f, dia2 = 0.0f;
@@ -1879,7 +2470,6 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
   dia = m_EquivalentDiameters[gnum];
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
   int32_t increment = 0;
   if(add == true)
   {
@@ -1889,24 +2479,61 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
   {
     increment = -1;
   }
-  for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
+  // the Feature counts itself through both tests, so its own changes are summed and applied once at the end
+  int32_t gnumIncrement = 0;
+  int64_t column = neighborgrid_coordinate(x, 0);
+  int64_t row = neighborgrid_coordinate(y, 1);
+  int64_t plane = neighborgrid_coordinate(z, 2);
+  for(int64_t k = plane - 1; k <= plane + 1; k++)
   {
-    xn = m_Centroids[3 * n];
-    yn = m_Centroids[3 * n + 1];
-    zn = m_Centroids[3 * n + 2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
-    if(dx < dia && dy < dia && dz < dia)
+    if(k < 0 || k >= m_NeighborGridDims[2])
     {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+      continue;
     }
-    if(dx < dia2 && dy < dia2 && dz < dia2)
+    for(int64_t j = row - 1; j <= row + 1; j++)
     {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      if(j < 0 || j >= m_NeighborGridDims[1])
+      {
+        continue;
+      }
+      for(int64_t i = column - 1; i <= column + 1; i++)
+      {
+        if(i < 0 || i >= m_NeighborGridDims[0])
+        {
+          continue;
+        }
+        std::vector<size_t>& cellFeatures = m_NeighborGridCells[(m_NeighborGridDims[0] * m_NeighborGridDims[1] * k) + (m_NeighborGridDims[0] * j) + i];
+        size_t numCellFeatures = cellFeatures.size();
+        for(size_t l = 0; l < numCellFeatures; l++)
+        {
+          size_t n = cellFeatures[l];
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          dia2 = m_EquivalentDiameters[n];
+          dx = fabs(x - xn);
+          dy = fabs(y - yn);
+          dz = fabs(z - zn);
+          if(dx < dia && dy < dia && dz < dia)
+          {
+            gnumIncrement = gnumIncrement + increment;
+          }
+          if(dx < dia2 && dy < dia2 && dz < dia2)
+          {
+            if(n == gnum)
+            {
+              gnumIncrement = gnumIncrement + increment;
+            }
+            else
+            {
+              adjust_neighborhood(n, increment);
+            }
+          }
+        }
+      }
     }
   }
+  adjust_neighborhood(gnum, gnumIncrement);
 }
 
 // -----------------------------------------------------------------------------
@@ -1915,17 +2542,10 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
 float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
 {
   // Optimized Code
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-
-  StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
-
   float neighborerror = 0.0f;
   float bhattdist = 0.0f;
-  float dia = 0.0f;
-  int32_t nnum = 0;
   size_t diabin = 0;
   size_t nnumbin = 0;
-  int32_t index = 0;
   int32_t phase = 0;
 
   typedef std::vector<std::vector<float>> VectOfVectFloat_t;
@@ -1933,20 +2553,9 @@ float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
   for(size_t iter = 0; iter < numPhases; ++iter)
   {
     phase = m_PrimaryPhases[iter];
-    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
     VectOfVectFloat_t& curSimNeighborDist = m_SimNeighborDist[iter];
     size_t curSImNeighborDist_Size = curSimNeighborDist.size();
-    float oneOverNeighborDistStep = 1.0f / m_NeighborDistStep[iter];
 
-    std::vector<int32_t> count(curSImNeighborDist_Size, 0);
-    for(size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      curSimNeighborDist[i].resize(40);
-      for(size_t j = 0; j < 40; j++)
-      {
-        curSimNeighborDist[i][j] = 0;
-      }
-    }
     if(gadd > 0 && m_FeaturePhases[gadd] == phase)
     {
       determine_neighbors(gadd, true);
@@ -1956,63 +2565,27 @@ float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
       determine_neighbors(gremove, false);
     }
 
-    float maxFeatureDia = pp->getMaxFeatureDiameter();
-    float minFeatureDia = pp->getMinFeatureDiameter();
-    float oneOverBinStepSize = 1.0f / pp->getBinStepSize();
-
-    size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
-    for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+    // the histogram already holds every Feature of this phase, so only the removed and added Features need adjusting
+    std::vector<int32_t> count = m_NeighborDiaBinCounts[iter];
+    for(size_t i = 0; i < curSImNeighborDist_Size; i++)
     {
-      nnum = 0;
-      index = static_cast<int32_t>(i);
-      if(index != gremove && m_FeaturePhases[index] == phase)
+      curSimNeighborDist[i].resize(40);
+      for(size_t j = 0; j < 40; j++)
       {
-        dia = m_EquivalentDiameters[index];
-        if(dia > maxFeatureDia)
-        {
-          dia = maxFeatureDia;
-        }
-        if(dia < minFeatureDia)
-        {
-          dia = minFeatureDia;
-        }
-        diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
-        if(diabin >= curSImNeighborDist_Size)
-        {
-          diabin = curSImNeighborDist_Size - 1;
-        }
-        nnum = m_Neighborhoods[index];
-        nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
-        if(nnumbin >= 40)
-        {
-          nnumbin = 39;
-        }
-        curSimNeighborDist[diabin][nnumbin]++;
-        count[diabin]++;
+        curSimNeighborDist[i][j] = static_cast<float>(m_NeighborHistogram[iter][i][j]);
       }
     }
+    if(gremove > 0 && m_FeaturePhases[gremove] == phase)
+    {
+      diabin = m_NeighborDiaBin[gremove];
+      nnumbin = neighborhood_bin(iter, m_Neighborhoods[gremove]);
+      curSimNeighborDist[diabin][nnumbin]--;
+      count[diabin]--;
+    }
     if(gadd > 0 && m_FeaturePhases[gadd] == phase)
     {
-      dia = m_EquivalentDiameters[gadd];
-      if(dia > maxFeatureDia)
-      {
-        dia = maxFeatureDia;
-      }
-      if(dia < minFeatureDia)
-      {
-        dia = minFeatureDia;
-      }
-      diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
-      if(diabin >= curSImNeighborDist_Size)
-      {
-        diabin = curSImNeighborDist_Size - 1;
-      }
-      nnum = m_Neighborhoods[gadd];
-      nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
-      if(nnumbin >= 40)
-      {
-        nnumbin = 39;
-      }
+      diabin = m_NeighborDiaBin[gadd];
+      nnumbin = neighborhood_bin(iter, m_Neighborhoods[gadd]);
       curSimNeighborDist[diabin][nnumbin]++;
       count[diabin]++;
     }
@@ -2380,32 +2953,35 @@ float PackPrimaryPhases::check_fillingerror(int32_t gadd, int32_t gremove, Int32
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void PackPrimaryPhases::update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv, int32_t* exclusionOwners)
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  // A move can free a point while removing the Feature and claim it again while adding it back, so the point
+  // then shows up in both lists; the final state is read back from the exclusion owners instead
+  std::vector<size_t>* pointLists[2] = {&m_PointsToAdd, &m_PointsToRemove};
+  for(size_t l = 0; l < 2; l++)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    std::vector<size_t>& points = *(pointLists[l]);
+    size_t numPoints = points.size();
+    for(size_t i = 0; i < numPoints; i++)
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      size_t featureOwnersIdx = points[i];
+      bool available = (exclusionOwners[featureOwnersIdx] == 0 && (m_UseMask == false || m_Mask[featureOwnersIdx] == true));
+      int64_t key = availablePoints[featureOwnersIdx];
+      if(available == true && key < 0)
+      {
+        availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
+        availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
+        m_AvailablePointsCount++;
+      }
+      else if(available == false && key >= 0)
+      {
+        int64_t val = availablePointsInv[m_AvailablePointsCount - 1];
+        availablePointsInv[key] = val;
+        availablePoints[val] = key;
+        availablePoints[featureOwnersIdx] = -1;
+        m_AvailablePointsCount--;
+      }
     }
-    m_AvailablePointsCount--;
-  }
-  for(size_t i = 0; i < addSize; i++)
-  {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
   }
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
@@ -120,6 +120,9 @@ class PackPrimaryPhases : public AbstractFilter
     SIMPL_FILTER_PARAMETER(bool, PeriodicBoundaries)
     Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+    SIMPL_FILTER_PARAMETER(bool, ParallelPacking)
+    Q_PROPERTY(bool ParallelPacking READ getParallelPacking WRITE setParallelPacking)
+
     SIMPL_FILTER_PARAMETER(bool, WriteGoalAttributes)
     Q_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
 
@@ -314,11 +317,62 @@ class PackPrimaryPhases : public AbstractFilter
     float check_fillingerror(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
     /**
-     * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-     * @param availablePoints Map between Feature owners and number of available points
-     * @param availablePointsInv Inverse associations for the availablePoints map
+     * @brief update_availablepoints Updates the dense index-swap arrays used to associate packing points with an "available" state
+     * @param availablePoints Slot of each packing point within availablePointsInv, or -1 if the point is not available
+     * @param availablePointsInv Packing point held by each slot; the first m_AvailablePointsCount slots are in use
+     * @param exclusionOwners Array of exlusion Ids for each packing point
+     */
+    void update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv, int32_t* exclusionOwners);
+
+    /**
+     * @brief swap_features_parallel Proposes a batch of Feature jumps and nudges, evaluates their filling error
+     * changes in parallel and commits the improving moves that do not overlap each other
+     * @param firstIteration Swap loop iteration of the first move in the batch, also used to seed the batch
+     * @param batchSize Number of moves in the batch
+     * @param featureOwnersPtr Array of Feature Ids for each packing point
+     * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+     * @param availablePoints Slot of each packing point within availablePointsInv, or -1 if the point is not available
+     * @param availablePointsInv Packing point held by each slot
+     * @return Number of committed moves
+     */
+    int32_t swap_features_parallel(int32_t firstIteration, int32_t batchSize, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr,
+                                   std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv);
+
+    /**
+     * @brief initialize_neighborgrid Bins the Feature centroids into a uniform grid whose cells are at least one
+     * maximum equivalent diameter wide and builds the per phase neighborhood histograms from the current neighborhoods
+     * @param totalFeatures Number of Features being packed
+     */
+    void initialize_neighborgrid(size_t totalFeatures);
+
+    /**
+     * @brief neighborgrid_coordinate Returns the neighbor grid cell coordinate along an axis, clamped to the grid
+     * @param value Centroid coordinate along the axis
+     * @param axis Axis index
+     * @return Cell coordinate
      */
-    void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+    int64_t neighborgrid_coordinate(float value, size_t axis);
+
+    /**
+     * @brief update_neighborgrid Moves a Feature into the neighbor grid cell that holds its current centroid
+     * @param gnum Id for the Feature that was moved
+     */
+    void update_neighborgrid(size_t gnum);
+
+    /**
+     * @brief neighborhood_bin Returns the neighbor distribution bin for a neighborhood count
+     * @param phaseIndex Index of the primary phase
+     * @param nnum Neighborhood count
+     * @return Bin index
+     */
+    size_t neighborhood_bin(size_t phaseIndex, int32_t nnum);
+
+    /**
+     * @brief adjust_neighborhood Changes the neighborhood count of a Feature and keeps the neighborhood histogram in sync
+     * @param gnum Id for the Feature
+     * @param delta Change in the neighborhood count
+     */
+    void adjust_neighborhood(size_t gnum, int32_t delta);
 
     /**
      * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -461,6 +515,17 @@ class PackPrimaryPhases : public AbstractFilter
     std::vector<int32_t> m_PrimaryPhases;
     std::vector<float> m_PrimaryPhaseFractions;
 
+    float m_OneOverNeighborGridRes;
+    int64_t m_NeighborGridDims[3];
+    std::vector<std::vector<size_t> > m_NeighborGridCells;
+    std::vector<int64_t> m_NeighborGridCell;
+    std::vector<size_t> m_NeighborGridSlot;
+
+    std::vector<int32_t> m_NeighborPhaseIndex;
+    std::vector<size_t> m_NeighborDiaBin;
+    std::vector<std::vector<std::vector<int32_t> > > m_NeighborHistogram;
+    std::vector<std::vector<int32_t> > m_NeighborDiaBinCounts;
+
     size_t m_AvailablePointsCount;
     float m_FillingError, m_OldFillingError;
     float m_CurrentNeighborhoodError, m_OldNeighborhoodError;